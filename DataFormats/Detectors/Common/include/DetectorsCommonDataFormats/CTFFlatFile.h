@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CTFFlatFile.h
+/// \brief Flat (non-ROOT) CTF file with detectors EncodedBlocks images which can be memory-mapped
+
+#ifndef ALICEO2_CTF_FLATFILE_H
+#define ALICEO2_CTF_FLATFILE_H
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+/// header occupying the 1st Alignment bytes of the flat CTF file
+struct CTFFlatFileHeader {
+  static constexpr uint64_t Magic = 0x54414c4646544332; // "2CTFFLAT"
+  static constexpr uint32_t Version = 1;
+
+  uint64_t magic = Magic;
+  uint32_t version = Version;
+  uint32_t alignment = 0;   // alignment of the detectors images in the file
+  uint64_t run = 0;         // CTFHeader data
+  uint32_t firstTForbit = 0;
+  uint32_t detectors = 0;
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offsets{}; // offset of the detector image in the file
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> sizes{};   // size in bytes of the detector image, 0 if absent
+};
+
+/// The flat CTF file stores the flat EncodedBlocks images of the detectors (as they are sent by the DPL) at the offsets
+/// aligned to the page size, so that each image can be memory-mapped and passed to DPL w/o deserialization or copy
+class CTFFlatFile
+{
+  using DetID = o2::detectors::DetID;
+
+ public:
+  static constexpr size_t Alignment = 4096;
+
+  CTFFlatFile() = default;
+  ~CTFFlatFile();
+  CTFFlatFile(const CTFFlatFile&) = delete;
+  CTFFlatFile& operator=(const CTFFlatFile&) = delete;
+
+  ///< create new file for writing, the header is written at closing
+  void create(const std::string& fileName, const CTFHeader& h);
+  ///< append flat image of the detector EncodedBlocks to created file
+  void addDetector(DetID det, const void* data, size_t size);
+
+  ///< open existing file for reading
+  void open(const std::string& fileName);
+  void close();
+
+  const CTFHeader& getCTFHeader() const { return mCTFHeader; }
+  const std::string& getFileName() const { return mFileName; }
+  bool hasDetector(DetID det) const { return mHeader.sizes[det] > 0; }
+  size_t getDetectorSize(DetID det) const { return mHeader.sizes[det]; }
+
+  ///< map detector image to memory, must be released by unmap(ptr, getDetectorSize(det))
+  char* mapDetector(DetID det) const;
+  ///< release mapped detector image, signature is compatible with the FairMQ message free function
+  static void unmap(void* data, void* size);
+
+  ///< read detector image to vector (which will be resized as needed)
+  template <typename VD>
+  void readDetector(DetID det, VD& vec) const
+  {
+    vec.resize((getDetectorSize(det) + sizeof(typename VD::value_type) - 1) / sizeof(typename VD::value_type));
+    readDetector(det, vec.data());
+  }
+  ///< read detector image to provided pointer, which must have getDetectorSize(det) bytes available
+  void readDetector(DetID det, void* dest) const;
+
+  ///< check if the file is flat CTF file
+  static bool isFlatFile(const std::string& fileName);
+
+ private:
+  int mFD = -1;
+  bool mWriteMode = false;
+  uint64_t mOffset = 0; // next free offset in write mode
+  std::string mFileName;
+  CTFFlatFileHeader mHeader;
+  CTFHeader mCTFHeader{};
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
@@ -79,6 +79,9 @@ struct ANSHeader {
   ClassDefNV(ANSHeader, 1);
 };
 
+constexpr ANSHeader ANSVersionCompat{0, 1};      // 2 interleaved rANS states
+constexpr ANSHeader ANSVersionInterleaved{1, 0}; // 8 interleaved rANS states, see o2::rans::InterleavedLiteralEncoder
+
 struct Metadata {
   enum class OptStore : uint8_t { // describe how the store the data described by this metadata
     EENCODE,                      // entropy encoding applied
@@ -330,6 +333,8 @@ class EncodedBlocks
   void setANSHeader(const ANSHeader& h) { mANSHeader = h; }
   const ANSHeader& getANSHeader() const { return mANSHeader; }
   ANSHeader& getANSHeader() { return mANSHeader; }
+  /// true if the data is coded with 8 interleaved rANS states, false for the legacy 2 states
+  bool isInterleavedANS() const;
 
   static constexpr int getNBlocks() { return N; }
 
@@ -402,6 +407,10 @@ class EncodedBlocks
   template <typename S_IT, typename VB>
   void encode(const S_IT srcBegin, const S_IT srcEnd, int slot, uint8_t probabilityBits, Metadata::OptStore opt, VB* buffer = nullptr, const void* encoderExt = nullptr);
 
+  /// copy block and metadata from the slot srcSlot of another container to the provided slot, e.g. to assemble the blocks encoded concurrently
+  template <typename VB>
+  void copyBlock(const EncodedBlocks& src, int srcSlot, int slot, VB* buffer = nullptr);
+
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
   void decode(container_T& dest, int slot, const void* decoderExt = nullptr) const;
@@ -694,6 +703,23 @@ inline void EncodedBlocks<H, N, W>::decode(container_T& dest,            // dest
   decode(std::begin(dest), slot, decoderExt);
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+bool EncodedBlocks<H, N, W>::isInterleavedANS() const
+{
+  // CTFs written before the ANS header was filled carry version 0.0, they use the legacy coder as well
+  if (mANSHeader.majorVersion == ANSVersionCompat.majorVersion) {
+    return false;
+  }
+  if (mANSHeader.majorVersion == ANSVersionInterleaved.majorVersion) {
+    return true;
+  }
+  LOG(ERROR) << "Unsupported ANS version " << int(mANSHeader.majorVersion) << "." << int(mANSHeader.minorVersion)
+             << ", the supported ones are " << int(ANSVersionCompat.majorVersion) << "." << int(ANSVersionCompat.minorVersion)
+             << " and " << int(ANSVersionInterleaved.majorVersion) << "." << int(ANSVersionInterleaved.minorVersion);
+  throw std::runtime_error("Unsupported ANS version");
+}
+
 ///_____________________________________________________________________________
 template <typename H, int N, typename W>
 template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool>>
@@ -714,12 +740,13 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         LOG(ERROR) << "Dictionaty is not saved for slot " << slot << " and no external decoder is provided";
         throw std::runtime_error("Dictionary is not saved and no external decoder provided");
       }
-      const o2::rans::LiteralDecoder64<dest_t>* decoder = reinterpret_cast<const o2::rans::LiteralDecoder64<dest_t>*>(decoderExt);
-      std::unique_ptr<o2::rans::LiteralDecoder64<dest_t>> decoderLoc;
+      // external decoders are created as InterleavedLiteralDecoder64, which can decode also the legacy format
+      const o2::rans::InterleavedLiteralDecoder64<dest_t>* decoder = reinterpret_cast<const o2::rans::InterleavedLiteralDecoder64<dest_t>*>(decoderExt);
+      std::unique_ptr<o2::rans::InterleavedLiteralDecoder64<dest_t>> decoderLoc;
       if (block.getNDict()) { // if dictionaty is saved, prefer it
         o2::rans::FrequencyTable frequencies;
         frequencies.addFrequencies(block.getDict(), block.getDict() + block.getNDict(), md.min, md.max);
-        decoderLoc = std::make_unique<o2::rans::LiteralDecoder64<dest_t>>(frequencies, md.probabilityBits);
+        decoderLoc = std::make_unique<o2::rans::InterleavedLiteralDecoder64<dest_t>>(frequencies, md.probabilityBits);
         decoder = decoderLoc.get();
       } else { // verify that decoded corresponds to stored metadata
         if (md.min != decoder->getMinSymbol() || md.max != decoder->getMaxSymbol()) {
@@ -736,7 +763,11 @@ void EncodedBlocks<H, N, W>::decode(D_IT dest,                    // iterator to
         // to D-word array
         literals = std::vector<dest_t>{reinterpret_cast<const dest_t*>(block.getLiterals()), reinterpret_cast<const dest_t*>(block.getLiterals()) + md.nLiterals};
       }
-      decoder->process(dest, block.getData() + block.getNData(), md.messageLength, literals);
+      if (isInterleavedANS()) {
+        decoder->process(dest, block.getData() + block.getNData(), md.messageLength, literals);
+      } else { // legacy format with 2 interleaved states
+        static_cast<const o2::rans::LiteralDecoder64<dest_t>*>(decoder)->process(dest, block.getData() + block.getNData(), md.messageLength, literals);
+      }
     } else { // data was stored as is
       using destPtr_t = typename std::iterator_traits<D_IT>::pointer;
       destPtr_t srcBegin = reinterpret_cast<destPtr_t>(block.payload);
@@ -802,14 +833,15 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
     // build symbol statistics
     constexpr size_t SizeEstMarginAbs = 10 * 1024;
     constexpr float SizeEstMarginRel = 1.05;
-    const o2::rans::LiteralEncoder64<STYP>* encoder = reinterpret_cast<const o2::rans::LiteralEncoder64<STYP>*>(encoderExt);
-    std::unique_ptr<o2::rans::LiteralEncoder64<STYP>> encoderLoc;
+    const bool interleaved = isInterleavedANS(); // "this" might be invalid after expandStorage
+    const o2::rans::InterleavedLiteralEncoder64<STYP>* encoder = reinterpret_cast<const o2::rans::InterleavedLiteralEncoder64<STYP>*>(encoderExt);
+    std::unique_ptr<o2::rans::InterleavedLiteralEncoder64<STYP>> encoderLoc;
     std::unique_ptr<o2::rans::FrequencyTable> frequencies = nullptr;
     int dictSize = 0;
     if (!encoder) { // no external encoder provide, create one on spot
       frequencies = std::make_unique<o2::rans::FrequencyTable>();
       frequencies->addSamples(srcBegin, srcEnd);
-      encoderLoc = std::make_unique<o2::rans::LiteralEncoder64<STYP>>(*frequencies, probabilityBits);
+      encoderLoc = std::make_unique<o2::rans::InterleavedLiteralEncoder64<STYP>>(*frequencies, probabilityBits);
       encoder = encoderLoc.get();
       dictSize = frequencies->size();
     }
@@ -828,7 +860,8 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
     // directly encode source message into block buffer.
     auto blIn = bl->getCreateData();
     auto frSize = bl->registry->getFreeSize(); // note: "this" might be not valid after expandStorage call!!!
-    const auto encodedMessageEnd = encoder->process(blIn, blIn + frSize, srcBegin, srcEnd, literals);
+    const auto encodedMessageEnd = interleaved ? encoder->process(blIn, blIn + frSize, srcBegin, srcEnd, literals)
+                                               : static_cast<const o2::rans::LiteralEncoder64<STYP>*>(encoder)->process(blIn, blIn + frSize, srcBegin, srcEnd, literals);
     dataSize = encodedMessageEnd - bl->getData();
     bl->setNData(dataSize);
     bl->realignBlock();
@@ -858,6 +891,29 @@ void EncodedBlocks<H, N, W>::encode(const S_IT srcBegin,     // iterator begin o
   // resize block if necessary
 }
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename VB>
+void EncodedBlocks<H, N, W>::copyBlock(const EncodedBlocks& src, // container to copy from
+                                       int srcSlot,              // slot of the block in the source container
+                                       int slot,                 // slot in this container to fill
+                                       VB* buffer)               // optional buffer (vector) providing memory for encoded blocks
+{
+  assert(slot == mRegistry.nFilledBlocks);
+  mRegistry.nFilledBlocks++;
+  const auto& srcBl = src.mBlocks[srcSlot];
+  auto* eeb = this;
+  auto szNeed = estimateBlockSize(srcBl.getNStored()); // size in bytes!!!
+  if (szNeed >= getFreeSize()) {
+    if (!buffer) {
+      throw std::runtime_error("no room for copied block in provided container");
+    }
+    eeb = expand(*buffer, size() + (szNeed - getFreeSize())); // "this" becomes invalid
+  }
+  eeb->mMetadata[slot] = src.mMetadata[srcSlot];
+  eeb->mBlocks[slot].store(srcBl.getNDict(), srcBl.getNData(), srcBl.getNLiterals(), srcBl.getDict(), srcBl.getNData() ? srcBl.getData() : nullptr, srcBl.getLiterals());
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<o2::rans::FrequencyTable>& vfreq, const std::vector<Metadata>& vmd)
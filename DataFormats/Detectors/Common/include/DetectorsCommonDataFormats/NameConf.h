@@ -100,7 +100,10 @@ class NameConf : public o2::conf::ConfigurableParamHelper<NameConf>
   static constexpr std::string_view CTFTREENAME = "ctf"; // hardcoded
 
   // CTF Filename
-  static std::string getCTFFileName(uint32_t run, uint32_t orb, uint32_t id, const std::string_view prefix = "o2_ctf");
+  static std::string getCTFFileName(uint32_t run, uint32_t orb, uint32_t id, const std::string_view prefix = "o2_ctf", const std::string_view ext = ROOT_EXT_STRING);
+
+  // extension of the flat (memory-mappable) CTF files
+  static constexpr std::string_view CTFFLAT_EXT_STRING = "ctf";
 
   // CTF Dictionary
   static std::string getCTFDictFileName();
@@ -0,0 +1,226 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+#include "CommonUtils/StringUtils.h"
+#include <Framework/Logger.h>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+static_assert(sizeof(CTFFlatFileHeader) <= CTFFlatFile::Alignment, "CTF flat file header exceeds the alignment");
+
+namespace
+{
+void throwError(const std::string& msg, const std::string& fileName)
+{
+  auto err = o2::utils::Str::concat_string(msg, " ", fileName, ": ", std::strerror(errno));
+  LOG(ERROR) << err;
+  throw std::runtime_error(err);
+}
+
+// write the whole buffer at given offset
+void writeAt(int fd, const void* data, size_t size, uint64_t offset, const std::string& fileName)
+{
+  auto ptr = reinterpret_cast<const char*>(data);
+  while (size) {
+    auto nw = ::pwrite(fd, ptr, size, offset);
+    if (nw < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwError("failed to write", fileName);
+    }
+    ptr += nw;
+    offset += nw;
+    size -= nw;
+  }
+}
+
+// read the whole buffer from given offset
+bool readAt(int fd, void* data, size_t size, uint64_t offset)
+{
+  auto ptr = reinterpret_cast<char*>(data);
+  while (size) {
+    auto nr = ::pread(fd, ptr, size, offset);
+    if (nr < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nr <= 0) {
+      return false;
+    }
+    ptr += nr;
+    offset += nr;
+    size -= nr;
+  }
+  return true;
+}
+} // namespace
+
+///________________________________________________________________
+CTFFlatFile::~CTFFlatFile()
+{
+  try {
+    close();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "failed to close CTF flat file " << mFileName << ": " << e.what();
+  }
+}
+
+///________________________________________________________________
+void CTFFlatFile::create(const std::string& fileName, const CTFHeader& h)
+{
+  close();
+  mFileName = fileName;
+  mFD = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (mFD < 0) {
+    throwError("failed to create CTF flat file", fileName);
+  }
+  mWriteMode = true;
+  mCTFHeader = h;
+  mCTFHeader.detectors.reset();
+  mHeader = CTFFlatFileHeader{};
+  mHeader.alignment = Alignment;
+  mHeader.run = h.run;
+  mHeader.firstTForbit = h.firstTForbit;
+  mOffset = Alignment; // 1st aligned slot is reserved for the header
+}
+
+///________________________________________________________________
+void CTFFlatFile::addDetector(DetID det, const void* data, size_t size)
+{
+  if (!mWriteMode) {
+    throw std::runtime_error("CTF flat file is not opened for writing");
+  }
+  if (hasDetector(det)) {
+    throw std::runtime_error(o2::utils::Str::concat_string("CTF flat file ", mFileName, " has already data of ", det.getName()));
+  }
+  writeAt(mFD, data, size, mOffset, mFileName);
+  mHeader.offsets[det] = mOffset;
+  mHeader.sizes[det] = size;
+  mCTFHeader.detectors.set(det);
+  mOffset += size;
+  mOffset += (Alignment - mOffset % Alignment) % Alignment;
+}
+
+///________________________________________________________________
+void CTFFlatFile::open(const std::string& fileName)
+{
+  close();
+  mFileName = fileName;
+  mFD = ::open(fileName.c_str(), O_RDONLY);
+  if (mFD < 0) {
+    throwError("failed to open CTF flat file", fileName);
+  }
+  auto reject = [this](const std::string& err) {
+    ::close(mFD);
+    mFD = -1;
+    mHeader = CTFFlatFileHeader{};
+    LOG(ERROR) << err;
+    throw std::runtime_error(err);
+  };
+  if (!readAt(mFD, &mHeader, sizeof(mHeader), 0) || mHeader.magic != CTFFlatFileHeader::Magic) {
+    reject(o2::utils::Str::concat_string("file ", fileName, " is not a CTF flat file"));
+  }
+  if (mHeader.version != CTFFlatFileHeader::Version) {
+    reject(o2::utils::Str::concat_string("unsupported version ", std::to_string(mHeader.version), " of CTF flat file ", fileName));
+  }
+  // the images must be within the file, otherwise accessing their mapping would crash with SIGBUS
+  struct stat st;
+  if (::fstat(mFD, &st) != 0) {
+    throwError("failed to stat CTF flat file", fileName);
+  }
+  uint64_t fileSize = st.st_size;
+  if (mHeader.alignment != Alignment || (uint64_t(mHeader.detectors) >> DetID::nDetectors)) {
+    reject(o2::utils::Str::concat_string("corrupted header of CTF flat file ", fileName));
+  }
+  for (int id = 0; id < DetID::nDetectors; id++) {
+    auto offset = mHeader.offsets[id], size = mHeader.sizes[id];
+    if (bool((mHeader.detectors >> id) & 0x1) != (size > 0)) {
+      reject(o2::utils::Str::concat_string("corrupted header of CTF flat file ", fileName, ": inconsistent presence of ", DetID::getName(id)));
+    }
+    if (size && (offset < Alignment || offset % Alignment || offset > fileSize || size > fileSize - offset)) {
+      reject(o2::utils::Str::concat_string("truncated or corrupted CTF flat file ", fileName, ": ", DetID::getName(id), " data at offset ",
+                                           std::to_string(offset), " of size ", std::to_string(size), " exceeds the file size ", std::to_string(fileSize)));
+    }
+  }
+  mCTFHeader = CTFHeader{mHeader.run, mHeader.firstTForbit, DetID::mask_t(mHeader.detectors)};
+}
+
+///________________________________________________________________
+void CTFFlatFile::close()
+{
+  if (mFD < 0) {
+    return;
+  }
+  if (mWriteMode) { // finalize the header
+    mHeader.detectors = mCTFHeader.detectors.to_ulong();
+    writeAt(mFD, &mHeader, sizeof(mHeader), 0, mFileName);
+    if (::ftruncate(mFD, mOffset) != 0) { // make sure the padding after the last image exists
+      throwError("failed to pad", mFileName);
+    }
+  }
+  ::close(mFD);
+  mFD = -1;
+  mWriteMode = false;
+}
+
+///________________________________________________________________
+char* CTFFlatFile::mapDetector(DetID det) const
+{
+  if (mFD < 0 || mWriteMode || !hasDetector(det)) {
+    throw std::runtime_error(o2::utils::Str::concat_string("cannot map data of ", det.getName(), " from CTF flat file ", mFileName));
+  }
+  // the offset must be aligned to the page size, which may exceed the alignment used for writing
+  static const uint64_t pageSize = ::sysconf(_SC_PAGESIZE);
+  auto offset = mHeader.offsets[det], delta = offset % pageSize;
+  // private mapping: the pages are loaded on demand and the eventual modifications are not propagated to the file
+  void* ptr = ::mmap(nullptr, mHeader.sizes[det] + delta, PROT_READ | PROT_WRITE, MAP_PRIVATE, mFD, offset - delta);
+  if (ptr == MAP_FAILED) {
+    throwError(o2::utils::Str::concat_string("failed to map ", det.getName(), " data of"), mFileName);
+  }
+  return reinterpret_cast<char*>(ptr) + delta;
+}
+
+///________________________________________________________________
+void CTFFlatFile::unmap(void* data, void* size)
+{
+  static const uintptr_t pageSize = ::sysconf(_SC_PAGESIZE);
+  auto delta = reinterpret_cast<uintptr_t>(data) % pageSize;
+  ::munmap(reinterpret_cast<char*>(data) - delta, reinterpret_cast<size_t>(size) + delta);
+}
+
+///________________________________________________________________
+void CTFFlatFile::readDetector(DetID det, void* dest) const
+{
+  if (mFD < 0 || mWriteMode || !hasDetector(det) || !readAt(mFD, dest, mHeader.sizes[det], mHeader.offsets[det])) {
+    throw std::runtime_error(o2::utils::Str::concat_string("failed to read data of ", det.getName(), " from CTF flat file ", mFileName));
+  }
+}
+
+///________________________________________________________________
+bool CTFFlatFile::isFlatFile(const std::string& fileName)
+{
+  uint64_t magic = 0;
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  bool res = readAt(fd, &magic, sizeof(magic), 0) && magic == CTFFlatFileHeader::Magic;
+  ::close(fd);
+  return res;
+}
@@ -0,0 +1,182 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test CTFFlatFile
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+
+using namespace o2::ctf;
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+using Images = std::map<DetID::ID, std::vector<char>>;
+
+// write the images of a TF to a flat file
+void writeTF(const std::string& fileName, uint32_t firstTForbit, const Images& images)
+{
+  CTFFlatFile file;
+  file.create(fileName, CTFHeader{12345, firstTForbit, {}});
+  for (const auto& [id, image] : images) {
+    file.addDetector(DetID(id), image.data(), image.size());
+  }
+  file.close();
+}
+
+std::vector<char> readBytes(const std::string& fileName)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeBytes(const std::string& fileName, const std::vector<char>& bytes)
+{
+  std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), bytes.size());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CTFFlatFileRoundTrip)
+{
+  std::mt19937 gen(777);
+  std::uniform_int_distribution<int> byteDist(-128, 127);
+  // image sizes around the alignment, the last image is followed by the padding
+  const std::vector<std::pair<DetID::ID, size_t>> layout{{DetID::ITS, 1}, {DetID::TPC, 3 * CTFFlatFile::Alignment + 17},
+                                                         {DetID::TOF, CTFFlatFile::Alignment}, {DetID::ZDC, 100}};
+  for (int tf = 0; tf < 3; tf++) {
+    BOOST_TEST_CONTEXT("TF " << tf)
+    {
+      Images images;
+      for (size_t i = tf; i < layout.size(); i++) { // every TF has a different set of detectors
+        auto& image = images[layout[i].first];
+        image.resize(layout[i].second + tf);
+        for (auto& c : image) {
+          c = byteDist(gen);
+        }
+      }
+      const std::string fileName = "test_CTFFlatFile_" + std::to_string(tf) + ".ctf";
+      writeTF(fileName, 256 * tf, images);
+      BOOST_REQUIRE(CTFFlatFile::isFlatFile(fileName));
+
+      CTFFlatFile file;
+      file.open(fileName);
+      BOOST_CHECK_EQUAL(file.getCTFHeader().run, 12345u);
+      BOOST_CHECK_EQUAL(file.getCTFHeader().firstTForbit, 256u * tf);
+      for (DetID::ID id = DetID::First; id <= DetID::Last; id++) {
+        auto it = images.find(id);
+        BOOST_CHECK_EQUAL(file.hasDetector(DetID(id)), it != images.end());
+        BOOST_CHECK_EQUAL(bool(file.getCTFHeader().detectors[id]), it != images.end());
+        if (it == images.end()) {
+          BOOST_CHECK_THROW(file.mapDetector(DetID(id)), std::runtime_error);
+          continue;
+        }
+        const auto& image = it->second;
+        BOOST_REQUIRE_EQUAL(file.getDetectorSize(DetID(id)), image.size());
+
+        char* mapped = file.mapDetector(DetID(id));
+        BOOST_CHECK(std::memcmp(mapped, image.data(), image.size()) == 0);
+        CTFFlatFile::unmap(mapped, reinterpret_cast<void*>(image.size()));
+
+        std::vector<char> read;
+        file.readDetector(DetID(id), read);
+        BOOST_CHECK(read == image);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CTFFlatFileRejected)
+{
+  const std::string fileName = "test_CTFFlatFile_bad.ctf";
+  writeTF(fileName, 0, {{DetID::ITS, std::vector<char>(100, 1)}, {DetID::TPC, std::vector<char>(CTFFlatFile::Alignment + 1, 2)}});
+  const auto good = readBytes(fileName);
+  BOOST_REQUIRE_EQUAL(good.size(), 4 * CTFFlatFile::Alignment);
+  CTFFlatFile file;
+  BOOST_CHECK_NO_THROW(file.open(fileName));
+  file.close();
+
+  auto header = [&good]() {
+    CTFFlatFileHeader h;
+    std::memcpy(&h, good.data(), sizeof(h));
+    return h;
+  };
+  auto withHeader = [&good](const CTFFlatFileHeader& h) {
+    auto bytes = good;
+    std::memcpy(bytes.data(), &h, sizeof(h));
+    return bytes;
+  };
+
+  // truncated within the header, within the ITS image, within the TPC image, by the last byte of the TPC image
+  for (size_t size : {size_t(10), CTFFlatFile::Alignment + 50, 2 * CTFFlatFile::Alignment + 100, 3 * CTFFlatFile::Alignment}) {
+    BOOST_TEST_CONTEXT("truncated to " << size)
+    {
+      writeBytes(fileName, std::vector<char>(good.begin(), good.begin() + size));
+      BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+    }
+  }
+
+  auto h = header();
+  h.magic ^= 0x1;
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK(!CTFFlatFile::isFlatFile(fileName));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.version++;
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.alignment = 512;
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.offsets[DetID::ITS] += 8; // misaligned
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.offsets[DetID::TPC] = 0; // overlapping the header
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.sizes[DetID::TPC] = ~0ul; // huge size which would overflow offset + size
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.detectors &= ~(0x1u << DetID::ITS); // data present but not declared
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  h = header();
+  h.detectors |= 0x1u << DetID::TOF; // declared but no data
+  writeBytes(fileName, withHeader(h));
+  BOOST_CHECK_THROW(file.open(fileName), std::runtime_error);
+
+  // a rejected file does not leave the object in a usable state
+  BOOST_CHECK(!file.hasDetector(DetID::ITS));
+  BOOST_CHECK_THROW(file.mapDetector(DetID::ITS), std::runtime_error);
+
+  writeBytes(fileName, good);
+  BOOST_CHECK_NO_THROW(file.open(fileName));
+  BOOST_CHECK(file.hasDetector(DetID::TPC));
+}
@@ -65,10 +65,10 @@ class CTFCoderBase
 
     switch (op) {
       case OpType::Encoder:
-        mCoders[slot].reset(new o2::rans::LiteralEncoder64<S>(freq, probabilityBits));
+        mCoders[slot].reset(new o2::rans::InterleavedLiteralEncoder64<S>(freq, probabilityBits));
         break;
       case OpType::Decoder:
-        mCoders[slot].reset(new o2::rans::LiteralDecoder64<S>(freq, probabilityBits));
+        mCoders[slot].reset(new o2::rans::InterleavedLiteralDecoder64<S>(freq, probabilityBits));
         break;
     }
   }
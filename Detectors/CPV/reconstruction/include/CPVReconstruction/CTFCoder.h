@@ -79,8 +79,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const TriggerRecord>& trigData,
   using ECB = CTF::base;
 
   ec->setHeader(helper.createHeader());
-  ec->getANSHeader().majorVersion = 0;
-  ec->getANSHeader().minorVersion = 1;
+  ec->setANSHeader(o2::ctf::ANSVersionInterleaved);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
 #define ENCODECPV(beg, end, slot, bits) CTF::get(buff.data())->encode(beg, end, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
   // clang-format off
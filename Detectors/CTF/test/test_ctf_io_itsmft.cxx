@@ -21,19 +21,15 @@
 #include <TFile.h>
 #include <TRandom.h>
 #include <TStopwatch.h>
+#include <algorithm>
 #include <cstring>
 
 using namespace o2::itsmft;
 
-BOOST_AUTO_TEST_CASE(CompressedClustersTest)
+namespace
+{
+void generateClusters(std::vector<ROFRecord>& rofRecVec, std::vector<CompClusterExt>& cclusVec, std::vector<unsigned char>& pattVec)
 {
-
-  std::vector<ROFRecord> rofRecVec;
-  std::vector<CompClusterExt> cclusVec;
-  std::vector<unsigned char> pattVec;
-
-  TStopwatch sw;
-  sw.Start();
   std::vector<int> row, col;
   for (int irof = 0; irof < 100; irof++) {
     auto& rofr = rofRecVec.emplace_back();
@@ -64,6 +60,26 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
     }
     rofr.setNEntries(int(cclusVec.size()) - rofr.getFirstEntry());
   }
+}
+
+void decodeCTF(const std::vector<o2::ctf::BufferType>& vec, int nThreads, std::vector<ROFRecord>& rofRecVec, std::vector<CompClusterExt>& cclusVec, std::vector<unsigned char>& pattVec)
+{
+  CTFCoder coder(o2::detectors::DetID::ITS);
+  coder.setNThreads(nThreads);
+  coder.decode(o2::itsmft::CTF::getImage(vec.data()), rofRecVec, cclusVec, pattVec);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CompressedClustersTest)
+{
+
+  std::vector<ROFRecord> rofRecVec;
+  std::vector<CompClusterExt> cclusVec;
+  std::vector<unsigned char> pattVec;
+
+  TStopwatch sw;
+  sw.Start();
+  generateClusters(rofRecVec, cclusVec, pattVec);
   sw.Stop();
   LOG(INFO) << "Generated " << cclusVec.size() << " in " << rofRecVec.size() << " ROFs in " << sw.CpuTime() << " s";
 
@@ -139,3 +155,81 @@ BOOST_AUTO_TEST_CASE(CompressedClustersTest)
     BOOST_CHECK(pattVecD[i] == pattVec[i]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(CompressedClustersMTTest)
+{
+  std::vector<ROFRecord> rofRecVec;
+  std::vector<CompClusterExt> cclusVec;
+  std::vector<unsigned char> pattVec;
+  generateClusters(rofRecVec, cclusVec, pattVec);
+
+  std::vector<o2::ctf::BufferType> vecST, vecMT;
+  {
+    CTFCoder coder(o2::detectors::DetID::ITS);
+    coder.encode(vecST, rofRecVec, cclusVec, pattVec);
+  }
+  {
+    CTFCoder coder(o2::detectors::DetID::ITS);
+    coder.setNThreads(4);
+    BOOST_CHECK_EQUAL(coder.getNThreads(), 4);
+    coder.encode(vecMT, rofRecVec, cclusVec, pattVec);
+  }
+
+  // the blocks encoded concurrently must be identical to those of the single-threaded encoding
+  const auto& ctfST = *o2::itsmft::CTF::get(vecST.data());
+  const auto& ctfMT = *o2::itsmft::CTF::get(vecMT.data());
+  const auto &hST = ctfST.getHeader(), &hMT = ctfMT.getHeader();
+  BOOST_CHECK_EQUAL(hST.nROFs, hMT.nROFs);
+  BOOST_CHECK_EQUAL(hST.nClusters, hMT.nClusters);
+  BOOST_CHECK_EQUAL(hST.nChips, hMT.nChips);
+  BOOST_CHECK_EQUAL(hST.nPatternBytes, hMT.nPatternBytes);
+  BOOST_CHECK_EQUAL(hST.firstOrbit, hMT.firstOrbit);
+  BOOST_CHECK_EQUAL(hST.firstBC, hMT.firstBC);
+  for (int ib = 0; ib < o2::itsmft::CTF::getNBlocks(); ib++) {
+    BOOST_TEST_CONTEXT("block " << ib)
+    {
+      const auto &mdST = ctfST.getMetadata(ib), &mdMT = ctfMT.getMetadata(ib);
+      BOOST_CHECK_EQUAL(mdST.messageLength, mdMT.messageLength);
+      BOOST_CHECK_EQUAL(mdST.nLiterals, mdMT.nLiterals);
+      BOOST_CHECK_EQUAL(int(mdST.coderType), int(mdMT.coderType));
+      BOOST_CHECK_EQUAL(int(mdST.streamSize), int(mdMT.streamSize));
+      BOOST_CHECK_EQUAL(int(mdST.probabilityBits), int(mdMT.probabilityBits));
+      BOOST_CHECK(mdST.opt == mdMT.opt);
+      BOOST_CHECK_EQUAL(mdST.min, mdMT.min);
+      BOOST_CHECK_EQUAL(mdST.max, mdMT.max);
+      const auto &blST = ctfST.getBlock(ib), &blMT = ctfMT.getBlock(ib);
+      BOOST_CHECK_EQUAL(blST.getNDict(), blMT.getNDict());
+      BOOST_CHECK_EQUAL(blST.getNData(), blMT.getNData());
+      BOOST_CHECK_EQUAL(blST.getNLiterals(), blMT.getNLiterals());
+      BOOST_REQUIRE_EQUAL(blST.getNStored(), blMT.getNStored());
+      BOOST_CHECK(std::equal(blST.payload, blST.payload + blST.getNStored(), blMT.payload));
+    }
+  }
+
+  // every combination of the single- and multi-threaded encoding and decoding gives back the input
+  for (const auto* vec : {&vecST, &vecMT}) {
+    for (int nThreads : {1, 4}) {
+      BOOST_TEST_CONTEXT((vec == &vecST ? "single" : "multi") << "-threaded encoding, decoding with " << nThreads << " threads")
+      {
+        std::vector<ROFRecord> rofRecVecD;
+        std::vector<CompClusterExt> cclusVecD;
+        std::vector<unsigned char> pattVecD;
+        decodeCTF(*vec, nThreads, rofRecVecD, cclusVecD, pattVecD);
+        BOOST_REQUIRE_EQUAL(rofRecVecD.size(), rofRecVec.size());
+        for (size_t i = 0; i < rofRecVec.size(); i++) {
+          BOOST_CHECK(rofRecVecD[i].getBCData() == rofRecVec[i].getBCData());
+          BOOST_CHECK_EQUAL(rofRecVecD[i].getFirstEntry(), rofRecVec[i].getFirstEntry());
+          BOOST_CHECK_EQUAL(rofRecVecD[i].getNEntries(), rofRecVec[i].getNEntries());
+        }
+        BOOST_REQUIRE_EQUAL(cclusVecD.size(), cclusVec.size());
+        for (size_t i = 0; i < cclusVec.size(); i++) {
+          BOOST_CHECK_EQUAL(cclusVecD[i].getChipID(), cclusVec[i].getChipID());
+          BOOST_CHECK_EQUAL(cclusVecD[i].getRow(), cclusVec[i].getRow());
+          BOOST_CHECK_EQUAL(cclusVecD[i].getCol(), cclusVec[i].getCol());
+          BOOST_CHECK_EQUAL(cclusVecD[i].getPatternID(), cclusVec[i].getPatternID());
+        }
+        BOOST_CHECK(pattVecD == pattVec);
+      }
+    }
+  }
+}
@@ -23,6 +23,7 @@
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DataFormatsITSMFT/CTF.h"
 #include "DataFormatsTPC/CTF.h"
 #include "DataFormatsTRD/CTF.h"
@@ -72,6 +73,10 @@ class CTFReaderSpec : public o2::framework::Task
   void run(o2::framework::ProcessingContext& pc) final;
 
  private:
+  template <typename C>
+  void processDetector(o2::framework::ProcessingContext& pc, DetID det, DetID::mask_t detsTF, const CTFHeader& ctfHeader, TTree* tree, const CTFFlatFile* flatIn);
+  void setFirstTFOrbit(o2::framework::ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader);
+
   DetID::mask_t mDets;             // detectors
   std::vector<std::string> mInput; // input files
   uint32_t mTFCounter = 0;
@@ -97,6 +102,34 @@ void CTFReaderSpec::init(InitContext& ic)
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("input-dir"));
 }
 
+///_______________________________________
+void CTFReaderSpec::setFirstTFOrbit(ProcessingContext& pc, const std::string& label, const CTFHeader& ctfHeader)
+{
+  auto* hd = pc.outputs().findMessageHeader({label});
+  if (!hd) {
+    throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
+  }
+  hd->firstTForbit = ctfHeader.firstTForbit;
+  hd->tfCounter = mTFCounter;
+}
+
+///_______________________________________
+template <typename C>
+void CTFReaderSpec::processDetector(ProcessingContext& pc, DetID det, DetID::mask_t detsTF, const CTFHeader& ctfHeader, TTree* tree, const CTFFlatFile* flatIn)
+{
+  if (!detsTF[det]) {
+    return;
+  }
+  if (flatIn) { // send mapped file region w/o copying, it is unmapped when the message is released
+    auto sz = flatIn->getDetectorSize(det);
+    pc.outputs().adoptChunk(Output{det.getDataOrigin(), "CTFDATA", 0, Lifetime::Timeframe}, flatIn->mapDetector(det), sz, &CTFFlatFile::unmap, reinterpret_cast<void*>(sz));
+  } else {
+    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(C));
+    C::readFromTree(bufVec, *tree, det.getName());
+  }
+  setFirstTFOrbit(pc, det.getName(), ctfHeader);
+}
+
 ///_______________________________________
 void CTFReaderSpec::run(ProcessingContext& pc)
 {
@@ -112,141 +145,50 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   std::string inputFile = o2::utils::Str::concat_string(mCTFDir, mInput[mNextToProcess]);
   LOG(INFO) << "Reading CTF input " << mNextToProcess << ' ' << inputFile;
 
-  TFile flIn(inputFile.c_str());
-  if (!flIn.IsOpen() || flIn.IsZombie()) {
-    LOG(ERROR) << "Failed to open file " << inputFile;
-    throw std::runtime_error("failed to open CTF file");
-  }
-  std::unique_ptr<TTree> tree((TTree*)flIn.Get(std::string(o2::base::NameConf::CTFTREENAME).c_str()));
-  if (!tree) {
-    throw std::runtime_error("failed to load CTF tree");
-  }
   CTFHeader ctfHeader;
-  if (!readFromTree(*tree, "CTFHeader", ctfHeader)) {
-    throw std::runtime_error("did not find CTFHeader");
+  std::unique_ptr<TFile> flIn;
+  std::unique_ptr<TTree> tree;
+  std::unique_ptr<CTFFlatFile> flatIn;
+  if (CTFFlatFile::isFlatFile(inputFile)) {
+    flatIn = std::make_unique<CTFFlatFile>();
+    flatIn->open(inputFile);
+    ctfHeader = flatIn->getCTFHeader();
+  } else {
+    flIn.reset(TFile::Open(inputFile.c_str()));
+    if (!flIn || !flIn->IsOpen() || flIn->IsZombie()) {
+      LOG(ERROR) << "Failed to open file " << inputFile;
+      throw std::runtime_error("failed to open CTF file");
+    }
+    tree.reset((TTree*)flIn->Get(std::string(o2::base::NameConf::CTFTREENAME).c_str()));
+    if (!tree) {
+      throw std::runtime_error("failed to load CTF tree");
+    }
+    if (!readFromTree(*tree, "CTFHeader", ctfHeader)) {
+      throw std::runtime_error("did not find CTFHeader");
+    }
   }
   LOG(INFO) << ctfHeader;
 
-  auto setFirstTFOrbit = [&](const std::string& label) {
-    auto* hd = pc.outputs().findMessageHeader({label});
-    if (!hd) {
-      throw std::runtime_error(o2::utils::Str::concat_string("failed to find output message header for ", label));
-    }
-    hd->firstTForbit = ctfHeader.firstTForbit;
-    hd->tfCounter = mTFCounter;
-  };
-
   // send CTF Header
   pc.outputs().snapshot({"header"}, ctfHeader);
-  setFirstTFOrbit("header");
+  setFirstTFOrbit(pc, "header", ctfHeader);
 
   DetID::mask_t detsTF = mDets & ctfHeader.detectors;
-  DetID det;
-
-  det = DetID::ITS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MFT;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::itsmft::CTF));
-    o2::itsmft::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TPC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tpc::CTF));
-    o2::tpc::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TRD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::trd::CTF));
-    o2::trd::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FT0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::ft0::CTF));
-    o2::ft0::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FV0;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fv0::CTF));
-    o2::fv0::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::FDD;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::fdd::CTF));
-    o2::fdd::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::TOF;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::tof::CTF));
-    o2::tof::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MID;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mid::CTF));
-    o2::mid::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::MCH;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::mch::CTF));
-    o2::mch::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::EMC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::emcal::CTF));
-    o2::emcal::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::PHS;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::phos::CTF));
-    o2::phos::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::CPV;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::cpv::CTF));
-    o2::cpv::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::ZDC;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::zdc::CTF));
-    o2::zdc::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
-
-  det = DetID::HMP;
-  if (detsTF[det]) {
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({det.getName()}, sizeof(o2::hmpid::CTF));
-    o2::hmpid::CTF::readFromTree(bufVec, *(tree.get()), det.getName());
-    setFirstTFOrbit(det.getName());
-  }
+  processDetector<o2::itsmft::CTF>(pc, DetID::ITS, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::itsmft::CTF>(pc, DetID::MFT, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::tpc::CTF>(pc, DetID::TPC, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::trd::CTF>(pc, DetID::TRD, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::ft0::CTF>(pc, DetID::FT0, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::fv0::CTF>(pc, DetID::FV0, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::fdd::CTF>(pc, DetID::FDD, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::tof::CTF>(pc, DetID::TOF, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::mid::CTF>(pc, DetID::MID, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::mch::CTF>(pc, DetID::MCH, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::emcal::CTF>(pc, DetID::EMC, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::phos::CTF>(pc, DetID::PHS, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::cpv::CTF>(pc, DetID::CPV, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::zdc::CTF>(pc, DetID::ZDC, detsTF, ctfHeader, tree.get(), flatIn.get());
+  processDetector<o2::hmpid::CTF>(pc, DetID::HMP, detsTF, ctfHeader, tree.get(), flatIn.get());
 
   mTimer.Stop();
   LOGF(INFO, "Read CTF %s in %.3e s", inputFile.c_str(), mTimer.CpuTime() - cput);
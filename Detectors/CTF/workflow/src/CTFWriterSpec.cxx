@@ -17,6 +17,7 @@
 #include "CTFWorkflow/CTFWriterSpec.h"
 
 #include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/StringUtils.h"
@@ -80,7 +81,7 @@ class CTFWriterSpec : public o2::framework::Task
 
  private:
   template <typename C>
-  void processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
+  void processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree, CTFFlatFile* flatFile);
   template <typename C>
   void storeDictionary(DetID det, CTFHeader& header);
   void storeDictionaries();
@@ -92,6 +93,7 @@ class CTFWriterSpec : public o2::framework::Task
   bool mWriteCTF = false;
   bool mCreateDict = false;
   bool mDictPerDetector = false;
+  bool mFlatOutput = false; // write CTF in the flat memory-mappable format instead of the ROOT tree
   size_t mNTF = 0;
   int mSaveDictAfter = -1; // if positive and mWriteCTF==true, save dictionary after each mSaveDictAfter TFs processed
   uint64_t mRun = 0;
@@ -114,7 +116,7 @@ class CTFWriterSpec : public o2::framework::Task
 
 // process data of particular detector
 template <typename C>
-void CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree)
+void CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree, CTFFlatFile* flatFile)
 {
   if (!isPresent(det) || !pc.inputs().isValid(det.getName())) {
     return;
@@ -123,7 +125,11 @@ void CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det,
   const auto ctfImage = C::getImage(ctfBuffer.data());
   ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "));
   if (mWriteCTF) {
-    ctfImage.appendToTree(*tree, det.getName());
+    if (flatFile) { // store the flat image as it is
+      flatFile->addDetector(det, ctfBuffer.data(), ctfBuffer.size_bytes());
+    } else {
+      ctfImage.appendToTree(*tree, det.getName());
+    }
     header.detectors.set(det);
   }
   if (mCreateDict) {
@@ -199,6 +205,12 @@ void CTFWriterSpec::init(InitContext& ic)
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
   mDictDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("ctf-dict-dir"));
   mCTFDir = o2::utils::Str::rectifyDirectory(ic.options().get<std::string>("output-dir"));
+  auto format = ic.options().get<std::string>("output-format");
+  if (format == "flat") {
+    mFlatOutput = true;
+  } else if (format != "root") {
+    throw std::runtime_error(o2::utils::Str::concat_string("unknown CTF output format ", format, ", use root or flat"));
+  }
 }
 
 void CTFWriterSpec::run(ProcessingContext& pc)
@@ -209,33 +221,42 @@ void CTFWriterSpec::run(ProcessingContext& pc)
 
   std::unique_ptr<TFile> fileOut;
   std::unique_ptr<TTree> treeOut;
-  if (mWriteCTF) {
-    fileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
-    treeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
-  }
-
+  std::unique_ptr<CTFFlatFile> flatOut;
   // create header
   CTFHeader header{mRun, dh->firstTForbit};
 
-  processDet<o2::itsmft::CTF>(pc, DetID::ITS, header, treeOut.get());
-  processDet<o2::itsmft::CTF>(pc, DetID::MFT, header, treeOut.get());
-  processDet<o2::tpc::CTF>(pc, DetID::TPC, header, treeOut.get());
-  processDet<o2::trd::CTF>(pc, DetID::TRD, header, treeOut.get());
-  processDet<o2::tof::CTF>(pc, DetID::TOF, header, treeOut.get());
-  processDet<o2::ft0::CTF>(pc, DetID::FT0, header, treeOut.get());
-  processDet<o2::fv0::CTF>(pc, DetID::FV0, header, treeOut.get());
-  processDet<o2::fdd::CTF>(pc, DetID::FDD, header, treeOut.get());
-  processDet<o2::mid::CTF>(pc, DetID::MID, header, treeOut.get());
-  processDet<o2::mch::CTF>(pc, DetID::MCH, header, treeOut.get());
-  processDet<o2::emcal::CTF>(pc, DetID::EMC, header, treeOut.get());
-  processDet<o2::phos::CTF>(pc, DetID::PHS, header, treeOut.get());
-  processDet<o2::cpv::CTF>(pc, DetID::CPV, header, treeOut.get());
-  processDet<o2::zdc::CTF>(pc, DetID::ZDC, header, treeOut.get());
-  processDet<o2::hmpid::CTF>(pc, DetID::HMP, header, treeOut.get());
+  if (mWriteCTF) {
+    if (mFlatOutput) {
+      flatOut = std::make_unique<CTFFlatFile>();
+      flatOut->create(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter, "o2_ctf", o2::base::NameConf::CTFFLAT_EXT_STRING)), header);
+    } else {
+      fileOut.reset(TFile::Open(o2::utils::Str::concat_string(mCTFDir, o2::base::NameConf::getCTFFileName(dh->runNumber, dh->firstTForbit, dh->tfCounter)).c_str(), "recreate"));
+      treeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+    }
+  }
+
+  processDet<o2::itsmft::CTF>(pc, DetID::ITS, header, treeOut.get(), flatOut.get());
+  processDet<o2::itsmft::CTF>(pc, DetID::MFT, header, treeOut.get(), flatOut.get());
+  processDet<o2::tpc::CTF>(pc, DetID::TPC, header, treeOut.get(), flatOut.get());
+  processDet<o2::trd::CTF>(pc, DetID::TRD, header, treeOut.get(), flatOut.get());
+  processDet<o2::tof::CTF>(pc, DetID::TOF, header, treeOut.get(), flatOut.get());
+  processDet<o2::ft0::CTF>(pc, DetID::FT0, header, treeOut.get(), flatOut.get());
+  processDet<o2::fv0::CTF>(pc, DetID::FV0, header, treeOut.get(), flatOut.get());
+  processDet<o2::fdd::CTF>(pc, DetID::FDD, header, treeOut.get(), flatOut.get());
+  processDet<o2::mid::CTF>(pc, DetID::MID, header, treeOut.get(), flatOut.get());
+  processDet<o2::mch::CTF>(pc, DetID::MCH, header, treeOut.get(), flatOut.get());
+  processDet<o2::emcal::CTF>(pc, DetID::EMC, header, treeOut.get(), flatOut.get());
+  processDet<o2::phos::CTF>(pc, DetID::PHS, header, treeOut.get(), flatOut.get());
+  processDet<o2::cpv::CTF>(pc, DetID::CPV, header, treeOut.get(), flatOut.get());
+  processDet<o2::zdc::CTF>(pc, DetID::ZDC, header, treeOut.get(), flatOut.get());
+  processDet<o2::hmpid::CTF>(pc, DetID::HMP, header, treeOut.get(), flatOut.get());
 
   mTimer.Stop();
 
-  if (mWriteCTF) {
+  if (mWriteCTF && flatOut) {
+    flatOut->close(); // the header is written at closing
+    LOG(INFO) << "TF#" << mNTF << ": wrote " << flatOut->getFileName() << " with CTF{" << header << "} in " << mTimer.CpuTime() - cput << " s";
+  } else if (mWriteCTF) {
     appendToTree(*treeOut.get(), "CTFHeader", header);
     treeOut->SetEntries(1);
     treeOut->Write();
@@ -344,7 +365,8 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, uint64_t run, bool doCTF,
     AlgorithmSpec{adaptFromTask<CTFWriterSpec>(dets, run, doCTF, doDict, dictPerDet)},
     Options{{"save-dict-after", VariantType::Int, -1, {"In dictionary generation mode save it dictionary after certain number of TFs processed"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory"}},
-            {"output-dir", VariantType::String, "none", {"CTF output directory"}}}};
+            {"output-dir", VariantType::String, "none", {"CTF output directory"}},
+            {"output-format", VariantType::String, "root", {"CTF output format: root (ROOT tree) or flat (memory-mappable flat file)"}}}};
 }
 
 } // namespace ctf
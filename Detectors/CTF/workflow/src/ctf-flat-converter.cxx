@@ -0,0 +1,201 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   ctf-flat-converter.cxx
+/// @brief  Converter of CTF files between the ROOT tree and the flat memory-mappable formats
+
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/CTFFlatFile.h"
+#include "DetectorsCommonDataFormats/NameConf.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "CommonUtils/StringUtils.h"
+#include "DataFormatsITSMFT/CTF.h"
+#include "DataFormatsTPC/CTF.h"
+#include "DataFormatsTRD/CTF.h"
+#include "DataFormatsHMP/CTF.h"
+#include "DataFormatsFT0/CTF.h"
+#include "DataFormatsFV0/CTF.h"
+#include "DataFormatsFDD/CTF.h"
+#include "DataFormatsTOF/CTF.h"
+#include "DataFormatsMID/CTF.h"
+#include "DataFormatsMCH/CTF.h"
+#include "DataFormatsEMCAL/CTF.h"
+#include "DataFormatsPHOS/CTF.h"
+#include "DataFormatsCPV/CTF.h"
+#include "DataFormatsZDC/CTF.h"
+#include "Framework/Logger.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <boost/program_options.hpp>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using DetID = o2::detectors::DetID;
+using namespace o2::ctf;
+
+// copy detector data from the CTF tree to the flat file
+template <typename C>
+void toFlat(DetID det, const CTFHeader& header, TTree& tree, CTFFlatFile& flatOut)
+{
+  if (!header.detectors[det]) {
+    return;
+  }
+  std::vector<o2::ctf::BufferType> buff;
+  C::readFromTree(buff, tree, det.getName());
+  flatOut.addDetector(det, buff.data(), buff.size() * sizeof(o2::ctf::BufferType));
+}
+
+// copy detector data from the flat file to the CTF tree
+template <typename C>
+void toTree(DetID det, const CTFHeader& header, const CTFFlatFile& flatIn, TTree& tree)
+{
+  if (!header.detectors[det]) {
+    return;
+  }
+  std::vector<o2::ctf::BufferType> buff;
+  flatIn.readDetector(det, buff);
+  C::getImage(buff.data()).appendToTree(tree, det.getName());
+}
+
+void convertToFlat(const std::string& inpName, const std::string& outName)
+{
+  std::unique_ptr<TFile> flIn(TFile::Open(inpName.c_str()));
+  if (!flIn || !flIn->IsOpen() || flIn->IsZombie()) {
+    throw std::runtime_error(o2::utils::Str::concat_string("failed to open CTF file ", inpName));
+  }
+  std::unique_ptr<TTree> tree((TTree*)flIn->Get(std::string(o2::base::NameConf::CTFTREENAME).c_str()));
+  if (!tree) {
+    throw std::runtime_error("failed to load CTF tree");
+  }
+  CTFHeader header;
+  auto* br = tree->GetBranch("CTFHeader");
+  if (!br || br->GetEntries() < 1) {
+    throw std::runtime_error("did not find CTFHeader");
+  }
+  auto* ptr = &header;
+  br->SetAddress(&ptr);
+  br->GetEntry(0);
+  br->ResetAddress();
+
+  CTFFlatFile flatOut;
+  flatOut.create(outName, header);
+  toFlat<o2::itsmft::CTF>(DetID::ITS, header, *tree, flatOut);
+  toFlat<o2::itsmft::CTF>(DetID::MFT, header, *tree, flatOut);
+  toFlat<o2::tpc::CTF>(DetID::TPC, header, *tree, flatOut);
+  toFlat<o2::trd::CTF>(DetID::TRD, header, *tree, flatOut);
+  toFlat<o2::tof::CTF>(DetID::TOF, header, *tree, flatOut);
+  toFlat<o2::ft0::CTF>(DetID::FT0, header, *tree, flatOut);
+  toFlat<o2::fv0::CTF>(DetID::FV0, header, *tree, flatOut);
+  toFlat<o2::fdd::CTF>(DetID::FDD, header, *tree, flatOut);
+  toFlat<o2::mid::CTF>(DetID::MID, header, *tree, flatOut);
+  toFlat<o2::mch::CTF>(DetID::MCH, header, *tree, flatOut);
+  toFlat<o2::emcal::CTF>(DetID::EMC, header, *tree, flatOut);
+  toFlat<o2::phos::CTF>(DetID::PHS, header, *tree, flatOut);
+  toFlat<o2::cpv::CTF>(DetID::CPV, header, *tree, flatOut);
+  toFlat<o2::zdc::CTF>(DetID::ZDC, header, *tree, flatOut);
+  toFlat<o2::hmpid::CTF>(DetID::HMP, header, *tree, flatOut);
+  flatOut.close();
+  LOG(INFO) << "Converted " << inpName << " to flat " << outName << " with CTF{" << header << "}";
+}
+
+void convertToTree(const std::string& inpName, const std::string& outName)
+{
+  CTFFlatFile flatIn;
+  flatIn.open(inpName);
+  auto header = flatIn.getCTFHeader();
+
+  std::unique_ptr<TFile> flOut(TFile::Open(outName.c_str(), "recreate"));
+  auto tree = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
+  toTree<o2::itsmft::CTF>(DetID::ITS, header, flatIn, *tree);
+  toTree<o2::itsmft::CTF>(DetID::MFT, header, flatIn, *tree);
+  toTree<o2::tpc::CTF>(DetID::TPC, header, flatIn, *tree);
+  toTree<o2::trd::CTF>(DetID::TRD, header, flatIn, *tree);
+  toTree<o2::tof::CTF>(DetID::TOF, header, flatIn, *tree);
+  toTree<o2::ft0::CTF>(DetID::FT0, header, flatIn, *tree);
+  toTree<o2::fv0::CTF>(DetID::FV0, header, flatIn, *tree);
+  toTree<o2::fdd::CTF>(DetID::FDD, header, flatIn, *tree);
+  toTree<o2::mid::CTF>(DetID::MID, header, flatIn, *tree);
+  toTree<o2::mch::CTF>(DetID::MCH, header, flatIn, *tree);
+  toTree<o2::emcal::CTF>(DetID::EMC, header, flatIn, *tree);
+  toTree<o2::phos::CTF>(DetID::PHS, header, flatIn, *tree);
+  toTree<o2::cpv::CTF>(DetID::CPV, header, flatIn, *tree);
+  toTree<o2::zdc::CTF>(DetID::ZDC, header, flatIn, *tree);
+  toTree<o2::hmpid::CTF>(DetID::HMP, header, flatIn, *tree);
+
+  auto* ptr = &header;
+  auto* br = tree->Branch("CTFHeader", &ptr);
+  br->Fill();
+  br->ResetAddress();
+  tree->SetEntries(1);
+  tree->Write();
+  tree.reset();
+  flOut->Close();
+  LOG(INFO) << "Converted flat " << inpName << " to " << outName << " with CTF{" << header << "}";
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> fnames;
+  std::string outDir;
+  bpo::variables_map vm;
+  bpo::options_description descOpt("Options");
+  auto desc_add_option = descOpt.add_options();
+  desc_add_option("help,h", "print this help message.");
+  desc_add_option("output-dir,o", bpo::value(&outDir)->default_value("./"), "output directory for converted files");
+
+  bpo::options_description hiddenOpt("hidden");
+  hiddenOpt.add_options()("files", bpo::value(&fnames)->composing(), "");
+
+  bpo::options_description fullOpt("cmd");
+  fullOpt.add(descOpt).add(hiddenOpt);
+
+  bpo::positional_options_description posOpt;
+  posOpt.add("files", -1);
+
+  auto printHelp = [&](std::ostream& stream) {
+    stream << "Usage:   " << argv[0] << " [options] file0 [... fileN]" << std::endl;
+    stream << descOpt << std::endl;
+    stream << "  ROOT CTF files are converted to flat ." << o2::base::NameConf::CTFFLAT_EXT_STRING << " files and vice versa" << std::endl;
+  };
+
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv)
+                 .options(fullOpt)
+                 .positional(posOpt)
+                 .run(),
+               vm);
+    bpo::notify(vm);
+    if (argc == 1 || vm.count("help") || fnames.empty()) {
+      printHelp(std::cout);
+      return 0;
+    }
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n";
+    std::cerr << "Error parsing command line arguments\n";
+    printHelp(std::cerr);
+    return -1;
+  }
+
+  outDir = o2::utils::Str::rectifyDirectory(outDir);
+  for (const auto& inpName : fnames) {
+    std::filesystem::path outPath(inpName);
+    if (CTFFlatFile::isFlatFile(inpName)) {
+      outPath.replace_extension(o2::base::NameConf::ROOT_EXT_STRING);
+      convertToTree(inpName, o2::utils::Str::concat_string(outDir, outPath.filename().string()));
+    } else {
+      outPath.replace_extension(o2::base::NameConf::CTFFLAT_EXT_STRING);
+      convertToFlat(inpName, o2::utils::Str::concat_string(outDir, outPath.filename().string()));
+    }
+  }
+  return 0;
+}
@@ -90,8 +90,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const BCData>& digitVec, const
   using ECB = CTF::base;
 
   ec->setHeader(cd.header);
-  ec->getANSHeader().majorVersion = 0;
-  ec->getANSHeader().minorVersion = 1;
+  ec->setANSHeader(o2::ctf::ANSVersionInterleaved);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
 #define ENCODEFV0(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
   // clang-format off
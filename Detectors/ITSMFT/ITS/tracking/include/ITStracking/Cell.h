@@ -31,6 +31,7 @@ namespace its
 class Cell final
 {
  public:
+  Cell() = default;
   GPU_DEVICE Cell(const int, const int, const int, const int, const int, const float3&, const float);
 
   GPUhdni() int getFirstClusterIndex() const;
@@ -44,13 +45,13 @@ class Cell final
   void setLevel(const int level);
 
  private:
-  const int mFirstClusterIndex;
-  const int mSecondClusterIndex;
-  const int mThirdClusterIndex;
-  const int mFirstTrackletIndex;
-  const int mSecondTrackletIndex;
-  const float3 mNormalVectorCoordinates;
-  const float mCurvature;
+  int mFirstClusterIndex;
+  int mSecondClusterIndex;
+  int mThirdClusterIndex;
+  int mFirstTrackletIndex;
+  int mSecondTrackletIndex;
+  float3 mNormalVectorCoordinates;
+  float mCurvature;
   int mLevel;
 };
 
@@ -73,6 +73,8 @@ class Tracker
   auto& getTrackLabels() { return mTrackLabels; }
 
   void clustersToTracks(const ROframe&, std::ostream& = std::cout);
+  /// Runs the CA steps up to the road finding for one vertex and iteration, the results are left in the primary vertex context
+  float clustersToRoads(const ROframe&, int iVertex, int iteration, std::ostream& = std::cout);
 
   void setROFrame(std::uint32_t f) { mROFrame = f; }
   std::uint32_t getROFrame() const { return mROFrame; }
@@ -92,7 +94,7 @@ class Tracker
   void findRoads(int& iteration);
   void findTracks(const ROframe& ev);
   bool fitTrack(const ROframe& event, TrackITSExt& track, int start, int end, int step, const float chi2cut = o2::constants::math::VeryBig);
-  void traverseCellsTree(const int, const int);
+  void traverseCellsTree(const int, const int, std::vector<Road>&);
   void computeRoadsMClabels(const ROframe&);
   void computeTracksMClabels(const ROframe&);
   void rectifyClusterIndices(const ROframe& event);
@@ -49,6 +49,16 @@ class TrackerTraitsCPU : public TrackerTraits
  protected:
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<Cell>> mCells;
+
+ private:
+  /// Call func(iNextLayerCluster, currentCluster, nextCluster) for each tracklet starting from cluster iCluster of layer iLayer
+  template <typename Func>
+  void processClusterTracklets(int iLayer, int iCluster, Func&& func);
+  /// Call func(currentTracklet, nextTracklet, iNextLayerTracklet, normalVector, curvature) for each cell starting from tracklet iTracklet of layer iLayer
+  template <typename Func>
+  void processTrackletCells(int iLayer, int iTracklet, Func&& func);
+
+  std::vector<int> mOffsets; // Per cluster / tracklet offsets of the multi-threaded count-then-fill passes
 };
 } // namespace its
 } // namespace o2
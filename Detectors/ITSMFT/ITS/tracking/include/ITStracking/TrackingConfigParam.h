@@ -39,6 +39,8 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
 
   // Use TGeo for mat. budget
   bool useMatCorrTGeo = false;
+  // Number of threads for the CPU tracklet, cell, neighbour and road finding
+  int nThreads = 1;
 
   O2ParamDef(TrackerParamConfig, "ITSCATrackerParam");
 };
@@ -27,8 +27,13 @@
 #include <iostream>
 #include <dlfcn.h>
 #include <cstdlib>
+#include <numeric>
 #include <string>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace its
@@ -74,16 +79,7 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
         continue;
       }
 
-      mTraits->UpdateTrackingParameters(mTrkParams[iteration]);
-      /// Ugly hack -> Unifiy float3 definition in CPU and CUDA/HIP code
-      int pass = iteration + iVertex; /// Do not reinitialise the context if we analyse pile-up events
-      std::array<float, 3> pV = {event.getPrimaryVertex(iVertex).x, event.getPrimaryVertex(iVertex).y, event.getPrimaryVertex(iVertex).z};
-      total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
-                            timeBenchmarkOutputStream, mMemParams[iteration], mTrkParams[iteration], event.getClusters(), pV, pass);
-      total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
-      total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
-      total += evaluateTask(&Tracker::findCellsNeighbours, "Neighbour finding", timeBenchmarkOutputStream, iteration);
-      total += evaluateTask(&Tracker::findRoads, "Road finding", timeBenchmarkOutputStream, iteration);
+      total += clustersToRoads(event, iVertex, iteration, timeBenchmarkOutputStream);
       total += evaluateTask(&Tracker::findTracks, "Track finding", timeBenchmarkOutputStream, event);
     }
     if (constants::DoTimeBenchmarks && fair::Logger::Logging(fair::Severity::info)) {
@@ -98,6 +94,22 @@ void Tracker::clustersToTracks(const ROframe& event, std::ostream& timeBenchmark
   }
 }
 
+float Tracker::clustersToRoads(const ROframe& event, int iVertex, int iteration, std::ostream& timeBenchmarkOutputStream)
+{
+  float total{0.f};
+  mTraits->UpdateTrackingParameters(mTrkParams[iteration]);
+  /// Ugly hack -> Unifiy float3 definition in CPU and CUDA/HIP code
+  int pass = iteration + iVertex; /// Do not reinitialise the context if we analyse pile-up events
+  std::array<float, 3> pV = {event.getPrimaryVertex(iVertex).x, event.getPrimaryVertex(iVertex).y, event.getPrimaryVertex(iVertex).z};
+  total += evaluateTask(&Tracker::initialisePrimaryVertexContext, "Context initialisation",
+                        timeBenchmarkOutputStream, mMemParams[iteration], mTrkParams[iteration], event.getClusters(), pV, pass);
+  total += evaluateTask(&Tracker::computeTracklets, "Tracklet finding", timeBenchmarkOutputStream);
+  total += evaluateTask(&Tracker::computeCells, "Cell finding", timeBenchmarkOutputStream);
+  total += evaluateTask(&Tracker::findCellsNeighbours, "Neighbour finding", timeBenchmarkOutputStream, iteration);
+  total += evaluateTask(&Tracker::findRoads, "Road finding", timeBenchmarkOutputStream, iteration);
+  return total;
+}
+
 void Tracker::computeTracklets()
 {
   mTraits->computeLayerTracklets();
@@ -110,6 +122,10 @@ void Tracker::computeCells()
 
 void Tracker::findCellsNeighbours(int& iteration)
 {
+  const int nThreads{mTraits->getNThreads()};
+  std::vector<int> offsets;
+  std::vector<int> neighbours;
+
   for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad() - 1; ++iLayer) {
 
     if (mPrimaryVertexContext->getCells()[iLayer + 1].empty() ||
@@ -121,8 +137,8 @@ void Tracker::findCellsNeighbours(int& iteration)
     const int nextLayerCellsNum{static_cast<int>(mPrimaryVertexContext->getCells()[iLayer + 1].size())};
     mPrimaryVertexContext->getCellsNeighbours()[iLayer].resize(nextLayerCellsNum);
 
-    for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
-
+    /// Call func(iNextLayerCell) for each cell of the next layer compatible with cell iCell
+    auto processCellNeighbours = [&](int iCell, auto&& func) {
       const Cell& currentCell{mPrimaryVertexContext->getCells()[iLayer][iCell]};
       const int nextLayerTrackletIndex{currentCell.getSecondTrackletIndex()};
       const int nextLayerFirstCellIndex{mPrimaryVertexContext->getCellsLookupTable()[iLayer][nextLayerTrackletIndex]};
@@ -132,7 +148,7 @@ void Tracker::findCellsNeighbours(int& iteration)
 
         for (int iNextLayerCell{nextLayerFirstCellIndex}; iNextLayerCell < nextLayerCellsNum; ++iNextLayerCell) {
 
-          Cell& nextCell{mPrimaryVertexContext->getCells()[iLayer + 1][iNextLayerCell]};
+          const Cell& nextCell{mPrimaryVertexContext->getCells()[iLayer + 1][iNextLayerCell]};
           if (nextCell.getFirstTrackletIndex() != nextLayerTrackletIndex) {
             break;
           }
@@ -151,15 +167,55 @@ void Tracker::findCellsNeighbours(int& iteration)
           if (deltaNormalVectorsModulus < mTrkParams[iteration].NeighbourMaxDeltaN[iLayer] &&
               deltaCurvature < mTrkParams[iteration].NeighbourMaxDeltaCurvature[iLayer]) {
 
-            mPrimaryVertexContext->getCellsNeighbours()[iLayer][iNextLayerCell].push_back(iCell);
+            func(iNextLayerCell);
+          }
+        }
+      }
+    };
 
-            const int currentCellLevel{currentCell.getLevel()};
+    /// Link cell iCell to the next layer cell iNextLayerCell and update the level of the latter
+    auto addNeighbour = [&](int iCell, int iNextLayerCell) {
+      Cell& nextCell{mPrimaryVertexContext->getCells()[iLayer + 1][iNextLayerCell]};
+      mPrimaryVertexContext->getCellsNeighbours()[iLayer][iNextLayerCell].push_back(iCell);
 
-            if (currentCellLevel >= nextCell.getLevel()) {
+      const int currentCellLevel{mPrimaryVertexContext->getCells()[iLayer][iCell].getLevel()};
 
-              nextCell.setLevel(currentCellLevel + 1);
-            }
-          }
+      if (currentCellLevel >= nextCell.getLevel()) {
+
+        nextCell.setLevel(currentCellLevel + 1);
+      }
+    };
+
+    if (nThreads == 1) {
+      for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
+        processCellNeighbours(iCell, [&](int iNextLayerCell) { addNeighbour(iCell, iNextLayerCell); });
+      }
+    } else {
+      /// The compatibility checks run in parallel with count-then-fill, the links are then added in the single-threaded order
+      offsets.resize(layerCellsNum + 1);
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif
+      for (int iCell = 0; iCell < layerCellsNum; ++iCell) {
+        int nNeighbours{0};
+        processCellNeighbours(iCell, [&nNeighbours](int) { ++nNeighbours; });
+        offsets[iCell + 1] = nNeighbours;
+      }
+      offsets[0] = 0;
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      neighbours.resize(offsets[layerCellsNum]);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif
+      for (int iCell = 0; iCell < layerCellsNum; ++iCell) {
+        int iNeighbour{offsets[iCell]};
+        processCellNeighbours(iCell, [&](int iNextLayerCell) { neighbours[iNeighbour++] = iNextLayerCell; });
+      }
+
+      for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
+        for (int iNeighbour{offsets[iCell]}; iNeighbour < offsets[iCell + 1]; ++iNeighbour) {
+          addNeighbour(iCell, neighbours[iNeighbour]);
         }
       }
     }
@@ -168,6 +224,9 @@ void Tracker::findCellsNeighbours(int& iteration)
 
 void Tracker::findRoads(int& iteration)
 {
+  const int nThreads{mTraits->getNThreads()};
+  std::vector<std::vector<Road>> threadRoads(nThreads - 1);
+
   for (int iLevel{mTrkParams[iteration].CellsPerRoad()}; iLevel >= mTrkParams[iteration].CellMinimumLevel(); --iLevel) {
     CA_DEBUGGER(int nRoads = -mPrimaryVertexContext->getRoads().size());
     const int minimumLevel{iLevel - 1};
@@ -176,49 +235,68 @@ void Tracker::findRoads(int& iteration)
 
       const int levelCellsNum{static_cast<int>(mPrimaryVertexContext->getCells()[iLayer].size())};
 
-      for (int iCell{0}; iCell < levelCellsNum; ++iCell) {
+      /// Each thread collects the roads of a contiguous range of cells, the ranges are appended in order afterwards
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(nThreads)
+#endif
+      {
+#ifdef WITH_OPENMP
+        const int iThread{omp_get_thread_num()};
+#else
+        const int iThread{0};
+#endif
+        std::vector<Road>& roads = iThread == 0 ? mPrimaryVertexContext->getRoads() : threadRoads[iThread - 1];
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int iCell = 0; iCell < levelCellsNum; ++iCell) {
 
-        Cell& currentCell{mPrimaryVertexContext->getCells()[iLayer][iCell]};
+          const Cell& currentCell{mPrimaryVertexContext->getCells()[iLayer][iCell]};
 
-        if (currentCell.getLevel() != iLevel) {
-          continue;
-        }
+          if (currentCell.getLevel() != iLevel) {
+            continue;
+          }
 
-        mPrimaryVertexContext->getRoads().emplace_back(iLayer, iCell);
+          roads.emplace_back(iLayer, iCell);
 
-        /// For 3 clusters roads (useful for cascades and hypertriton) we just store the single cell
-        /// and we do not do the candidate tree traversal
-        if (iLevel == 1) {
-          continue;
-        }
+          /// For 3 clusters roads (useful for cascades and hypertriton) we just store the single cell
+          /// and we do not do the candidate tree traversal
+          if (iLevel == 1) {
+            continue;
+          }
 
-        const int cellNeighboursNum{static_cast<int>(
-          mPrimaryVertexContext->getCellsNeighbours()[iLayer - 1][iCell].size())};
-        bool isFirstValidNeighbour = true;
+          const int cellNeighboursNum{static_cast<int>(
+            mPrimaryVertexContext->getCellsNeighbours()[iLayer - 1][iCell].size())};
+          bool isFirstValidNeighbour = true;
 
-        for (int iNeighbourCell{0}; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
+          for (int iNeighbourCell{0}; iNeighbourCell < cellNeighboursNum; ++iNeighbourCell) {
 
-          const int neighbourCellId = mPrimaryVertexContext->getCellsNeighbours()[iLayer - 1][iCell][iNeighbourCell];
-          const Cell& neighbourCell = mPrimaryVertexContext->getCells()[iLayer - 1][neighbourCellId];
+            const int neighbourCellId = mPrimaryVertexContext->getCellsNeighbours()[iLayer - 1][iCell][iNeighbourCell];
+            const Cell& neighbourCell = mPrimaryVertexContext->getCells()[iLayer - 1][neighbourCellId];
 
-          if (iLevel - 1 != neighbourCell.getLevel()) {
-            continue;
-          }
+            if (iLevel - 1 != neighbourCell.getLevel()) {
+              continue;
+            }
+
+            if (isFirstValidNeighbour) {
 
-          if (isFirstValidNeighbour) {
+              isFirstValidNeighbour = false;
 
-            isFirstValidNeighbour = false;
+            } else {
 
-          } else {
+              roads.emplace_back(iLayer, iCell);
+            }
 
-            mPrimaryVertexContext->getRoads().emplace_back(iLayer, iCell);
+            traverseCellsTree(neighbourCellId, iLayer - 1, roads);
           }
 
-          traverseCellsTree(neighbourCellId, iLayer - 1);
+          // TODO: crosscheck for short track iterations
+          // currentCell.setLevel(0);
         }
-
-        // TODO: crosscheck for short track iterations
-        // currentCell.setLevel(0);
+      }
+      for (auto& roads : threadRoads) {
+        mPrimaryVertexContext->getRoads().insert(mPrimaryVertexContext->getRoads().end(), roads.begin(), roads.end());
+        roads.clear();
       }
     }
 #ifdef CA_DEBUG
@@ -439,12 +517,12 @@ bool Tracker::fitTrack(const ROframe& event, TrackITSExt& track, int start, int
   return true;
 }
 
-void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerId)
+void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerId, std::vector<Road>& roads)
 {
   Cell& currentCell{mPrimaryVertexContext->getCells()[currentLayerId][currentCellId]};
   const int currentCellLevel = currentCell.getLevel();
 
-  mPrimaryVertexContext->getRoads().back().addCell(currentLayerId, currentCellId);
+  roads.back().addCell(currentLayerId, currentCellId);
 
   if (currentLayerId > 0 && currentCellLevel > 1) {
     const int cellNeighboursNum{static_cast<int>(
@@ -464,10 +542,10 @@ void Tracker::traverseCellsTree(const int currentCellId, const int currentLayerI
       if (isFirstValidNeighbour) {
         isFirstValidNeighbour = false;
       } else {
-        mPrimaryVertexContext->getRoads().push_back(mPrimaryVertexContext->getRoads().back());
+        roads.push_back(roads.back());
       }
 
-      traverseCellsTree(neighbourCellId, currentLayerId - 1);
+      traverseCellsTree(neighbourCellId, currentLayerId - 1, roads);
     }
   }
 
@@ -650,6 +728,14 @@ void Tracker::getGlobalConfiguration()
   if (tc.useMatCorrTGeo) {
     setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrTGeo);
   }
+#ifdef WITH_OPENMP
+  mTraits->setNThreads(tc.nThreads);
+#else
+  if (tc.nThreads > 1) {
+    LOG(WARNING) << "ITS tracker compiled without OpenMP, using a single thread";
+  }
+  mTraits->setNThreads(1);
+#endif
 }
 
 } // namespace its
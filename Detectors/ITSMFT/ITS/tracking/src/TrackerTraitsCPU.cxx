@@ -23,6 +23,7 @@
 #include "ReconstructionDataFormats/Track.h"
 #include <cassert>
 #include <iostream>
+#include <numeric>
 
 #include "GPUCommonMath.h"
 
@@ -31,84 +32,124 @@ namespace o2
 namespace its
 {
 
-void TrackerTraitsCPU::computeLayerTracklets()
+template <typename Func>
+void TrackerTraitsCPU::processClusterTracklets(int iLayer, int iCluster, Func&& func)
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
-  for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
-    if (primaryVertexContext->getClusters()[iLayer].empty() || primaryVertexContext->getClusters()[iLayer + 1].empty()) {
-      continue;
-    }
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
-    const int currentLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer].size())};
+  if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
+    return;
+  }
 
-    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-      const Cluster& currentCluster{primaryVertexContext->getClusters()[iLayer][iCluster]};
+  const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
+  const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
+                                   currentCluster.rCoordinate) +
+                      currentCluster.zCoordinate};
+  const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
+                                   currentCluster.rCoordinate) +
+                      currentCluster.zCoordinate};
 
-      if (primaryVertexContext->isClusterUsed(iLayer, currentCluster.clusterId)) {
-        continue;
-      }
+  const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
+                                          mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
 
-      const float tanLambda{(currentCluster.zCoordinate - primaryVertex.z) / currentCluster.rCoordinate};
-      const float zAtRmin{tanLambda * (mPrimaryVertexContext->getMinR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
-      const float zAtRmax{tanLambda * (mPrimaryVertexContext->getMaxR(iLayer + 1) -
-                                       currentCluster.rCoordinate) +
-                          currentCluster.zCoordinate};
+  if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+    return;
+  }
 
-      const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                              mTrkParams.TrackletMaxDeltaZ[iLayer], mTrkParams.TrackletMaxDeltaPhi)};
+  int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-      if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-        continue;
-      }
+  if (phiBinsNum < 0) {
+    phiBinsNum += mTrkParams.PhiBins;
+  }
 
-      int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+  for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
+       iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
+    const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+    const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+    const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
+    const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
 
-      if (phiBinsNum < 0) {
-        phiBinsNum += mTrkParams.PhiBins;
-      }
+    for (int iNextLayerCluster{firstRowClusterIndex}; iNextLayerCluster < maxRowClusterIndex;
+         ++iNextLayerCluster) {
 
-      for (int iPhiBin{selectedBinsRect.y}, iPhiCount{0}; iPhiCount < phiBinsNum;
-           iPhiBin = ++iPhiBin == mTrkParams.PhiBins ? 0 : iPhiBin, iPhiCount++) {
-        const int firstBinIndex{primaryVertexContext->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-        const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-        const int firstRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][firstBinIndex];
-        const int maxRowClusterIndex = primaryVertexContext->getIndexTables()[iLayer][maxBinIndex];
+      if (iNextLayerCluster >= (int)primaryVertexContext->getClusters()[iLayer + 1].size()) {
+        break;
+      }
 
-        for (int iNextLayerCluster{firstRowClusterIndex}; iNextLayerCluster < maxRowClusterIndex;
-             ++iNextLayerCluster) {
+      const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
 
-          if (iNextLayerCluster >= (int)primaryVertexContext->getClusters()[iLayer + 1].size()) {
-            break;
-          }
+      if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+        continue;
+      }
 
-          const Cluster& nextCluster{primaryVertexContext->getClusters()[iLayer + 1][iNextLayerCluster]};
+      const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) +
+                                                     currentCluster.zCoordinate - nextCluster.zCoordinate)};
+      const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
 
-          if (primaryVertexContext->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-            continue;
-          }
+      if (deltaZ < mTrkParams.TrackletMaxDeltaZ[iLayer] &&
+          (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
+           o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
 
-          const float deltaZ{o2::gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.rCoordinate - currentCluster.rCoordinate) +
-                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
-          const float deltaPhi{o2::gpu::GPUCommonMath::Abs(currentCluster.phiCoordinate - nextCluster.phiCoordinate)};
+        func(iNextLayerCluster, currentCluster, nextCluster);
+      }
+    }
+  }
+}
 
-          if (deltaZ < mTrkParams.TrackletMaxDeltaZ[iLayer] &&
-              (deltaPhi < mTrkParams.TrackletMaxDeltaPhi ||
-               o2::gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < mTrkParams.TrackletMaxDeltaPhi)) {
+void TrackerTraitsCPU::computeLayerTracklets()
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  for (int iLayer{0}; iLayer < mTrkParams.TrackletsPerRoad(); ++iLayer) {
+    if (primaryVertexContext->getClusters()[iLayer].empty() || primaryVertexContext->getClusters()[iLayer + 1].empty()) {
+      continue;
+    }
 
-            if (iLayer > 0 &&
-                primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
+    const int currentLayerClustersNum{static_cast<int>(primaryVertexContext->getClusters()[iLayer].size())};
+    auto& tracklets = primaryVertexContext->getTracklets()[iLayer];
 
-              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] =
-                primaryVertexContext->getTracklets()[iLayer].size();
-            }
+    if (mNThreads == 1) {
+      for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+        processClusterTracklets(iLayer, iCluster, [&](int iNextLayerCluster, const Cluster& currentCluster, const Cluster& nextCluster) {
+          if (iLayer > 0 &&
+              primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] == constants::its::UnusedIndex) {
 
-            primaryVertexContext->getTracklets()[iLayer].emplace_back(iCluster, iNextLayerCluster, currentCluster,
-                                                                      nextCluster);
+            primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] = tracklets.size();
           }
+
+          tracklets.emplace_back(iCluster, iNextLayerCluster, currentCluster, nextCluster);
+        });
+      }
+    } else {
+      /// Count the tracklets of each cluster, then fill them in place: the output is the same as with a single thread
+      mOffsets.resize(currentLayerClustersNum + 1);
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 64)
+#endif
+      for (int iCluster = 0; iCluster < currentLayerClustersNum; ++iCluster) {
+        int nTracklets{0};
+        processClusterTracklets(iLayer, iCluster, [&nTracklets](int, const Cluster&, const Cluster&) { ++nTracklets; });
+        mOffsets[iCluster + 1] = nTracklets;
+      }
+      mOffsets[0] = tracklets.size();
+      std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+      tracklets.resize(mOffsets[currentLayerClustersNum]);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 64)
+#endif
+      for (int iCluster = 0; iCluster < currentLayerClustersNum; ++iCluster) {
+        int iTracklet{mOffsets[iCluster]};
+        if (iTracklet == mOffsets[iCluster + 1]) {
+          continue;
         }
+        if (iLayer > 0) {
+          primaryVertexContext->getTrackletsLookupTable()[iLayer - 1][iCluster] = iTracklet;
+        }
+        processClusterTracklets(iLayer, iCluster, [&](int iNextLayerCluster, const Cluster& currentCluster, const Cluster& nextCluster) {
+          tracklets[iTracklet++] = Tracklet(iCluster, iNextLayerCluster, currentCluster, nextCluster);
+        });
       }
     }
     if (iLayer > 0 && iLayer < mTrkParams.TrackletsPerRoad() - 1 &&
@@ -126,6 +167,105 @@ void TrackerTraitsCPU::computeLayerTracklets()
 #endif
 }
 
+template <typename Func>
+void TrackerTraitsCPU::processTrackletCells(int iLayer, int iTracklet, Func&& func)
+{
+  PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
+  const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
+  const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
+  const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+  const int nextLayerFirstTrackletIndex{
+    primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+
+  if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+
+    return;
+  }
+
+  const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
+  const Cluster& secondCellCluster{
+    primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
+  const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
+  const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
+                                                    secondCellCluster.rCoordinate};
+  const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
+  const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
+
+  for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
+       iNextLayerTracklet < nextLayerTrackletsNum &&
+       primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
+         nextLayerClusterIndex;
+       ++iNextLayerTracklet) {
+
+    const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
+    const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+    const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
+
+    if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
+        (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
+         std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
+
+      const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
+      const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
+                                         firstCellCluster.zCoordinate};
+      const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
+
+      if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
+
+        const Cluster& thirdCellCluster{
+          primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
+
+        const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
+                                                         thirdCellCluster.rCoordinate};
+
+        const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
+                                       thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
+                                       thirdCellClusterQuadraticRCoordinate -
+                                         firstCellClusterQuadraticRCoordinate};
+
+        float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
+
+        const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
+                                         cellPlaneNormalVector.y * cellPlaneNormalVector.y +
+                                         cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
+
+        if (vectorNorm < constants::math::FloatMinThreshold ||
+            std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
+
+          continue;
+        }
+
+        const float inverseVectorNorm{1.0f / vectorNorm};
+        const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
+                                           cellPlaneNormalVector.y * inverseVectorNorm,
+                                           cellPlaneNormalVector.z * inverseVectorNorm};
+        const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
+                                  (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
+                                  normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
+        const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
+        const float cellTrajectoryRadius{std::sqrt(
+          (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
+          (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
+        const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
+                                  -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
+        const float distanceOfClosestApproach{std::abs(
+          cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
+
+        if (distanceOfClosestApproach >
+            mTrkParams.CellMaxDCA[iLayer]) {
+
+          continue;
+        }
+
+        const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
+        func(currentTracklet, nextTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+      }
+    }
+  }
+}
+
 void TrackerTraitsCPU::computeLayerCells()
 {
   PrimaryVertexContext* primaryVertexContext = mPrimaryVertexContext;
@@ -137,111 +277,52 @@ void TrackerTraitsCPU::computeLayerCells()
       return;
     }
 
-    const float3& primaryVertex = primaryVertexContext->getPrimaryVertex();
     const int currentLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer].size())};
+    auto& cells = primaryVertexContext->getCells()[iLayer];
 
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
-
-      const Tracklet& currentTracklet{primaryVertexContext->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        primaryVertexContext->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+    if (mNThreads == 1) {
+      for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        processTrackletCells(iLayer, iTracklet, [&](const Tracklet& currentTracklet, const Tracklet& nextTracklet, int iNextLayerTracklet, const float3& normalizedPlaneVector, float cellTrajectoryCurvature) {
+          if (iLayer > 0 &&
+              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
 
-      if (nextLayerFirstTrackletIndex == constants::its::UnusedIndex) {
+            primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] = cells.size();
+          }
 
-        continue;
+          cells.emplace_back(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+                             iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+        });
       }
+    } else {
+      /// Count the cells of each tracklet, then fill them in place: the output is the same as with a single thread
+      mOffsets.resize(currentLayerTrackletsNum + 1);
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 64)
+#endif
+      for (int iTracklet = 0; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        int nCells{0};
+        processTrackletCells(iLayer, iTracklet, [&nCells](const Tracklet&, const Tracklet&, int, const float3&, float) { ++nCells; });
+        mOffsets[iTracklet + 1] = nCells;
+      }
+      mOffsets[0] = cells.size();
+      std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+      cells.resize(mOffsets[currentLayerTrackletsNum]);
 
-      const Cluster& firstCellCluster{primaryVertexContext->getClusters()[iLayer][currentTracklet.firstClusterIndex]};
-      const Cluster& secondCellCluster{
-        primaryVertexContext->getClusters()[iLayer + 1][currentTracklet.secondClusterIndex]};
-      const float firstCellClusterQuadraticRCoordinate{firstCellCluster.rCoordinate * firstCellCluster.rCoordinate};
-      const float secondCellClusterQuadraticRCoordinate{secondCellCluster.rCoordinate *
-                                                        secondCellCluster.rCoordinate};
-      const float3 firstDeltaVector{secondCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                    secondCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                    secondCellClusterQuadraticRCoordinate - firstCellClusterQuadraticRCoordinate};
-      const int nextLayerTrackletsNum{static_cast<int>(primaryVertexContext->getTracklets()[iLayer + 1].size())};
-
-      for (int iNextLayerTracklet{nextLayerFirstTrackletIndex};
-           iNextLayerTracklet < nextLayerTrackletsNum &&
-           primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet].firstClusterIndex ==
-             nextLayerClusterIndex;
-           ++iNextLayerTracklet) {
-
-        const Tracklet& nextTracklet{primaryVertexContext->getTracklets()[iLayer + 1][iNextLayerTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
-        const float deltaPhi{std::abs(currentTracklet.phiCoordinate - nextTracklet.phiCoordinate)};
-
-        if (deltaTanLambda < mTrkParams.CellMaxDeltaTanLambda &&
-            (deltaPhi < mTrkParams.CellMaxDeltaPhi ||
-             std::abs(deltaPhi - constants::math::TwoPi) < mTrkParams.CellMaxDeltaPhi)) {
-
-          const float averageTanLambda{0.5f * (currentTracklet.tanLambda + nextTracklet.tanLambda)};
-          const float directionZIntersection{-averageTanLambda * firstCellCluster.rCoordinate +
-                                             firstCellCluster.zCoordinate};
-          const float deltaZ{std::abs(directionZIntersection - primaryVertex.z)};
-
-          if (deltaZ < mTrkParams.CellMaxDeltaZ[iLayer]) {
-
-            const Cluster& thirdCellCluster{
-              primaryVertexContext->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex]};
-
-            const float thirdCellClusterQuadraticRCoordinate{thirdCellCluster.rCoordinate *
-                                                             thirdCellCluster.rCoordinate};
-
-            const float3 secondDeltaVector{thirdCellCluster.xCoordinate - firstCellCluster.xCoordinate,
-                                           thirdCellCluster.yCoordinate - firstCellCluster.yCoordinate,
-                                           thirdCellClusterQuadraticRCoordinate -
-                                             firstCellClusterQuadraticRCoordinate};
-
-            float3 cellPlaneNormalVector{math_utils::crossProduct(firstDeltaVector, secondDeltaVector)};
-
-            const float vectorNorm{std::sqrt(cellPlaneNormalVector.x * cellPlaneNormalVector.x +
-                                             cellPlaneNormalVector.y * cellPlaneNormalVector.y +
-                                             cellPlaneNormalVector.z * cellPlaneNormalVector.z)};
-
-            if (vectorNorm < constants::math::FloatMinThreshold ||
-                std::abs(cellPlaneNormalVector.z) < constants::math::FloatMinThreshold) {
-
-              continue;
-            }
-
-            const float inverseVectorNorm{1.0f / vectorNorm};
-            const float3 normalizedPlaneVector{cellPlaneNormalVector.x * inverseVectorNorm,
-                                               cellPlaneNormalVector.y * inverseVectorNorm,
-                                               cellPlaneNormalVector.z * inverseVectorNorm};
-            const float planeDistance{-normalizedPlaneVector.x * (secondCellCluster.xCoordinate - primaryVertex.x) -
-                                      (normalizedPlaneVector.y * secondCellCluster.yCoordinate - primaryVertex.y) -
-                                      normalizedPlaneVector.z * secondCellClusterQuadraticRCoordinate};
-            const float normalizedPlaneVectorQuadraticZCoordinate{normalizedPlaneVector.z * normalizedPlaneVector.z};
-            const float cellTrajectoryRadius{std::sqrt(
-              (1.0f - normalizedPlaneVectorQuadraticZCoordinate - 4.0f * planeDistance * normalizedPlaneVector.z) /
-              (4.0f * normalizedPlaneVectorQuadraticZCoordinate))};
-            const float2 circleCenter{-0.5f * normalizedPlaneVector.x / normalizedPlaneVector.z,
-                                      -0.5f * normalizedPlaneVector.y / normalizedPlaneVector.z};
-            const float distanceOfClosestApproach{std::abs(
-              cellTrajectoryRadius - std::sqrt(circleCenter.x * circleCenter.x + circleCenter.y * circleCenter.y))};
-
-            if (distanceOfClosestApproach >
-                mTrkParams.CellMaxDCA[iLayer]) {
-
-              continue;
-            }
-
-            const float cellTrajectoryCurvature{1.0f / cellTrajectoryRadius};
-            if (iLayer > 0 &&
-                primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] == constants::its::UnusedIndex) {
-
-              primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] =
-                primaryVertexContext->getCells()[iLayer].size();
-            }
-
-            primaryVertexContext->getCells()[iLayer].emplace_back(
-              currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
-              iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
-          }
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 64)
+#endif
+      for (int iTracklet = 0; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        int iCell{mOffsets[iTracklet]};
+        if (iCell == mOffsets[iTracklet + 1]) {
+          continue;
+        }
+        if (iLayer > 0) {
+          primaryVertexContext->getCellsLookupTable()[iLayer - 1][iTracklet] = iCell;
         }
+        processTrackletCells(iLayer, iTracklet, [&](const Tracklet& currentTracklet, const Tracklet& nextTracklet, int iNextLayerTracklet, const float3& normalizedPlaneVector, float cellTrajectoryCurvature) {
+          cells[iCell++] = Cell(currentTracklet.firstClusterIndex, nextTracklet.firstClusterIndex, nextTracklet.secondClusterIndex,
+                                iTracklet, iNextLayerTracklet, normalizedPlaneVector, cellTrajectoryCurvature);
+        });
       }
     }
   }
@@ -0,0 +1,168 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ITS CA tracker threads
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "CommonUtils/ConfigurableParam.h"
+#include "ITStracking/Configuration.h"
+#include "ITStracking/ROframe.h"
+#include "ITStracking/Tracker.h"
+#include "ITStracking/TrackerTraitsCPU.h"
+
+using namespace o2::its;
+
+namespace
+{
+// straight and curved tracks from the primary vertex with some missing clusters, plus noise clusters
+ROframe createFrame(const TrackingParameters& params)
+{
+  ROframe frame{0, params.NLayers};
+  frame.addPrimaryVertex(0.f, 0.f, 0.f);
+
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<float> phiDist(0.f, constants::math::TwoPi), tanLambdaDist(-1.f, 1.f), unitDist(0.f, 1.f);
+  for (int iTrack = 0; iTrack < 500; ++iTrack) {
+    const float phi0 = phiDist(gen);
+    const float tanLambda = tanLambdaDist(gen);
+    // signed radius of the track circle in cm, infinite for a straight track
+    const float radius = iTrack % 5 == 0 ? INFINITY : (unitDist(gen) > 0.5f ? 1.f : -1.f) * (100.f + 2000.f * unitDist(gen));
+    for (int iLayer = 0; iLayer < params.NLayers; ++iLayer) {
+      if (unitDist(gen) < 0.05f) {
+        continue;
+      }
+      const float r = params.LayerRadii[iLayer];
+      const float halfAngle = std::asin(r / (2.f * radius));
+      const float arcLength = std::isinf(radius) ? r : 2.f * radius * halfAngle;
+      const float phi = phi0 + halfAngle;
+      frame.addClusterToLayer(iLayer, r * std::cos(phi), r * std::sin(phi), tanLambda * std::abs(arcLength),
+                              frame.getClustersOnLayer(iLayer).size());
+    }
+  }
+  for (int iLayer = 0; iLayer < params.NLayers; ++iLayer) {
+    const float r = params.LayerRadii[iLayer];
+    for (int iNoise = 0; iNoise < 200; ++iNoise) {
+      const float phi = phiDist(gen);
+      const float z = (2.f * unitDist(gen) - 1.f) * 0.9f * params.LayerZ[iLayer];
+      frame.addClusterToLayer(iLayer, r * std::cos(phi), r * std::sin(phi), z, frame.getClustersOnLayer(iLayer).size());
+    }
+  }
+  return frame;
+}
+
+struct CAOutput {
+  int nThreads;
+  std::vector<std::vector<Tracklet>> tracklets;
+  std::vector<std::vector<int>> trackletsLookupTable;
+  std::vector<std::vector<Cell>> cells;
+  std::vector<std::vector<int>> cellsLookupTable;
+  std::vector<std::vector<std::vector<int>>> cellsNeighbours;
+  std::vector<Road> roads;
+};
+
+CAOutput runCA(const ROframe& frame, const TrackingParameters& params, int nThreads)
+{
+  o2::conf::ConfigurableParam::updateFromString("ITSCATrackerParam.nThreads=" + std::to_string(nThreads));
+  TrackerTraitsCPU traits;
+  Tracker tracker(&traits);
+  tracker.setParameters({MemoryParameters{}}, {params});
+  tracker.getGlobalConfiguration();
+  tracker.clustersToRoads(frame, 0, 0);
+
+  auto* context = traits.getPrimaryVertexContext();
+  return CAOutput{traits.getNThreads(), context->getTracklets(), context->getTrackletsLookupTable(), context->getCells(),
+                  context->getCellsLookupTable(), context->getCellsNeighbours(), context->getRoads()};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(CATrackerThreads_test)
+{
+  TrackingParameters params;
+  params.MinTrackLength = 4; // look for roads of all the lengths
+  const ROframe frame = createFrame(params);
+
+  const CAOutput serial = runCA(frame, params, 1);
+  const CAOutput parallel = runCA(frame, params, 4);
+  BOOST_CHECK_EQUAL(serial.nThreads, 1);
+  BOOST_WARN_MESSAGE(parallel.nThreads == 4, "ITS tracker built without OpenMP, comparing two single-threaded runs");
+
+  BOOST_REQUIRE_EQUAL(serial.tracklets.size(), parallel.tracklets.size());
+  for (size_t iLayer = 0; iLayer < serial.tracklets.size(); ++iLayer) {
+    BOOST_TEST_CONTEXT("tracklet layer " << iLayer)
+    {
+      BOOST_CHECK(!serial.tracklets[iLayer].empty());
+      BOOST_REQUIRE_EQUAL(serial.tracklets[iLayer].size(), parallel.tracklets[iLayer].size());
+      for (size_t i = 0; i < serial.tracklets[iLayer].size(); ++i) {
+        const Tracklet& a = serial.tracklets[iLayer][i];
+        const Tracklet& b = parallel.tracklets[iLayer][i];
+        BOOST_CHECK_EQUAL(a.firstClusterIndex, b.firstClusterIndex);
+        BOOST_CHECK_EQUAL(a.secondClusterIndex, b.secondClusterIndex);
+        BOOST_CHECK_EQUAL(a.tanLambda, b.tanLambda);
+        BOOST_CHECK_EQUAL(a.phiCoordinate, b.phiCoordinate);
+      }
+    }
+  }
+  BOOST_CHECK(serial.trackletsLookupTable == parallel.trackletsLookupTable);
+
+  BOOST_REQUIRE_EQUAL(serial.cells.size(), parallel.cells.size());
+  for (size_t iLayer = 0; iLayer < serial.cells.size(); ++iLayer) {
+    BOOST_TEST_CONTEXT("cell layer " << iLayer)
+    {
+      BOOST_CHECK(!serial.cells[iLayer].empty());
+      BOOST_REQUIRE_EQUAL(serial.cells[iLayer].size(), parallel.cells[iLayer].size());
+      for (size_t i = 0; i < serial.cells[iLayer].size(); ++i) {
+        const Cell& a = serial.cells[iLayer][i];
+        const Cell& b = parallel.cells[iLayer][i];
+        BOOST_CHECK_EQUAL(a.getFirstClusterIndex(), b.getFirstClusterIndex());
+        BOOST_CHECK_EQUAL(a.getSecondClusterIndex(), b.getSecondClusterIndex());
+        BOOST_CHECK_EQUAL(a.getThirdClusterIndex(), b.getThirdClusterIndex());
+        BOOST_CHECK_EQUAL(a.getFirstTrackletIndex(), b.getFirstTrackletIndex());
+        BOOST_CHECK_EQUAL(a.getSecondTrackletIndex(), b.getSecondTrackletIndex());
+        BOOST_CHECK_EQUAL(a.getNormalVectorCoordinates().x, b.getNormalVectorCoordinates().x);
+        BOOST_CHECK_EQUAL(a.getNormalVectorCoordinates().y, b.getNormalVectorCoordinates().y);
+        BOOST_CHECK_EQUAL(a.getNormalVectorCoordinates().z, b.getNormalVectorCoordinates().z);
+        BOOST_CHECK_EQUAL(a.getCurvature(), b.getCurvature());
+        BOOST_CHECK_EQUAL(a.getLevel(), b.getLevel());
+      }
+    }
+  }
+  BOOST_CHECK(serial.cellsLookupTable == parallel.cellsLookupTable);
+
+  BOOST_REQUIRE_EQUAL(serial.cellsNeighbours.size(), parallel.cellsNeighbours.size());
+  for (size_t iLayer = 0; iLayer < serial.cellsNeighbours.size(); ++iLayer) {
+    BOOST_TEST_CONTEXT("neighbour layer " << iLayer)
+    {
+      BOOST_REQUIRE_EQUAL(serial.cellsNeighbours[iLayer].size(), parallel.cellsNeighbours[iLayer].size());
+      for (size_t i = 0; i < serial.cellsNeighbours[iLayer].size(); ++i) {
+        BOOST_CHECK_EQUAL_COLLECTIONS(serial.cellsNeighbours[iLayer][i].begin(), serial.cellsNeighbours[iLayer][i].end(),
+                                      parallel.cellsNeighbours[iLayer][i].begin(), parallel.cellsNeighbours[iLayer][i].end());
+      }
+    }
+  }
+
+  BOOST_CHECK(!serial.roads.empty());
+  BOOST_REQUIRE_EQUAL(serial.roads.size(), parallel.roads.size());
+  for (size_t i = 0; i < serial.roads.size(); ++i) {
+    Road a = serial.roads[i];
+    Road b = parallel.roads[i];
+    BOOST_TEST_CONTEXT("road " << i)
+    {
+      BOOST_CHECK_EQUAL(a.getRoadSize(), b.getRoadSize());
+      for (int iCell = 0; iCell < params.CellsPerRoad(); ++iCell) {
+        BOOST_CHECK_EQUAL(a[iCell], b[iCell]);
+      }
+    }
+  }
+}
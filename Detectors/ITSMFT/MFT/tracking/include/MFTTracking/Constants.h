@@ -40,6 +40,7 @@ constexpr Int_t CellsPerRoad{LayersNumber - 2};
 constexpr Int_t ClustersPerCell{2};
 constexpr Int_t UnusedIndex{-1};
 constexpr Float_t Resolution{0.0005f};
+constexpr Float_t MinCellCosAngle{-1.1f}; // below the cosine of any angle, the deviation between cells is not limited
 constexpr std::array<Float_t, LayersNumber> LayerZCoordinate()
 {
   return std::array<Float_t, LayersNumber>{-45.3, -46.7, -48.6, -50.0, -52.4, -53.8, -67.7, -69.1, -76.1, -77.5};
@@ -60,8 +61,6 @@ constexpr Float_t RMax{16.0};
 
 constexpr Float_t PhiMin{0.};
 constexpr Float_t PhiMax{o2::constants::math::TwoPI}; // [rad]
-
-constexpr Int_t MaxRPhiBins{100 * 100};
 } // namespace index_table
 
 } // namespace constants
@@ -59,6 +59,10 @@ int loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& events, gsl::span
                     gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary& dict,
                     const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels = nullptr, const o2::mft::Tracker* tracker = nullptr);
 
+/// advance the pattern iterator over the patterns of the clusters of the ROF without loading them
+void skipROFramePatterns(const o2::itsmft::ROFRecord& rof, gsl::span<const itsmft::CompClusterExt> clusters,
+                         gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary& dict);
+
 } // namespace ioutils
 } // namespace mft
 } // namespace o2
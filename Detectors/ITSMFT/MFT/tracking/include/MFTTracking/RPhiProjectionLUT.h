@@ -0,0 +1,71 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RPhiProjectionLUT.h
+/// \brief Look-up table of the R-Phi bins of a layer to be searched for a given R-Phi bin of an upstream layer
+///
+
+#ifndef O2_MFT_RPHIPROJECTIONLUT_H_
+#define O2_MFT_RPHIPROJECTIONLUT_H_
+
+#include <array>
+#include <vector>
+#include <gsl/span>
+
+#include "MFTTracking/Constants.h"
+
+namespace o2
+{
+namespace mft
+{
+
+class TrackerConfig;
+
+/// For every pair of layers layer1 < layer2 and every R-Phi bin of layer1 (including the overflow bin), the table
+/// stores the R-Phi bins of layer2 within a binWindow x binWindow window around the straight line projection (from
+/// the origin) of the bin center. The lists are kept in compressed sparse row format: a single flat vector of bins
+/// plus the offsets of the row of every (layer1, layer2, bin1), so the size is defined by the runtime binning only.
+/// Once built, the table is read-only and can be shared between the trackers.
+class RPhiProjectionLUT
+{
+ public:
+  RPhiProjectionLUT() = default;
+
+  void build(const TrackerConfig& conf, const Int_t binWindow);
+
+  gsl::span<const Int_t> getBins(const Int_t layer1, const Int_t layer2, const Int_t bin1) const
+  {
+    auto row = getRow(layer1, layer2, bin1);
+    return gsl::span<const Int_t>(mBins.data() + mOffsets[row], mOffsets[row + 1] - mOffsets[row]);
+  }
+
+  Int_t getNRPhiBins() const { return mNRows - 1; }
+  Int_t getBinWindow() const { return mBinWindow; }
+  size_t getNEntries() const { return mBins.size(); }
+
+ private:
+  static constexpr Int_t NLayerPairs = constants::mft::LayersNumber * (constants::mft::LayersNumber - 1) / 2;
+
+  size_t getRow(const Int_t layer1, const Int_t layer2, const Int_t bin1) const
+  {
+    return size_t(mLayerPairIndex[layer1][layer2]) * mNRows + bin1;
+  }
+
+  Int_t mNRows = 0;     // number of R-Phi bins + overflow bin
+  Int_t mBinWindow = 0; // search window width in bins, in R and Phi
+  std::array<std::array<Int_t, constants::mft::LayersNumber>, constants::mft::LayersNumber> mLayerPairIndex{};
+  std::vector<size_t> mOffsets; // NLayerPairs * mNRows + 1 row offsets in mBins
+  std::vector<Int_t> mBins;
+};
+
+} // namespace mft
+} // namespace o2
+
+#endif /* O2_MFT_RPHIPROJECTIONLUT_H_ */
@@ -15,7 +15,11 @@
 #ifndef O2_MFT_ROAD_H_
 #define O2_MFT_ROAD_H_
 
-#include "MFTTracking/Cell.h"
+#include <array>
+#include <vector>
+#include <cmath>
+#include <iostream>
+
 #include "MFTTracking/Constants.h"
 
 namespace o2
@@ -23,6 +27,9 @@ namespace o2
 namespace mft
 {
 
+/// The points and the cells (segments connecting two points from two planes) of the road are stored in
+/// structure-of-arrays layout: per layer, the coordinates of the points and, for the cells starting in
+/// that layer, the pair of point indices, the unit direction vector and the CA status
 class Road
 {
  public:
@@ -30,9 +37,12 @@ class Road
   void reset();
   void initialize();
 
-  void setPoint(const Int_t layer, const Int_t clusterId)
+  void setPoint(const Int_t layer, const Int_t clusterId, const Float_t x, const Float_t y, const Float_t z)
   {
     mClusterId[layer].push_back(clusterId);
+    mX[layer].push_back(x);
+    mY[layer].push_back(y);
+    mZ[layer].push_back(z);
   }
 
   void setRoadId(const Int_t id) { mRoadId = id; }
@@ -44,13 +54,17 @@ class Road
 
   const std::vector<Int_t>& getClustersIdInLayer(Int_t layer) const { return mClusterId[layer]; }
 
-  template <typename... T>
-  Cell& addCellInLayer(Int_t layer, T&&... args);
+  /// add a cell between the points point1 of layer1 and point2 of layer2, return its index in layer1
+  Int_t addCellInLayer(const Int_t layer1, const Int_t layer2, const Int_t point1, const Int_t point2);
 
-  std::vector<Cell>& getCellsInLayer(Int_t);
+  const Int_t getNCellsInLayer(const Int_t layer) const { return mCellSecondLayer[layer].size(); }
+  const Int_t getCellSecondLayerId(const Int_t layer, const Int_t cellId) const { return mCellSecondLayer[layer][cellId]; }
+  const Int_t getCellFirstClusterIndex(const Int_t layer, const Int_t cellId) const { return mClusterId[layer][mCellFirstPoint[layer][cellId]]; }
+  const Int_t getCellSecondClusterIndex(const Int_t layer, const Int_t cellId) const { return mClusterId[mCellSecondLayer[layer][cellId]][mCellSecondPoint[layer][cellId]]; }
 
   void addLeftNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
-  void addRightNeighbourToCell(const Int_t, const Int_t, const Int_t, const Int_t);
+  const UChar_t getCellNLeftNeighbours(const Int_t layer, const Int_t cellId) const { return mCellNLeftNeighbours[layer][cellId]; }
+  const std::pair<Int_t, Int_t>& getCellLeftNeighbour(const Int_t layer, const Int_t cellId, const Int_t i) const { return mCellLeftNeighbours[layer][cellId * constants::mft::MaxCellNeighbours + i]; }
 
   void incrementCellLevel(const Int_t, const Int_t);
   void updateCellLevel(const Int_t, const Int_t);
@@ -60,30 +74,83 @@ class Road
   void setCellUsed(const Int_t, const Int_t, const Bool_t);
   const Bool_t isCellUsed(const Int_t, const Int_t) const;
 
+  /// flag (in connected, resized to the number of cells in layerR) the cells of layerR which have the same level as the
+  /// cell cellIdL of layerL and start at less than resolution from its end point; return the number of such cells
+  Int_t findConnectedCells(const Int_t layerL, const Int_t cellIdL, const Int_t layerR, std::vector<UChar_t>& connected) const;
+
+  /// cosine of the angle between the directions of two cells
+  const Float_t getCellsCosAngle(const Int_t layer1, const Int_t cellId1, const Int_t layer2, const Int_t cellId2) const
+  {
+    return mCellUX[layer1][cellId1] * mCellUX[layer2][cellId2] + mCellUY[layer1][cellId1] * mCellUY[layer2][cellId2] + mCellUZ[layer1][cellId1] * mCellUZ[layer2][cellId2];
+  }
+
  private:
   Int_t mRoadId;
+  // points
   std::array<std::vector<Int_t>, constants::mft::LayersNumber> mClusterId;
-  std::array<std::vector<Cell>, (constants::mft::LayersNumber - 1)> mCell;
+  std::array<std::vector<Float_t>, constants::mft::LayersNumber> mX;
+  std::array<std::vector<Float_t>, constants::mft::LayersNumber> mY;
+  std::array<std::vector<Float_t>, constants::mft::LayersNumber> mZ;
+  // cells, indexed by the layer of their first point
+  std::array<std::vector<Int_t>, (constants::mft::LayersNumber - 1)> mCellSecondLayer;
+  std::array<std::vector<Int_t>, (constants::mft::LayersNumber - 1)> mCellFirstPoint;
+  std::array<std::vector<Int_t>, (constants::mft::LayersNumber - 1)> mCellSecondPoint;
+  std::array<std::vector<Float_t>, (constants::mft::LayersNumber - 1)> mCellUX;
+  std::array<std::vector<Float_t>, (constants::mft::LayersNumber - 1)> mCellUY;
+  std::array<std::vector<Float_t>, (constants::mft::LayersNumber - 1)> mCellUZ;
+  std::array<std::vector<Int_t>, (constants::mft::LayersNumber - 1)> mCellLevel;
+  std::array<std::vector<UChar_t>, (constants::mft::LayersNumber - 1)> mCellUpdateLevel;
+  std::array<std::vector<UChar_t>, (constants::mft::LayersNumber - 1)> mCellUsed;
+  std::array<std::vector<UChar_t>, (constants::mft::LayersNumber - 1)> mCellNLeftNeighbours;
+  std::array<std::vector<std::pair<Int_t, Int_t>>, (constants::mft::LayersNumber - 1)> mCellLeftNeighbours; // MaxCellNeighbours slots per cell
+  // work space for the points connection test
+  mutable std::vector<UChar_t> mPointMatch;
 };
 
 inline void Road::reset()
 {
-  Int_t layer;
-  for (layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
-    mCell[layer].clear();
+  for (Int_t layer = 0; layer < constants::mft::LayersNumber; ++layer) {
     mClusterId[layer].clear();
+    mX[layer].clear();
+    mY[layer].clear();
+    mZ[layer].clear();
+  }
+  for (Int_t layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
+    mCellSecondLayer[layer].clear();
+    mCellFirstPoint[layer].clear();
+    mCellSecondPoint[layer].clear();
+    mCellUX[layer].clear();
+    mCellUY[layer].clear();
+    mCellUZ[layer].clear();
+    mCellLevel[layer].clear();
+    mCellUpdateLevel[layer].clear();
+    mCellUsed[layer].clear();
+    mCellNLeftNeighbours[layer].clear();
+    mCellLeftNeighbours[layer].clear();
   }
-  mClusterId[layer].clear();
 }
 
 inline void Road::initialize()
 {
-  Int_t layer;
-  for (layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
-    mCell[layer].reserve(constants::mft::MaxCellsInRoad);
+  for (Int_t layer = 0; layer < constants::mft::LayersNumber; ++layer) {
     mClusterId[layer].reserve(constants::mft::MaxPointsInRoad);
+    mX[layer].reserve(constants::mft::MaxPointsInRoad);
+    mY[layer].reserve(constants::mft::MaxPointsInRoad);
+    mZ[layer].reserve(constants::mft::MaxPointsInRoad);
+  }
+  for (Int_t layer = 0; layer < (constants::mft::LayersNumber - 1); ++layer) {
+    mCellSecondLayer[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellFirstPoint[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellSecondPoint[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellUX[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellUY[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellUZ[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellLevel[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellUpdateLevel[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellUsed[layer].reserve(constants::mft::MaxCellsInRoad);
+    mCellNLeftNeighbours[layer].reserve(constants::mft::MaxCellsInRoad);
   }
-  mClusterId[layer].reserve(constants::mft::MaxPointsInRoad);
+  mPointMatch.reserve(constants::mft::MaxPointsInRoad);
 }
 
 inline const Int_t Road::getNPointsInLayer(Int_t layer) const
@@ -104,56 +171,98 @@ inline void Road::getLength(Int_t& layer1, Int_t& layer2) const
   }
 }
 
-template <typename... T>
-Cell& Road::addCellInLayer(Int_t layer, T&&... values)
+inline Int_t Road::addCellInLayer(const Int_t layer1, const Int_t layer2, const Int_t point1, const Int_t point2)
 {
-  mCell[layer].emplace_back(layer, std::forward<T>(values)...);
-  return mCell[layer].back();
-}
+  Float_t dx = mX[layer2][point2] - mX[layer1][point1];
+  Float_t dy = mY[layer2][point2] - mY[layer1][point1];
+  Float_t dz = mZ[layer2][point2] - mZ[layer1][point1];
+  Float_t invMod = 1.f / std::sqrt(dx * dx + dy * dy + dz * dz);
 
-inline std::vector<Cell>& Road::getCellsInLayer(Int_t layer)
-{
-  return mCell[layer];
+  mCellSecondLayer[layer1].push_back(layer2);
+  mCellFirstPoint[layer1].push_back(point1);
+  mCellSecondPoint[layer1].push_back(point2);
+  mCellUX[layer1].push_back(dx * invMod);
+  mCellUY[layer1].push_back(dy * invMod);
+  mCellUZ[layer1].push_back(dz * invMod);
+  mCellLevel[layer1].push_back(1);
+  mCellUpdateLevel[layer1].push_back(0);
+  mCellUsed[layer1].push_back(0);
+  mCellNLeftNeighbours[layer1].push_back(0);
+  mCellLeftNeighbours[layer1].resize(mCellLeftNeighbours[layer1].size() + constants::mft::MaxCellNeighbours);
+  return mCellSecondLayer[layer1].size() - 1;
 }
 
 inline void Road::addLeftNeighbourToCell(const Int_t layer, const Int_t cellId, const Int_t layerL, const Int_t cellIdL)
 {
-  mCell[layer][cellId].addLeftNeighbour(layerL, cellIdL);
-}
-
-inline void Road::addRightNeighbourToCell(const Int_t layer, const Int_t cellId, const Int_t layerR, const Int_t cellIdR)
-{
-  mCell[layer][cellId].addRightNeighbour(layerR, cellIdR);
+  auto& nNeighbours = mCellNLeftNeighbours[layer][cellId];
+  if (nNeighbours >= constants::mft::MaxCellNeighbours) {
+    std::cout << "Maximum number of left neighbours for this cell!" << std::endl;
+    return;
+  }
+  mCellLeftNeighbours[layer][cellId * constants::mft::MaxCellNeighbours + nNeighbours++] = std::pair<Int_t, Int_t>(layerL, cellIdL);
 }
 
 inline void Road::incrementCellLevel(const Int_t layer, const Int_t cellId)
 {
-  mCell[layer][cellId].incrementLevel();
+  mCellUpdateLevel[layer][cellId] = 1;
 }
 
 inline void Road::updateCellLevel(const Int_t layer, const Int_t cellId)
 {
-  mCell[layer][cellId].updateLevel();
+  mCellLevel[layer][cellId] += mCellUpdateLevel[layer][cellId];
+  mCellUpdateLevel[layer][cellId] = 0;
 }
 
 inline const Int_t Road::getCellLevel(const Int_t layer, const Int_t cellId) const
 {
-  return mCell[layer][cellId].getLevel();
+  return mCellLevel[layer][cellId];
 }
 
 inline const Bool_t Road::isCellUsed(const Int_t layer, const Int_t cellId) const
 {
-  return mCell[layer][cellId].isUsed();
+  return mCellUsed[layer][cellId];
 }
 
 inline void Road::setCellUsed(const Int_t layer, const Int_t cellId, const Bool_t suc)
 {
-  mCell[layer][cellId].setUsed(suc);
+  mCellUsed[layer][cellId] = suc;
 }
 
 inline void Road::setCellLevel(const Int_t layer, const Int_t cellId, const Int_t level)
 {
-  mCell[layer][cellId].setLevel(level);
+  mCellLevel[layer][cellId] = level;
+}
+
+inline Int_t Road::findConnectedCells(const Int_t layerL, const Int_t cellIdL, const Int_t layerR, std::vector<UChar_t>& connected) const
+{
+  constexpr Float_t resolution2 = constants::mft::Resolution * constants::mft::Resolution;
+
+  // the cells of layerR start at the points of layerR, test first these points against the end of the left cell
+  const Int_t nPoints = mX[layerR].size();
+  const Float_t x = mX[layerR][mCellSecondPoint[layerL][cellIdL]];
+  const Float_t y = mY[layerR][mCellSecondPoint[layerL][cellIdL]];
+  const Float_t* __restrict__ px = mX[layerR].data();
+  const Float_t* __restrict__ py = mY[layerR].data();
+  mPointMatch.resize(nPoints);
+  UChar_t* __restrict__ pointMatch = mPointMatch.data();
+  for (Int_t i = 0; i < nPoints; ++i) {
+    const Float_t dx = x - px[i];
+    const Float_t dy = y - py[i];
+    pointMatch[i] = (dx * dx + dy * dy) <= resolution2;
+  }
+
+  const Int_t nCells = mCellLevel[layerR].size();
+  const Int_t level = mCellLevel[layerL][cellIdL];
+  const Int_t* __restrict__ cellLevel = mCellLevel[layerR].data();
+  const Int_t* __restrict__ cellPoint = mCellFirstPoint[layerR].data();
+  connected.resize(nCells);
+  UChar_t* __restrict__ cellMatch = connected.data();
+  Int_t nConnected = 0;
+  for (Int_t i = 0; i < nCells; ++i) {
+    cellMatch[i] = (cellLevel[i] == level) & pointMatch[cellPoint[i]];
+    nConnected += cellMatch[i];
+  }
+  return nConnected;
 }
 
 } // namespace mft
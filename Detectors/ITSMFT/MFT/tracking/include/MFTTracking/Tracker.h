@@ -19,6 +19,7 @@
 #include "MFTTracking/TrackFitter.h"
 #include "MFTTracking/Cluster.h"
 #include "MFTTracking/TrackerConfig.h"
+#include "MFTTracking/RPhiProjectionLUT.h"
 
 #include "MathUtils/Utils.h"
 #include "MathUtils/Cartesian.h"
@@ -60,6 +61,7 @@ class Tracker : public TrackerConfig
   std::uint32_t getROFrame() const { return mROFrame; }
 
   void initialize();
+  void initialize(const Tracker& tracker);
   void initConfig(const MFTTrackingParam& trkParam, bool printConfig = false);
 
  private:
@@ -76,10 +78,7 @@ class Tracker : public TrackerConfig
   const Int_t isDiskFace(Int_t layer) const { return (layer % 2); }
   const Float_t getDistanceToSeed(const Cluster&, const Cluster&, const Cluster&) const;
   void getBinClusterRange(const ROframe&, const Int_t, const Int_t, Int_t&, Int_t&) const;
-  const Float_t getCellDeviation(const Cell&, const Cell&) const;
-  const Bool_t getCellsConnect(const Cell&, const Cell&) const;
   void addCellToCurrentTrackCA(const Int_t, const Int_t, ROframe&);
-  void addCellToCurrentRoad(ROframe&, const Int_t, const Int_t, const Int_t, const Int_t, Int_t&);
 
   Float_t mBz = 5.f;
   std::uint32_t mROFrame = 0;
@@ -93,8 +92,9 @@ class Tracker : public TrackerConfig
 
   bool mUseMC = false;
 
-  std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBinsS;
-  std::array<std::array<std::array<std::vector<Int_t>, constants::index_table::MaxRPhiBins>, (constants::mft::LayersNumber - 1)>, (constants::mft::LayersNumber - 1)> mBins;
+  /// R-Phi bins search windows for the second seed point and for the intermediate points, shared between trackers
+  std::shared_ptr<const RPhiProjectionLUT> mBinsS;
+  std::shared_ptr<const RPhiProjectionLUT> mBins;
 
   /// helper to store points of a track candidate
   struct TrackElement {
@@ -110,6 +110,8 @@ class Tracker : public TrackerConfig
 
   /// current road for CA algorithm
   Road mRoad;
+  /// flags of the cells of the right layer connected to the current left cell
+  std::vector<UChar_t> mConnectedCells;
 };
 
 //_________________________________________________________________________________________________
@@ -132,45 +134,14 @@ inline const Float_t Tracker::getDistanceToSeed(const Cluster& cluster1, const C
 //_________________________________________________________________________________________________
 inline void Tracker::getBinClusterRange(const ROframe& event, const Int_t layer, const Int_t bin, Int_t& clsMinIndex, Int_t& clsMaxIndex) const
 {
-  const auto& pair = event.getClusterBinIndexRange(layer)[bin];
-  clsMinIndex = pair.first;
-  clsMaxIndex = pair.second;
-}
-
-//_________________________________________________________________________________________________
-inline const Float_t Tracker::getCellDeviation(const Cell& cell1, const Cell& cell2) const
-{
-  Float_t cell1dx = cell1.getX2() - cell1.getX1();
-  Float_t cell1dy = cell1.getY2() - cell1.getY1();
-  Float_t cell1dz = cell1.getZ2() - cell1.getZ1();
-
-  Float_t cell2dx = cell2.getX2() - cell2.getX1();
-  Float_t cell2dy = cell2.getY2() - cell2.getY1();
-  Float_t cell2dz = cell2.getZ2() - cell2.getZ1();
-
-  Float_t cell1mod = std::sqrt(cell1dx * cell1dx + cell1dy * cell1dy + cell1dz * cell1dz);
-  Float_t cell2mod = std::sqrt(cell2dx * cell2dx + cell2dy * cell2dy + cell2dz * cell2dz);
-
-  Float_t cosAngle = (cell1dx * cell2dx + cell1dy * cell2dy + cell1dz * cell2dz) / (cell1mod * cell2mod);
-
-  return std::acos(cosAngle);
-}
-
-//_________________________________________________________________________________________________
-inline const Bool_t Tracker::getCellsConnect(const Cell& cell1, const Cell& cell2) const
-{
-  Float_t cell1x2 = cell1.getX2();
-  Float_t cell1y2 = cell1.getY2();
-  Float_t cell2x1 = cell2.getX1();
-  Float_t cell2y1 = cell2.getY1();
-  Float_t dx = cell1x2 - cell2x1;
-  Float_t dy = cell1y2 - cell2y1;
-  Float_t dr2 = dx * dx + dy * dy;
-
-  if (dr2 > (constants::mft::Resolution * constants::mft::Resolution)) {
-    return kFALSE;
+  const auto& ranges = event.getClusterBinIndexRange(layer);
+  if (bin >= (Int_t)ranges.size()) { // no clusters in this and higher bins
+    clsMinIndex = 0;
+    clsMaxIndex = -1;
+    return;
   }
-  return kTRUE;
+  clsMinIndex = ranges[bin].first;
+  clsMaxIndex = ranges[bin].second;
 }
 
 //_________________________________________________________________________________________________
@@ -81,5 +81,19 @@ int ioutils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe& event, g
   return clusters_in_frame.size();
 }
 
+void ioutils::skipROFramePatterns(const o2::itsmft::ROFRecord& rof, gsl::span<const itsmft::CompClusterExt> clusters, gsl::span<const unsigned char>::iterator& pattIt, const itsmft::TopologyDictionary& dict)
+{
+  // same pattern consumption rule as in loadROFrameData: explicit patterns are stored for the
+  // clusters without dictionary ID and for the clusters of the grouped topologies
+  for (auto& c : rof.getROFData(clusters)) {
+    auto pattID = c.getPatternID();
+    if (pattID == itsmft::CompCluster::InvalidPatternID || dict.isGroup(pattID)) {
+      int nBits = (*pattIt++);
+      nBits *= (*pattIt++);
+      pattIt += (nBits + 7) / 8;
+    }
+  }
+}
+
 } // namespace mft
 } // namespace o2
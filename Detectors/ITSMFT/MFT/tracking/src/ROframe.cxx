@@ -52,6 +52,8 @@ void ROframe::sortClusters()
     // find the cluster local index range in each bin
     // index = element position in the vector
     nClsInLayer = mClusters[iLayer].size();
+    // the clusters are sorted, the last one defines the number of bins with possible clusters
+    mClusterBinIndexRange[iLayer].assign(mClusters[iLayer].back().indexTableBin + 1, std::pair<Int_t, Int_t>(0, -1));
     binPrevIndex = mClusters[iLayer].at(0).indexTableBin;
     clsMinIndex = 0;
     for (jClsLayer = 1; jClsLayer < nClsInLayer; ++jClsLayer) {
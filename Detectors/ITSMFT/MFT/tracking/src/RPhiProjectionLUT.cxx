@@ -0,0 +1,108 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RPhiProjectionLUT.cxx
+///
+
+#include "MFTTracking/RPhiProjectionLUT.h"
+#include "MFTTracking/TrackerConfig.h"
+
+#include "MathUtils/Utils.h"
+#include "MathUtils/Cartesian.h"
+
+#include <TMath.h>
+
+namespace o2
+{
+namespace mft
+{
+
+//_________________________________________________________________________________________________
+void RPhiProjectionLUT::build(const TrackerConfig& conf, const Int_t binWindow)
+{
+  /// layer1 + global R-Phi bin index ---> layer2 + R-Phi bins in the window around the projection
+
+  Float_t dz, x, y, r, phi, x_proj, y_proj, r_proj, phi_proj;
+  Int_t binIndex1, binR_proj, binPhi_proj, binR, binPhi;
+
+  mNRows = conf.mRBins * conf.mPhiBins + 1;
+  mBinWindow = binWindow;
+  const Int_t binhw = binWindow / 2;
+
+  Int_t pair = 0;
+  for (Int_t layer1 = 0; layer1 < (constants::mft::LayersNumber - 1); ++layer1) {
+    for (Int_t layer2 = (layer1 + 1); layer2 < constants::mft::LayersNumber; ++layer2) {
+      mLayerPairIndex[layer1][layer2] = pair++;
+    }
+  }
+
+  // the rows are filled in the storage order: layer pair, then bin of layer1, the overflow bin row stays empty
+  mOffsets.assign(size_t(NLayerPairs) * mNRows + 1, 0);
+  mBins.clear();
+  mBins.reserve(size_t(NLayerPairs) * (mNRows - 1) * binWindow * binWindow);
+
+  for (Int_t layer1 = 0; layer1 < (constants::mft::LayersNumber - 1); ++layer1) {
+
+    for (Int_t layer2 = (layer1 + 1); layer2 < constants::mft::LayersNumber; ++layer2) {
+
+      dz = constants::mft::LayerZCoordinate()[layer2] - constants::mft::LayerZCoordinate()[layer1];
+
+      for (binIndex1 = 0; binIndex1 < mNRows; ++binIndex1) {
+
+        auto row = getRow(layer1, layer2, binIndex1);
+        mOffsets[row] = mBins.size();
+
+        if (binIndex1 == mNRows - 1) { // overflow bin
+          continue;
+        }
+        // bins are ordered as in TrackerConfig::getBinIndex
+        Int_t iRBin = binIndex1 % conf.mRBins;
+        Int_t iPhiBin = binIndex1 / conf.mRBins;
+
+        r = (iRBin + 0.5) * conf.mRBinSize + constants::index_table::RMin;
+        phi = (iPhiBin + 0.5) * conf.mPhiBinSize + constants::index_table::PhiMin;
+
+        x = r * TMath::Cos(phi);
+        y = r * TMath::Sin(phi);
+
+        x_proj = x + dz * x * constants::mft::InverseLayerZCoordinate()[layer1];
+        y_proj = y + dz * y * constants::mft::InverseLayerZCoordinate()[layer1];
+        auto clsPoint2D = math_utils::Point2D<Float_t>(x_proj, y_proj);
+        r_proj = clsPoint2D.R();
+        phi_proj = clsPoint2D.Phi();
+        o2::math_utils::bringTo02PiGen(phi_proj);
+
+        binR_proj = conf.getRBinIndex(r_proj);
+        binPhi_proj = conf.getPhiBinIndex(phi_proj);
+
+        for (Int_t iR = 0; iR < binWindow; ++iR) {
+          binR = binR_proj + (iR - binhw);
+          if (binR < 0) {
+            continue;
+          }
+
+          for (Int_t iPhi = 0; iPhi < binWindow; ++iPhi) {
+            binPhi = binPhi_proj + (iPhi - binhw);
+            if (binPhi < 0) {
+              continue;
+            }
+
+            mBins.push_back(conf.getBinIndex(binR, binPhi));
+          }
+        }
+      } // end loop bin of layer1
+    }   // end loop layer2
+  }     // end loop layer1
+  mOffsets.back() = mBins.size();
+  mBins.shrink_to_fit();
+}
+
+} // namespace mft
+} // namespace o2
@@ -13,7 +13,6 @@
 
 #include "MFTTracking/Tracker.h"
 #include "MFTTracking/Cluster.h"
-#include "MFTTracking/Cell.h"
 #include "MFTTracking/TrackCA.h"
 #include "DataFormatsMFT/TrackMFT.h"
 #include "ReconstructionDataFormats/Track.h"
@@ -62,15 +61,10 @@ void Tracker::initConfig(const MFTTrackingParam& trkParam, bool printConfig)
   mRBins = trkParam.RBins;
   mPhiBins = trkParam.PhiBins;
   mRPhiBins = trkParam.RBins * trkParam.PhiBins;
-  if (mRPhiBins > constants::index_table::MaxRPhiBins) {
-    LOG(WARN) << "To many RPhiBins for this configuration!";
-    mRPhiBins = constants::index_table::MaxRPhiBins;
-    mRBins = sqrt(constants::index_table::MaxRPhiBins);
-    mPhiBins = sqrt(constants::index_table::MaxRPhiBins);
-    LOG(WARN) << "Using instead RBins " << mRBins << " and PhiBins " << mPhiBins;
-  }
   mRBinSize = (constants::index_table::RMax - constants::index_table::RMin) / mRBins;
   mPhiBinSize = (constants::index_table::PhiMax - constants::index_table::PhiMin) / mPhiBins;
+  mInverseRBinSize = 1. / mRBinSize;
+  mInversePhiBinSize = 1. / mPhiBinSize;
 
   if (printConfig) {
     LOG(INFO) << "Configurable tracker parameters:";
@@ -90,94 +84,35 @@ void Tracker::initConfig(const MFTTrackingParam& trkParam, bool printConfig)
 //_________________________________________________________________________________________________
 void Tracker::initialize()
 {
-  /// calculate Look-Up-Table of the R-Phi bins projection from one layer to another
-  /// layer1 + global R-Phi bin index ---> layer2 + R bin index + Phi bin index
-
-  Float_t dz, x, y, r, phi, x_proj, y_proj, r_proj, phi_proj;
-  Int_t binIndex1, binIndex2, binIndex2S, binR_proj, binPhi_proj;
-
-  for (Int_t layer1 = 0; layer1 < (constants::mft::LayersNumber - 1); ++layer1) {
-
-    for (Int_t iRBin = 0; iRBin < mRBins; ++iRBin) {
-
-      r = (iRBin + 0.5) * mRBinSize + constants::index_table::RMin;
-
-      for (Int_t iPhiBin = 0; iPhiBin < mPhiBins; ++iPhiBin) {
-
-        phi = (iPhiBin + 0.5) * mPhiBinSize + constants::index_table::PhiMin;
-
-        binIndex1 = getBinIndex(iRBin, iPhiBin);
+  /// calculate Look-Up-Tables of the R-Phi bins projection from one layer to another
+  /// layer1 + global R-Phi bin index ---> layer2 + R-Phi bins in the search window
 
-        x = r * TMath::Cos(phi);
-        y = r * TMath::Sin(phi);
+  auto binsS = std::make_shared<RPhiProjectionLUT>();
+  binsS->build(*this, mLTFseed2BinWin);
+  mBinsS = binsS;
 
-        for (Int_t layer2 = (layer1 + 1); layer2 < constants::mft::LayersNumber; ++layer2) {
+  auto bins = std::make_shared<RPhiProjectionLUT>();
+  bins->build(*this, mLTFinterBinWin);
+  mBins = bins;
 
-          dz = constants::mft::LayerZCoordinate()[layer2] - constants::mft::LayerZCoordinate()[layer1];
-          x_proj = x + dz * x * constants::mft::InverseLayerZCoordinate()[layer1];
-          y_proj = y + dz * y * constants::mft::InverseLayerZCoordinate()[layer1];
-          auto clsPoint2D = math_utils::Point2D<Float_t>(x_proj, y_proj);
-          r_proj = clsPoint2D.R();
-          phi_proj = clsPoint2D.Phi();
-          o2::math_utils::bringTo02PiGen(phi_proj);
-
-          binR_proj = getRBinIndex(r_proj);
-          binPhi_proj = getPhiBinIndex(phi_proj);
-
-          int binRS, binPhiS;
-
-          int binwRS = mLTFseed2BinWin;
-          int binhwRS = binwRS / 2;
-
-          int binwPhiS = mLTFseed2BinWin;
-          int binhwPhiS = binwPhiS / 2;
-
-          for (Int_t iR = 0; iR < binwRS; ++iR) {
-            binRS = binR_proj + (iR - binhwRS);
-            if (binRS < 0) {
-              continue;
-            }
+  LOG(DEBUG) << "R-Phi projection tables for " << mRPhiBins << " bins: " << mBinsS->getNEntries() << " (seed) and " << mBins->getNEntries() << " (intermediate) entries";
 
-            for (Int_t iPhi = 0; iPhi < binwPhiS; ++iPhi) {
-              binPhiS = binPhi_proj + (iPhi - binhwPhiS);
-              if (binPhiS < 0) {
-                continue;
-              }
-
-              binIndex2S = getBinIndex(binRS, binPhiS);
-              mBinsS[layer1][layer2 - 1][binIndex1].emplace_back(binIndex2S);
-            }
-          }
-
-          int binR, binPhi;
-
-          int binwR = mLTFinterBinWin;
-          int binhwR = binwR / 2;
-
-          int binwPhi = mLTFinterBinWin;
-          int binhwPhi = binwPhi / 2;
-
-          for (Int_t iR = 0; iR < binwR; ++iR) {
-            binR = binR_proj + (iR - binhwR);
-            if (binR < 0) {
-              continue;
-            }
-
-            for (Int_t iPhi = 0; iPhi < binwPhi; ++iPhi) {
-              binPhi = binPhi_proj + (iPhi - binhwPhi);
-              if (binPhi < 0) {
-                continue;
-              }
+  mRoad.initialize();
+}
 
-              binIndex2 = getBinIndex(binR, binPhi);
-              mBins[layer1][layer2 - 1][binIndex1].emplace_back(binIndex2);
-            }
-          }
+//_________________________________________________________________________________________________
+void Tracker::initialize(const Tracker& tracker)
+{
+  /// share the read-only Look-Up-Tables of the tracker initialized with the same binning and search windows
 
-        } // end loop layer2
-      }   // end loop PhiBinIndex
-    }     // end loop RBinIndex
-  }       // end loop layer1
+  if (!tracker.mBinsS || !tracker.mBins || tracker.mBinsS->getNRPhiBins() != mRPhiBins ||
+      tracker.mBinsS->getBinWindow() != mLTFseed2BinWin || tracker.mBins->getBinWindow() != mLTFinterBinWin) {
+    LOG(WARN) << "R-Phi projection tables of the source tracker do not match the configuration, building new ones";
+    initialize();
+    return;
+  }
+  mBinsS = tracker.mBinsS;
+  mBins = tracker.mBins;
 
   mRoad.initialize();
 }
@@ -242,7 +177,7 @@ void Tracker::findTracksLTF(ROframe& event)
       clsInLayer1 = it1 - event.getClustersInLayer(layer1).begin();
 
       // loop over the bins in the search window
-      for (auto& binS : mBinsS[layer1][layer2 - 1][cluster1.indexTableBin]) {
+      for (auto& binS : mBinsS->getBins(layer1, layer2, cluster1.indexTableBin)) {
 
         getBinClusterRange(event, layer2, binS, clsMinIndexS, clsMaxIndexS);
 
@@ -268,7 +203,7 @@ void Tracker::findTracksLTF(ROframe& event)
 
             // loop over the bins in the search window
             dR2min = dR2cut;
-            for (auto& bin : mBins[layer1][layer - 1][cluster1.indexTableBin]) {
+            for (auto& bin : mBins->getBins(layer1, layer, cluster1.indexTableBin)) {
 
               getBinClusterRange(event, layer, bin, clsMinIndex, clsMaxIndex);
 
@@ -381,7 +316,7 @@ void Tracker::findTracksCA(ROframe& event)
         clsInLayer1 = it1 - event.getClustersInLayer(layer1).begin();
 
         // loop over the bins in the search window
-        for (auto& binS : mBinsS[layer1][layer2 - 1][cluster1.indexTableBin]) {
+        for (auto& binS : mBinsS->getBins(layer1, layer2, cluster1.indexTableBin)) {
 
           getBinClusterRange(event, layer2, binS, clsMinIndexS, clsMaxIndexS);
 
@@ -401,7 +336,7 @@ void Tracker::findTracksCA(ROframe& event)
             for (Int_t layer = (layer1 + 1); layer <= (layer2 - 1); ++layer) {
 
               // loop over the bins in the search window
-              for (auto& bin : mBins[layer1][layer - 1][cluster1.indexTableBin]) {
+              for (auto& bin : mBins->getBins(layer1, layer, cluster1.indexTableBin)) {
 
                 getBinClusterRange(event, layer, bin, clsMinIndex, clsMaxIndex);
 
@@ -453,7 +388,8 @@ void Tracker::findTracksCA(ROframe& event)
             for (Int_t point = 0; point < nPoints; ++point) {
               auto layer = roadPoints[point].layer;
               auto clsInLayer = roadPoints[point].idInLayer;
-              mRoad.setPoint(layer, clsInLayer);
+              const Cluster& cluster = event.getClustersInLayer(layer)[clsInLayer];
+              mRoad.setPoint(layer, clsInLayer, cluster.getX(), cluster.getY(), cluster.getZ());
             }
             mRoad.setRoadId(roadId);
             ++roadId;
@@ -474,8 +410,6 @@ void Tracker::computeCellsInRoad(ROframe& event)
 {
   Int_t layer1, layer1min, layer1max, layer2, layer2min, layer2max;
   Int_t nPtsInLayer1, nPtsInLayer2;
-  Int_t clsInLayer1, clsInLayer2;
-  Int_t cellId;
   Bool_t noCell;
 
   mRoad.getLength(layer1min, layer1max);
@@ -483,8 +417,6 @@ void Tracker::computeCellsInRoad(ROframe& event)
 
   for (layer1 = layer1min; layer1 <= layer1max; ++layer1) {
 
-    cellId = 0;
-
     layer2min = layer1 + 1;
     layer2max = std::min(layer1 + (constants::mft::DisksNumber - isDiskFace(layer1)), constants::mft::LayersNumber - 1);
 
@@ -492,26 +424,18 @@ void Tracker::computeCellsInRoad(ROframe& event)
 
     for (Int_t point1 = 0; point1 < nPtsInLayer1; ++point1) {
 
-      clsInLayer1 = mRoad.getClustersIdInLayer(layer1)[point1];
-
       layer2 = layer2min;
 
       noCell = kTRUE;
       while (noCell && (layer2 <= layer2max)) {
 
         nPtsInLayer2 = mRoad.getNPointsInLayer(layer2);
-        /*
-        if (nPtsInLayer2 > 1) {
-          LOG(INFO) << "BV===== more than one point in road " << mRoad.getRoadId() << " in layer " << layer2 << " : " << nPtsInLayer2 << "\n";
-        }
-	*/
-        for (Int_t point2 = 0; point2 < nPtsInLayer2; ++point2) {
 
-          clsInLayer2 = mRoad.getClustersIdInLayer(layer2)[point2];
+        for (Int_t point2 = 0; point2 < nPtsInLayer2; ++point2) {
 
           noCell = kFALSE;
           // create a cell
-          addCellToCurrentRoad(event, layer1, layer2, clsInLayer1, clsInLayer2, cellId);
+          mRoad.addCellInLayer(layer1, layer2, point1, point2);
         } // end points in layer2
         ++layer2;
 
@@ -523,7 +447,7 @@ void Tracker::computeCellsInRoad(ROframe& event)
 //_________________________________________________________________________________________________
 void Tracker::runForwardInRoad()
 {
-  Int_t layerR, layerL, icellR, icellL;
+  Int_t layerR, layerL, icellR, icellL, nCellsR;
   Int_t iter = 0;
   Bool_t levelChange = kTRUE;
 
@@ -535,23 +459,23 @@ void Tracker::runForwardInRoad()
     // R = right, L = left
     for (layerL = 0; layerL < (constants::mft::LayersNumber - 2); ++layerL) {
 
-      for (icellL = 0; icellL < mRoad.getCellsInLayer(layerL).size(); ++icellL) {
-
-        Cell& cellL = mRoad.getCellsInLayer(layerL)[icellL];
+      for (icellL = 0; icellL < mRoad.getNCellsInLayer(layerL); ++icellL) {
 
-        layerR = cellL.getSecondLayerId();
+        layerR = mRoad.getCellSecondLayerId(layerL, icellL);
 
         if (layerR == (constants::mft::LayersNumber - 1)) {
           continue;
         }
 
-        for (icellR = 0; icellR < mRoad.getCellsInLayer(layerR).size(); ++icellR) {
-
-          Cell& cellR = mRoad.getCellsInLayer(layerR)[icellR];
+        // test all the cells of the right layer at once
+        if (!mRoad.findConnectedCells(layerL, icellL, layerR, mConnectedCells)) {
+          continue;
+        }
+        nCellsR = mConnectedCells.size();
+        for (icellR = 0; icellR < nCellsR; ++icellR) {
 
-          if ((cellL.getLevel() == cellR.getLevel()) && getCellsConnect(cellL, cellR)) {
+          if (mConnectedCells[icellR]) {
             if (iter == 1) {
-              mRoad.addRightNeighbourToCell(layerL, icellL, layerR, icellR);
               mRoad.addLeftNeighbourToCell(layerR, icellR, layerL, icellL);
             }
             mRoad.incrementCellLevel(layerR, icellR);
@@ -578,8 +502,9 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
   Int_t lastCellLayer, lastCellId, icell;
   Int_t cellId, layerC, cellIdC, layerRC, cellIdRC, layerL, cellIdL;
-  Int_t nPointDisks;
-  Float_t deviationPrev, deviation;
+  Int_t nPointDisks, nLeftNeighbours;
+  Float_t cosAnglePrev;
+  std::array<Float_t, constants::mft::MaxCellNeighbours> cosAngle;
 
   Int_t minLayer = 6;
   Int_t maxLayer = 8;
@@ -589,7 +514,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
   for (Int_t layer = maxLayer; layer >= minLayer; --layer) {
 
-    for (cellId = 0; cellId < mRoad.getCellsInLayer(layer).size(); ++cellId) {
+    for (cellId = 0; cellId < mRoad.getNCellsInLayer(layer); ++cellId) {
 
       if (mRoad.isCellUsed(layer, cellId) || (mRoad.getCellLevel(layer, cellId) < (mMinTrackPointsCA - 1))) {
         continue;
@@ -609,30 +534,32 @@ void Tracker::runBackwardInRoad(ROframe& event)
         layerRC = trackCells[nCells - 1].layer;
         cellIdRC = trackCells[nCells - 1].idInLayer;
 
-        const Cell& cellRC = mRoad.getCellsInLayer(layerRC)[cellIdRC];
-
         addCellToNewTrack = kFALSE;
 
+        // directions of all left neighbours w.r.t. the current cell, the smallest deviation angle
+        // corresponds to the largest cosine, no angle needs to be computed
+        nLeftNeighbours = mRoad.getCellNLeftNeighbours(layerRC, cellIdRC);
+        for (Int_t iLN = 0; iLN < nLeftNeighbours; ++iLN) {
+          const auto& leftNeighbour = mRoad.getCellLeftNeighbour(layerRC, cellIdRC, iLN);
+          cosAngle[iLN] = mRoad.getCellsCosAngle(leftNeighbour.first, leftNeighbour.second, layerRC, cellIdRC);
+        }
+
         // loop over left neighbours
-        deviationPrev = o2::constants::math::TwoPI;
+        cosAnglePrev = constants::mft::MinCellCosAngle;
 
-        for (Int_t iLN = 0; iLN < cellRC.getNLeftNeighbours(); ++iLN) {
+        for (Int_t iLN = 0; iLN < nLeftNeighbours; ++iLN) {
 
-          auto leftNeighbour = cellRC.getLeftNeighbours()[iLN];
+          const auto& leftNeighbour = mRoad.getCellLeftNeighbour(layerRC, cellIdRC, iLN);
           layerL = leftNeighbour.first;
           cellIdL = leftNeighbour.second;
 
-          const Cell& cellL = mRoad.getCellsInLayer(layerL)[cellIdL];
-
           if (mRoad.isCellUsed(layerL, cellIdL) || (mRoad.getCellLevel(layerL, cellIdL) != (mRoad.getCellLevel(layerRC, cellIdRC) - 1))) {
             continue;
           }
 
-          deviation = getCellDeviation(cellL, cellRC);
+          if (cosAngle[iLN] > cosAnglePrev) {
 
-          if (deviation < deviationPrev) {
-
-            deviationPrev = deviation;
+            cosAnglePrev = cosAngle[iLN];
 
             if (iLN > 0) {
               // delete the last added cell
@@ -656,8 +583,7 @@ void Tracker::runBackwardInRoad(ROframe& event)
 
       layerC = trackCells[0].layer;
       cellIdC = trackCells[0].idInLayer;
-      const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
-      hasDisk[cellC.getSecondLayerId() / 2] = kTRUE;
+      hasDisk[mRoad.getCellSecondLayerId(layerC, cellIdC) / 2] = kTRUE;
       for (icell = 0; icell < nCells; ++icell) {
         layerC = trackCells[icell].layer;
         cellIdC = trackCells[icell].idInLayer;
@@ -683,9 +609,8 @@ void Tracker::runBackwardInRoad(ROframe& event)
         addCellToCurrentTrackCA(layerC, cellIdC, event);
         mRoad.setCellUsed(layerC, cellIdC, kTRUE);
         // marked the used clusters
-        const Cell& cellC = mRoad.getCellsInLayer(layerC)[cellIdC];
-        event.getClustersInLayer(cellC.getFirstLayerId())[cellC.getFirstClusterIndex()].setUsed(true);
-        event.getClustersInLayer(cellC.getSecondLayerId())[cellC.getSecondClusterIndex()].setUsed(true);
+        event.getClustersInLayer(layerC)[mRoad.getCellFirstClusterIndex(layerC, cellIdC)].setUsed(true);
+        event.getClustersInLayer(mRoad.getCellSecondLayerId(layerC, cellIdC))[mRoad.getCellSecondClusterIndex(layerC, cellIdC)].setUsed(true);
       }
     } // end loop cells
   }   // end loop start layer
@@ -697,41 +622,20 @@ void Tracker::updateCellStatusInRoad()
   Int_t layerMin, layerMax;
   mRoad.getLength(layerMin, layerMax);
   for (Int_t layer = layerMin; layer < layerMax; ++layer) {
-    for (Int_t icell = 0; icell < mRoad.getCellsInLayer(layer).size(); ++icell) {
+    for (Int_t icell = 0; icell < mRoad.getNCellsInLayer(layer); ++icell) {
       mRoad.updateCellLevel(layer, icell);
       mMaxCellLevel = std::max(mMaxCellLevel, mRoad.getCellLevel(layer, icell));
     }
   }
 }
 
-//_________________________________________________________________________________________________
-void Tracker::addCellToCurrentRoad(ROframe& event, const Int_t layer1, const Int_t layer2, const Int_t clsInLayer1, const Int_t clsInLayer2, Int_t& cellId)
-{
-  Cell& cell = mRoad.addCellInLayer(layer1, layer2, clsInLayer1, clsInLayer2, cellId);
-
-  Cluster& cluster1 = event.getClustersInLayer(layer1)[clsInLayer1];
-  Cluster& cluster2 = event.getClustersInLayer(layer2)[clsInLayer2];
-
-  Float_t coord[6];
-  coord[0] = cluster1.getX();
-  coord[1] = cluster1.getY();
-  coord[2] = cluster1.getZ();
-  coord[3] = cluster2.getX();
-  coord[4] = cluster2.getY();
-  coord[5] = cluster2.getZ();
-
-  cell.setCoordinates(coord);
-  cellId++;
-}
-
 //_________________________________________________________________________________________________
 void Tracker::addCellToCurrentTrackCA(const Int_t layer1, const Int_t cellId, ROframe& event)
 {
   TrackCA& trackCA = event.getCurrentTrackCA();
-  const Cell& cell = mRoad.getCellsInLayer(layer1)[cellId];
-  const Int_t layer2 = cell.getSecondLayerId();
-  const Int_t clsInLayer1 = cell.getFirstClusterIndex();
-  const Int_t clsInLayer2 = cell.getSecondClusterIndex();
+  const Int_t layer2 = mRoad.getCellSecondLayerId(layer1, cellId);
+  const Int_t clsInLayer1 = mRoad.getCellFirstClusterIndex(layer1, cellId);
+  const Int_t clsInLayer2 = mRoad.getCellSecondClusterIndex(layer1, cellId);
 
   Cluster& cluster1 = event.getClustersInLayer(layer1)[clsInLayer1];
   Cluster& cluster2 = event.getClustersInLayer(layer2)[clsInLayer2];
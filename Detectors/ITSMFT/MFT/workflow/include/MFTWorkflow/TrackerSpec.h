@@ -14,6 +14,7 @@
 #define O2_MFT_TRACKERDPL_H_
 
 #include "MFTTracking/Tracker.h"
+#include "MFTTracking/ROframe.h"
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
@@ -37,9 +38,11 @@ class TrackerDPL : public o2::framework::Task
 
  private:
   bool mUseMC = false;
+  int mNThreads = 1;
   o2::itsmft::TopologyDictionary mDict;
   std::unique_ptr<o2::parameters::GRPObject> mGRP = nullptr;
-  std::unique_ptr<o2::mft::Tracker> mTracker = nullptr;
+  std::vector<std::unique_ptr<o2::mft::Tracker>> mTrackers; // one tracker (with its own fitter) per thread
+  std::vector<std::unique_ptr<o2::mft::ROframe>> mROFrames; // one working RO frame per thread
   TStopwatch mTimer;
 };
 
@@ -23,6 +23,10 @@
 
 #include "TGeoGlobalMagField.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #include "Framework/ControlService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "DataFormatsITSMFT/CompCluster.h"
@@ -47,6 +51,11 @@ void TrackerDPL::init(InitContext& ic)
   mTimer.Stop();
   mTimer.Reset();
   auto filename = ic.options().get<std::string>("grp-file");
+#ifdef WITH_OPENMP
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#else
+  mNThreads = 1;
+#endif
   const auto grp = o2::parameters::GRPObject::loadFrom(filename.c_str());
   if (grp) {
     mGRP.reset(grp);
@@ -56,16 +65,27 @@ void TrackerDPL::init(InitContext& ic)
     o2::base::GeometryManager::loadGeometry();
     o2::mft::GeometryTGeo* geom = o2::mft::GeometryTGeo::Instance();
     geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L, o2::math_utils::TransformType::T2GRot,
-                                                   o2::math_utils::TransformType::T2G));
+                                                   o2::math_utils::TransformType::T2G, o2::math_utils::TransformType::L2G));
 
     // tracking configuration parameters
     auto& mftTrackingParam = MFTTrackingParam::Instance();
-    // create the tracker: set the B-field, the configuration and initialize
-    mTracker = std::make_unique<o2::mft::Tracker>(mUseMC);
+    // create the trackers: set the B-field, the configuration and initialize
+    // each thread gets its own tracker and RO frame, since both keep the per-ROF working state
     double centerMFT[3] = {0, 0, -61.4}; // Field at center of MFT
-    mTracker->setBz(field->getBz(centerMFT));
-    mTracker->initConfig(mftTrackingParam, true);
-    mTracker->initialize();
+    auto bz = field->getBz(centerMFT);
+    mTrackers.clear();
+    mROFrames.clear();
+    for (int ith = 0; ith < mNThreads; ith++) {
+      auto& tracker = mTrackers.emplace_back(std::make_unique<o2::mft::Tracker>(mUseMC));
+      tracker->setBz(bz);
+      tracker->initConfig(mftTrackingParam, ith == 0);
+      if (ith == 0) {
+        tracker->initialize();
+      } else { // the R-Phi look-up tables are read-only, build them once
+        tracker->initialize(*mTrackers.front());
+      }
+      mROFrames.emplace_back(std::make_unique<o2::mft::ROframe>(0));
+    }
   } else {
     throw std::runtime_error(o2::utils::Str::concat_string("Cannot retrieve GRP from the ", filename));
   }
@@ -109,20 +129,14 @@ void TrackerDPL::run(ProcessingContext& pc)
 
   //std::vector<o2::mft::TrackMFTExt> tracks;
   auto& allClusIdx = pc.outputs().make<std::vector<int>>(Output{"MFT", "TRACKCLSID", 0, Lifetime::Timeframe});
-  std::vector<o2::MCCompLabel> trackLabels;
   std::vector<o2::MCCompLabel> allTrackLabels;
-  std::vector<o2::mft::TrackLTF> tracksLTF;
-  std::vector<o2::mft::TrackCA> tracksCA;
   auto& allTracksMFT = pc.outputs().make<std::vector<o2::mft::TrackMFT>>(Output{"MFT", "TRACKS", 0, Lifetime::Timeframe});
 
-  std::uint32_t roFrame = 0;
-  o2::mft::ROframe event(0);
-
   Bool_t continuous = mGRP->isDetContinuousReadOut("MFT");
   LOG(INFO) << "MFTTracker RO: continuous=" << continuous;
 
   // snippet to convert found tracks to final output tracks with separate cluster indices
-  auto copyTracks = [&event](auto& tracks, auto& allTracks, auto& allClusIdx) {
+  auto copyTracks = [](auto& tracks, auto& allTracks, auto& allClusIdx) {
     for (auto& trc : tracks) {
       trc.setExternalClusterIndexOffset(allClusIdx.size());
       int ncl = trc.getNumberOfPoints();
@@ -134,39 +148,79 @@ void TrackerDPL::run(ProcessingContext& pc)
     }
   };
 
-  gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
   if (continuous) {
-    for (auto& rof : rofs) {
-      int nclUsed = ioutils::loadROFrameData(rof, event, compClusters, pattIt, mDict, labels, mTracker.get());
-      if (nclUsed) {
-        event.setROFrameId(roFrame);
-        event.initialize();
-        LOG(INFO) << "ROframe: " << roFrame << ", clusters loaded : " << nclUsed;
-        mTracker->setROFrame(roFrame);
-        mTracker->clustersToTracks(event);
-        tracksLTF.swap(event.getTracksLTF());
-        tracksCA.swap(event.getTracksCA());
-        nTracksLTF += tracksLTF.size();
-        nTracksCA += tracksCA.size();
+    // the patterns are stored sequentially for all ROFs: find the 1st pattern of every ROF beforehand
+    // so that the ROFs can be loaded independently
+    int nROFs = rofs.size();
+    std::vector<gsl::span<const unsigned char>::iterator> rofPattIt(nROFs);
+    gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
+    for (int irof = 0; irof < nROFs; irof++) {
+      rofPattIt[irof] = pattIt;
+      ioutils::skipROFramePatterns(rofs[irof], compClusters, pattIt, mDict);
+    }
 
+    // tracks found in every ROF, kept until the ROF-ordered output is filled
+    struct ROFTracks {
+      int nclUsed = 0;
+      std::vector<o2::mft::TrackLTF> tracksLTF;
+      std::vector<o2::mft::TrackCA> tracksCA;
+      std::vector<o2::MCCompLabel> trackLabels;
+    };
+    std::vector<ROFTracks> rofTracks(nROFs);
+
+    int nThreads = std::min(mNThreads, std::max(1, nROFs));
+#ifdef WITH_OPENMP
+    omp_set_num_threads(nThreads);
+#pragma omp parallel for schedule(dynamic)
+#endif
+    //>> start of MT region
+    for (int irof = 0; irof < nROFs; irof++) {
+#ifdef WITH_OPENMP
+      auto ith = omp_get_thread_num();
+#else
+      auto ith = 0;
+#endif
+      auto& tracker = *mTrackers[ith];
+      auto& event = *mROFrames[ith];
+      auto& out = rofTracks[irof];
+      auto rofPatt = rofPattIt[irof];
+      out.nclUsed = ioutils::loadROFrameData(rofs[irof], event, compClusters, rofPatt, mDict, labels, &tracker);
+      if (out.nclUsed) {
+        event.setROFrameId(irof);
+        event.initialize();
+        tracker.setROFrame(irof);
+        tracker.clustersToTracks(event);
+        out.tracksLTF.swap(event.getTracksLTF());
+        out.tracksCA.swap(event.getTracksCA());
         if (mUseMC) {
-          mTracker->computeTracksMClabels(tracksLTF);
-          mTracker->computeTracksMClabels(tracksCA);
-          trackLabels.swap(mTracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
+          tracker.computeTracksMClabels(out.tracksLTF);
+          tracker.computeTracksMClabels(out.tracksCA);
+          out.trackLabels.swap(tracker.getTrackLabels());
         }
+      }
+    }
+    //<< end of MT region
 
-        LOG(INFO) << "Found tracks LTF: " << tracksLTF.size();
-        LOG(INFO) << "Found tracks CA: " << tracksCA.size();
-        int first = allTracksMFT.size();
-        int number = tracksLTF.size() + tracksCA.size();
-        rof.setFirstEntry(first);
-        rof.setNEntries(number);
-        copyTracks(tracksLTF, allTracksMFT, allClusIdx);
-        copyTracks(tracksCA, allTracksMFT, allClusIdx);
+    // fill the output in the ROF order
+    for (int irof = 0; irof < nROFs; irof++) {
+      auto& out = rofTracks[irof];
+      if (!out.nclUsed) {
+        continue;
+      }
+      LOG(INFO) << "ROframe: " << irof << ", clusters loaded : " << out.nclUsed;
+      LOG(INFO) << "Found tracks LTF: " << out.tracksLTF.size();
+      LOG(INFO) << "Found tracks CA: " << out.tracksCA.size();
+      nTracksLTF += out.tracksLTF.size();
+      nTracksCA += out.tracksCA.size();
+      if (mUseMC) {
+        std::copy(out.trackLabels.begin(), out.trackLabels.end(), std::back_inserter(allTrackLabels));
       }
-      roFrame++;
+      int first = allTracksMFT.size();
+      int number = out.tracksLTF.size() + out.tracksCA.size();
+      rofs[irof].setFirstEntry(first);
+      rofs[irof].setNEntries(number);
+      copyTracks(out.tracksLTF, allTracksMFT, allClusIdx);
+      copyTracks(out.tracksCA, allTracksMFT, allClusIdx);
     }
   }
 
@@ -213,7 +267,8 @@ DataProcessorSpec getTrackerSpec(bool useMC)
     AlgorithmSpec{adaptFromTask<TrackerDPL>(useMC)},
     Options{
       {"grp-file", VariantType::String, "o2sim_grp.root", {"Name of the output file"}},
-      {"mft-dictionary-path", VariantType::String, "", {"Path of the cluster-topology dictionary file"}}}};
+      {"mft-dictionary-path", VariantType::String, "", {"Path of the cluster-topology dictionary file"}},
+      {"nthreads", VariantType::Int, 1, {"Number of tracking threads, independent ROFs are processed concurrently"}}}};
 }
 
 } // namespace mft
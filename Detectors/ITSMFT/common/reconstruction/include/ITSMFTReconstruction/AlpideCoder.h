@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 #include "PayLoadCont.h"
 #include <map>
+#include <array>
 #include <fmt/format.h>
 
 #include "ITSMFTReconstruction/PixelData.h"
@@ -109,6 +110,33 @@ class AlpideCoder
   static constexpr int Error = -1;     // flag for decoding error
   static constexpr int EOFFlag = -100; // flag for EOF in reading
 
+  // actions of the table-driven decoder, see decodeChipTable
+  enum ByteAction : uint8_t { ActUnknown,     // unknown word: error
+                              ActChipEmpty,   // CHIP_EMPTY
+                              ActChipHeader,  // CHIP_HEADER
+                              ActChipTrailer, // CHIP_TRAILER
+                              ActRegion,      // REGION_HEADER
+                              ActData,        // 1st byte of DATASHORT or DATALONG
+                              ActNoData,      // data was expected but not found: error
+                              ActBusyOn,      // BUSY_ON
+                              ActBusyOff,     // BUSY_OFF
+                              ActPadding };   // 0 padding: end of the cable data
+
+  // decoder states, i.e. possible combinations of expected records
+  enum DecoderState : uint8_t { StateChipHeaderOrEmpty, // ExpectChipHeader | ExpectChipEmpty
+                                StateRegion,            // ExpectRegion
+                                StateData,              // ExpectData
+                                StateDataRegionTrailer, // ExpectChipTrailer | ExpectData | ExpectRegion
+                                NDecoderStates };
+
+  /// hits produced by DATASHORT/DATALONG record, as row offsets wrt the row of the record address:
+  /// 1st nLeft entries are in the left column of the double column, the rest in the right one
+  struct HitMapExpansion {
+    uint8_t nLeft = 0;
+    uint8_t nHits = 0;
+    std::array<uint8_t, HitMapSize + 1> rowOffset{};
+  };
+
   AlpideCoder() = default;
   ~AlpideCoder() = default;
 
@@ -305,6 +333,191 @@ class AlpideCoder
     return chipData.getData().size();
   }
 
+  /// decode alpide data for the next non-empty chip from the buffer using the decoder selected by setUseTableDecoder
+  template <class T, typename CG>
+  static int decodeChipSelected(ChipPixelData& chipData, T& buffer, CG cidGetter)
+  {
+    return mUseTableDecoder ? decodeChipTable(chipData, buffer, cidGetter) : decodeChip(chipData, buffer, cidGetter);
+  }
+
+  /// select decoder to be used by decodeChipSelected
+  static void setUseTableDecoder(bool v) { mUseTableDecoder = v; }
+  static bool getUseTableDecoder() { return mUseTableDecoder; }
+
+  /// table-driven version of decodeChip, must produce exactly the same output (hits, flags, errors, buffer position).
+  /// The payload is accessed directly via the buffer pointers, the record type is obtained from the per-state byte action
+  /// table, the hits of the DATASHORT/DATALONG records are expanded from the tables precomputed for every hit map
+  template <class T, typename CG>
+  static int decodeChipTable(ChipPixelData& chipData, T& buffer, CG cidGetter)
+  {
+    uint8_t* ptr = buffer.getPtr();
+    const uint8_t* const end = buffer.getEnd();
+    uint16_t region = 0;
+    //
+    int nRightCHits = 0;               // counter for the hits in the right column of the current double column
+    std::uint16_t rightColHits[NRows]; // buffer for the accumulation of hits in the right column
+    std::uint16_t colDPrev = 0xffff;   // previously processed double column (to dected change of the double column)
+
+    uint8_t state = StateChipHeaderOrEmpty; // data must always start with chip header or chip empty flag
+
+    chipData.clear();
+
+    while (ptr < end) {
+      uint8_t dataC = *ptr++;
+      switch (mByteActions[state][dataC]) {
+
+        case ActChipEmpty:
+          chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
+          if (ptr == end) {
+            buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::TruncatedChipEmpty);
+#endif
+            return unexpectedEOF("CHIP_EMPTY:Timestamp");
+          }
+          ptr++; // skip timestamp
+          state = StateChipHeaderOrEmpty;
+          continue;
+
+        case ActChipHeader:
+          chipData.setChipID(cidGetter(dataC & MaskChipID)); // here we set the global chip ID
+          if (ptr == end) {
+            buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::TruncatedChipHeader);
+#endif
+            return unexpectedEOF("CHIP_HEADER");
+          }
+          ptr++; // skip timestamp
+          state = StateRegion;
+          continue;
+
+        case ActRegion:
+          region = dataC & MaskRegion;
+          state = StateData;
+          continue;
+
+        case ActChipTrailer: {
+          state = StateChipHeaderOrEmpty;
+          chipData.setROFlags(dataC & MaskROFlags);
+#ifdef ALPIDE_DECODING_STAT
+          uint8_t roErr = dataC & MaskROFlags;
+          if (roErr) {
+            if (roErr == MaskErrBusyViolation) {
+              chipData.setError(ChipStat::BusyViolation);
+            } else if (roErr == MaskErrDataOverrun) {
+              chipData.setError(ChipStat::DataOverrun);
+            } else if (roErr == MaskErrFatal) {
+              chipData.setError(ChipStat::Fatal);
+            }
+          }
+#endif
+          // in case there are entries in the "right" columns buffer, add them to the container
+          if (nRightCHits) {
+            colDPrev++;
+            for (int ihr = 0; ihr < nRightCHits; ihr++) {
+              addHit(chipData, rightColHits[ihr], colDPrev);
+            }
+          }
+          if (!chipData.getData().size() && !chipData.isErrorSet()) {
+            nRightCHits = 0;
+            colDPrev = 0xffff;
+            chipData.clear();
+            continue;
+          }
+          buffer.setPtr(ptr);
+          return chipData.getData().size();
+        }
+
+        case ActData: {
+          bool truncated = ptr == end;
+          uint16_t dataS = (uint16_t(dataC) << 8) | (truncated ? 0 : *ptr++);
+          uint16_t dColID = (dataS & MaskEncoder) >> 10;
+          uint16_t pixID = dataS & MaskPixID;
+          uint16_t row = pixID >> 1;
+          uint16_t colD = (region * NDColInReg + dColID) << 1; // abs id of left column in double column
+          uint8_t hitsPattern = 0;
+          if (truncated) {
+            buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::TruncatedRegion);
+#endif
+            return unexpectedEOF("CHIPDATA");
+          }
+          // if we start new double column, transfer the hits accumulated in the right column buffer of prev. double column
+          if (colD != colDPrev) {
+            colDPrev++;
+            for (int ihr = 0; ihr < nRightCHits; ihr++) {
+              addHit(chipData, rightColHits[ihr], colDPrev);
+            }
+            colDPrev = colD;
+            nRightCHits = 0; // reset the buffer
+          }
+          if ((dataS & (~MaskDColID)) == DATALONG) { // multiple hits ?
+            if (ptr == end) {
+              truncated = true; // the hit of the record address is still stored
+            } else {
+              hitsPattern = *ptr++;
+#ifdef ALPIDE_DECODING_STAT
+              if (hitsPattern & (~MaskHitMap)) {
+                chipData.setError(ChipStat::WrongDataLongPattern);
+              }
+#endif
+            }
+          }
+          const auto& hits = mHitMapExpansions[pixID & 0x3][hitsPattern & MaskHitMap];
+          for (int ih = 0; ih < hits.nLeft; ih++) { // left column hits are added directly to the container
+            addHit(chipData, row + hits.rowOffset[ih], colD);
+          }
+          for (int ih = hits.nLeft; ih < hits.nHits; ih++) { // right column hits are buffered until the double column is over
+            rightColHits[nRightCHits++] = row + hits.rowOffset[ih];
+          }
+          if (truncated) {
+            buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+            chipData.setError(ChipStat::TruncatedLondData);
+#endif
+            return unexpectedEOF("CHIP_DATA_LONG:Pattern");
+          }
+          state = StateDataRegionTrailer;
+          continue; // end of DATA(SHORT or LONG) processing
+        }
+
+        case ActNoData:
+          buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+          chipData.setError(ChipStat::NoDataFound);
+#endif
+          return unexpectedEOF(fmt::format("Expected DataShort or DataLong mask, got {:x}", int(dataC)));
+
+        case ActBusyOn:
+#ifdef ALPIDE_DECODING_STAT
+          chipData.setError(ChipStat::BusyOn);
+#endif
+          continue;
+
+        case ActBusyOff:
+#ifdef ALPIDE_DECODING_STAT
+          chipData.setError(ChipStat::BusyOff);
+#endif
+          continue;
+
+        case ActPadding:
+          buffer.clear(); // 0 padding reached (end of the cable data), no point in continuing
+          return chipData.getData().size();
+
+        default:
+          buffer.setPtr(ptr);
+#ifdef ALPIDE_DECODING_STAT
+          chipData.setError(ChipStat::UnknownWord);
+#endif
+          return unexpectedEOF(fmt::format("Unknown word 0x{:x} [decoder state = {:d}]", int(dataC), int(state))); // error
+      }
+    }
+    buffer.setPtr(ptr);
+    return chipData.getData().size();
+  }
+
   /// check if the byte corresponds to chip_header or chip_empty flag
   static bool isChipHeaderOrEmpty(uint8_t v)
   {
@@ -424,6 +637,15 @@ class AlpideCoder
   //
 
   static const NoiseMap* mNoisyPixels;
+  static bool mUseTableDecoder; // use decodeChipTable in decodeChipSelected
+
+  // tables for the decodeChipTable
+  using ByteActionsTable = std::array<std::array<uint8_t, 256>, NDecoderStates>;
+  using HitMapExpansionsTable = std::array<std::array<HitMapExpansion, MaskHitMap + 1>, 4>;
+  static ByteActionsTable buildByteActions();
+  static HitMapExpansionsTable buildHitMapExpansions();
+  static const ByteActionsTable mByteActions;           // action for every byte in every decoder state
+  static const HitMapExpansionsTable mHitMapExpansions; // hits for 2 lowest bits of the address and the hit map
 
   // cluster map used for the ENCODING only
   std::vector<int> mFirstInRow;     //! entry of 1st pixel of each non-empty row in the mPix2Encode
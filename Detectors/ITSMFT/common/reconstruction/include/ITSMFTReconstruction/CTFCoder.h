@@ -16,6 +16,7 @@
 #define O2_ITSMFT_CTFCODER_H
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <string>
 #include "DataFormatsITSMFT/CTF.h"
@@ -48,11 +49,22 @@ class CTFCoder : public o2::ctf::CTFCoderBase
 
   void createCoders(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op);
 
+  /// number of threads used to encode/decode the blocks concurrently
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
  private:
+  using BlockBuffers = std::array<std::vector<o2::ctf::BufferType>, CTF::getNBlocks()>;
   /// compres compact clusters to CompressedClusters
   void compress(CompressedClusters& cc, const gsl::span<const ROFRecord>& rofRecVec, const gsl::span<const CompClusterExt>& cclusVec, const gsl::span<const unsigned char>& pattVec);
   size_t estimateCompressedSize(const CompressedClusters& cc);
 
+  /// encode each block of CompressedClusters to its own scratch container, concurrently
+  void encodeBlocksMT(const CompressedClusters& cc, const o2::ctf::Metadata::OptStore* optField, BlockBuffers& blockBuffs);
+
+  /// decode all blocks concurrently
+  void decodeBlocksMT(const CTF::base& ec, CompressedClusters& cc);
+
   /// decompress CompressedClusters to compact clusters
   template <typename VROF, typename VCLUS, typename VPAT>
   void decompress(const CompressedClusters& cc, VROF& rofRecVec, VCLUS& cclusVec, VPAT& pattVec);
@@ -60,6 +72,8 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void appendToTree(TTree& tree, CTF& ec);
   void readFromTree(TTree& tree, int entry, std::vector<ROFRecord>& rofRecVec, std::vector<CompClusterExt>& cclusVec, std::vector<unsigned char>& pattVec);
 
+  int mNThreads = 1; // number of threads for blocks encoding/decoding
+
  protected:
   ClassDefNV(CTFCoder, 1);
 };
@@ -84,6 +98,24 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const ROFRecord>& rofRecVec, co
   };
   CompressedClusters cc;
   compress(cc, rofRecVec, cclusVec, pattVec);
+
+  if (mNThreads > 1) { // encode blocks concurrently to scratch containers, then assemble them in the slots order
+    BlockBuffers blockBuffs;
+    encodeBlocksMT(cc, optField, blockBuffs);
+    size_t szTot = CTF::getMinAlignedSize();
+    for (const auto& bb : blockBuffs) {
+      szTot += CTF::estimateBlockSize(CTF::get(bb.data())->getBlock(0).getNStored());
+    }
+    buff.resize(szTot / sizeof(typename VEC::value_type) + 1); // book the exact size, with margin for the free space check
+    auto ec = CTF::create(buff);
+    ec->setHeader(cc.header);
+    ec->setANSHeader(o2::ctf::ANSVersionInterleaved);
+    for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+      CTF::get(buff.data())->copyBlock(*CTF::get(blockBuffs[ib].data()), 0, ib, &buff);
+    }
+    CTF::get(buff.data())->print(getPrefix());
+    return;
+  }
   // book output size with some margin
   auto szIni = estimateCompressedSize(cc);
   buff.resize(szIni);
@@ -92,8 +124,7 @@ void CTFCoder::encode(VEC& buff, const gsl::span<const ROFRecord>& rofRecVec, co
   using ECB = CTF::base;
 
   ec->setHeader(cc.header);
-  ec->getANSHeader().majorVersion = 0;
-  ec->getANSHeader().minorVersion = 1;
+  ec->setANSHeader(o2::ctf::ANSVersionInterleaved);
   // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
 #define ENCODEITSMFT(part, slot, bits) CTF::get(buff.data())->encode(part, int(slot), bits, optField[int(slot)], &buff, mCoders[int(slot)].get());
   // clang-format off
@@ -119,6 +150,11 @@ void CTFCoder::decode(const CTF::base& ec, VROF& rofRecVec, VCLUS& cclusVec, VPA
   CompressedClusters cc;
   cc.header = ec.getHeader();
   ec.print(getPrefix());
+  if (mNThreads > 1) {
+    decodeBlocksMT(ec, cc);
+    decompress(cc, rofRecVec, cclusVec, pattVec);
+    return;
+  }
 #define DECODEITSMFT(part, slot) ec.decode(part, int(slot), mCoders[int(slot)].get())
   // clang-format off
   DECODEITSMFT(cc.firstChipROF, CTF::BLCfirstChipROF);
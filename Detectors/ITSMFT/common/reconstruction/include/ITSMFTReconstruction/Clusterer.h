@@ -146,6 +146,8 @@ class Clusterer
                                  PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPTr);
     void process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
                  const ConstMCTruth* labelsDigPtr, MCTruth* labelsClPtr, const ROFRecord& rofPtr);
+    void processChip(ChipPixelData* curChipData, const o2::InteractionRecord& ir, CompClusCont* compClusPtr, PatternCont* patternsPtr,
+                     const ConstMCTruth* labelsDigPtr, MCTruth* labelsClPtr);
 
     ClustererThread(Clusterer* par = nullptr) : parent(par), curr(column2 + 1), prev(column1 + 1)
     {
@@ -163,6 +165,12 @@ class Clusterer
 
   void process(int nThreads, PixelReader& r, CompClusCont* compClus, PatternCont* patterns, ROFRecCont* vecROFRec, MCTruth* labelsCl = nullptr);
 
+  // methods for the clustering fused with the raw data decoding: the decoder clusters every chip right after
+  // its decoding, in the decoding thread, the clusters of all threads are merged at the end of the ROF
+  void prepareThreads(int nThreads, bool withPatterns);
+  void processDecodedChips(int ith, ChipPixelData* chips, int nChips);
+  void finishDecodedROF(const o2::InteractionRecord& ir, CompClusCont* compClus, PatternCont* patterns, ROFRecCont* vecROFRec);
+
   bool isContinuousReadOut() const { return mContinuousReadout; }
   void setContinuousReadOut(bool v) { mContinuousReadout = v; }
 
@@ -219,6 +227,8 @@ class Clusterer
   std::vector<ChipPixelData> mChips;                      // currently processed ROF's chips data
   std::vector<ChipPixelData> mChipsOld;                   // previously processed ROF's chips data (for masking)
   std::vector<ChipPixelData*> mFiredChipsPtr;             // pointers on the fired chips data in the decoder cache
+  std::vector<std::pair<uint16_t, uint16_t>> mDecodedBlocks; // thread and stat entry of the chips clustered in the fused mode
+  bool mDecodedWithPatterns = true;                          // store patterns in the fused mode
 
   LookUp mPattIdConverter; //! Convert the cluster topology to the corresponding entry in the dictionary.
 
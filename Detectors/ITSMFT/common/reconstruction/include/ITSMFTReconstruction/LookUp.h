@@ -22,6 +22,7 @@
 #ifndef ALICEO2_ITSMFT_LOOKUP_H
 #define ALICEO2_ITSMFT_LOOKUP_H
 #include <array>
+#include <vector>
 #include "DataFormatsITSMFT/ClusterTopology.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 
@@ -35,16 +36,32 @@ class LookUp
   LookUp();
   LookUp(std::string fileName);
   static int groupFinder(int nRow, int nCol);
-  int findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]);
+  int findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const;
+  /// reference lookup in the dictionary maps, used to build the tables of findGroupID
+  int findGroupIDSlow(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const;
   int getTopologiesOverThreshold() { return mTopologiesOverThreshold; }
   void loadDictionary(std::string fileName);
   bool isGroup(int id) const;
   int size() const { return mDictionary.getSize(); }
 
  private:
+  static constexpr int MaxSmallSpan = 3;                                           ///< max row/col span of topologies in the direct-index table
+  static constexpr int SmallPatternBits = MaxSmallSpan * MaxSmallSpan;             ///< max number of bits of topologies in the direct-index table
+  static constexpr int SmallPatternLUTSize = SmallPatternBits << SmallPatternBits; ///< 1 slice of 2^SmallPatternBits entries per (nRow,nCol)
+
+  void buildLookUpTables();
+  int findCommonID(unsigned long hash) const;
+  static unsigned int hashSlot(unsigned long hash) { return (unsigned int)((hash ^ (hash >> 29)) * 0x9E3779B97F4A7C15UL >> 32); }
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
 
+  std::vector<int> mSmallPatternIDs;                                 //! IDs of all topologies with nRow,nCol<=MaxSmallSpan, indexed by span and pixels bitmask
+  std::vector<unsigned long> mHashKeys;                              //! open-addressed hash table of the common topologies: hashes
+  std::vector<int> mHashIDs;                                         //! and corresponding IDs, -1 for empty slots
+  unsigned int mHashMask = 0;                                        //! size of the hash table - 1
+  std::array<int, TopologyDictionary::NumberOfRareGroups> mGroupIDs; //! IDs of the groups of rare topologies
+
   ClassDefNV(LookUp, 3);
 };
 } // namespace itsmft
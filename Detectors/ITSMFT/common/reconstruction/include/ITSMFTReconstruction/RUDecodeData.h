@@ -80,7 +80,7 @@ int RUDecodeData::decodeROF(const Mapping& mp)
     auto chIdGetter = [this, &mp, cabHW](int cid) {
       return mp.getGlobalChipID(cid, cabHW, *this->ruInfo);
     };
-    while (AlpideCoder::decodeChip(*chipData, cableData[icab], chIdGetter) || chipData->isErrorSet()) { // we register only chips with hits or errors flags set
+    while (AlpideCoder::decodeChipSelected(*chipData, cableData[icab], chIdGetter) || chipData->isErrorSet()) { // we register only chips with hits or errors flags set
       setROFInfo(chipData, cableLinkPtr[icab]);
       ntot += chipData->getData().size();
 #ifdef ALPIDE_DECODING_STAT
@@ -13,6 +13,7 @@
 #ifndef ALICEO2_ITSMFT_RAWPIXELDECODER_H_
 #define ALICEO2_ITSMFT_RAWPIXELDECODER_H_
 
+#include <algorithm>
 #include <array>
 #include <TStopwatch.h>
 #include "Framework/Logger.h"
@@ -38,6 +39,7 @@ class InputRecord;
 namespace itsmft
 {
 class ChipPixelData;
+class Clusterer;
 
 template <class Mapping>
 class RawPixelDecoder final : public PixelReader
@@ -60,6 +62,9 @@ class RawPixelDecoder final : public PixelReader
   int decodeNextTrigger() final;
   int decodeNextTrigger(int il);
 
+  int decodeTF();
+  int decodeTF(int iru);
+
   template <class DigitContainer, class ROFContainer>
   int fillDecodedDigits(DigitContainer& digits, ROFContainer& rofs);
 
@@ -79,6 +84,14 @@ class RawPixelDecoder final : public PixelReader
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
 
+  void setDecodeWholeTF(bool v) { mDecodeWholeTF = v; }
+  bool getDecodeWholeTF() const { return mDecodeWholeTF; }
+
+  /// if the clusterer is set, the chips are clusterized by the decoding threads right after decoding, see Clusterer::processDecodedChips.
+  /// The clusterer must have been prepared via Clusterer::prepareThreads for the same number of threads
+  void setClusterer(Clusterer* c) { mClusterer = c; }
+  Clusterer* getClusterer() const { return mClusterer; }
+
   void setFillCalibData(bool v) { mFillCalibData = v; }
   bool getFillCalibData() const { return mFillCalibData; }
 
@@ -96,32 +109,96 @@ class RawPixelDecoder final : public PixelReader
   uint32_t getNPixelsFiredROF() const { return mNPixelsFiredROF; }
   size_t getNChipsFired() const { return mNChipsFired; }
   size_t getNPixelsFired() const { return mNPixelsFired; }
+  size_t getNROFsUnordered() const { return mNROFsUnordered; }
+  size_t getNROFsSkipped() const { return mNROFsSkipped; }
 
   struct LinkEntry {
     int entry = -1;
   };
 
+  /// ROF decoded by single RU in the whole-TF decoding mode
+  struct RUROFEntry {
+    o2::InteractionRecord ir;   // interaction record of the trigger
+    o2::InteractionRecord irHB; // interaction record of the HB
+    uint32_t trigger = 0;       // trigger word
+    GBTCalibData calibData{};   // calibration info from GBT calibration word
+    int nLinks = 0;             // number of links of the RU which had data for this ROF
+    int firstChip = 0;          // 1st chip of this ROF in the RUTFData::chipsData
+    int nChips = 0;             // number of fired chips in this ROF
+  };
+
+  /// chip data decoded by single RU for all triggers of the TF
+  struct RUTFData {
+    std::vector<ChipPixelData> chipsData; // pool of decoded chips, 1st nChipsFired are used
+    std::vector<RUROFEntry> rofs;         // ROFs decoded by the RU, referring to chipsData
+    int nChipsFired = 0;                  // number of chips in use
+    int nextROF = 0;                      // next ROF to be provided by decodeNextTrigger
+    int nROFsUnordered = 0;               // number of ROFs received out of IR order
+    void clear()
+    {
+      rofs.clear();
+      nChipsFired = 0;
+      nextROF = 0;
+      nROFsUnordered = 0;
+    }
+    /// put the ROFs in increasing IR order, return the number of ROFs which were out of order
+    int sortROFs()
+    {
+      nROFsUnordered = 0;
+      for (size_t i = 1; i < rofs.size(); i++) {
+        if (rofs[i].ir < rofs[i - 1].ir) {
+          nROFsUnordered++;
+        }
+      }
+      if (nROFsUnordered) { // ROFs refer to the chips pool by index, so they can be reordered alone
+        std::stable_sort(rofs.begin(), rofs.end(), [](const RUROFEntry& a, const RUROFEntry& b) { return a.ir < b.ir; });
+      }
+      return nROFsUnordered;
+    }
+    /// return the next ROF if it has the requested IR, otherwise nullptr. ROFs with smaller IR (repeated IRs of
+    /// already provided ROFs) cannot be provided anymore and are skipped, their number is added to nSkipped
+    const RUROFEntry* nextROFForIR(const o2::InteractionRecord& ir, int& nSkipped)
+    {
+      while (nextROF < int(rofs.size()) && rofs[nextROF].ir < ir) {
+        nextROF++;
+        nSkipped++;
+      }
+      if (nextROF == int(rofs.size()) || rofs[nextROF].ir != ir) {
+        return nullptr;
+      }
+      return &rofs[nextROF++];
+    }
+  };
+
  private:
   void setupLinks(o2::framework::InputRecord& inputs);
+  int stageNextTFTrigger();
   int getRUEntrySW(int ruSW) const { return mRUEntry[ruSW]; }
   RUDecodeData* getRUDecode(int ruSW) { return &mRUDecodeVec[mRUEntry[ruSW]]; }
   GBTLink* getGBTLink(int i) { return i < 0 ? nullptr : &mGBTLinks[i]; }
   RUDecodeData& getCreateRUDecode(int ruSW);
 
   static constexpr uint16_t NORUDECODED = 0xffff; // this must be > than max N RUs
+  static constexpr int MaxROFErrorsReported = 10;  // max number of reports on skipped ROFs
 
   std::vector<GBTLink> mGBTLinks;                           // active links pool
   std::unordered_map<uint32_t, LinkEntry> mSubsSpec2LinkID; // link subspec to link entry in the pool mapping
   std::vector<RUDecodeData> mRUDecodeVec;                   // set of active RUs
   std::array<short, Mapping::getNRUs()> mRUEntry;           // entry of the RU with given SW ID in the mRUDecodeVec
   std::vector<ChipPixelData*> mOrderedChipsPtr;             // special ordering helper used for the MFT (its chipID is not contiguous in RU)
+  std::vector<RUTFData> mRUTFData;                          // whole-TF decoding buffers, in the same order as mRUDecodeVec
+  std::vector<o2::InteractionRecord> mTFIRs;                // sorted IRs of all ROFs decoded in the whole-TF mode
   std::string mSelfName;                        // self name
   header::DataOrigin mUserDataOrigin = o2::header::gDataOriginInvalid; // alternative user-provided data origin to pick
   header::DataDescription mUserDataDescription = o2::header::gDataDescriptionInvalid; // alternative user-provided description to pick
   uint16_t mCurRUDecodeID = NORUDECODED;        // index of currently processed RUDecode container
   int mLastReadChipID = -1;                     // chip ID returned by previous getNextChipData call, used for ordering checks
   Mapping mMAP;                                 // chip mapping
+  Clusterer* mClusterer = nullptr;              // optional clusterer for the fused decoding+clustering
   bool mFillCalibData = false;                  // request to fill calib data from GBT
+  bool mDecodeWholeTF = false;                  // decode every RU for the whole TF at once rather than trigger by trigger
+  bool mTFDecoded = false;                      // in the whole-TF mode, flag that the current TF was already decoded
+  int mTFROFCounter = 0;                        // in the whole-TF mode, next entry of mTFIRs to provide
   int mVerbosity = 0;
   int mNThreads = 1; // number of decoding threads
   GBTLink::Format mFormat = GBTLink::NewFormat; // ITS Data Format (old: 1 ROF per CRU page)
@@ -132,6 +209,9 @@ class RawPixelDecoder final : public PixelReader
   uint32_t mNLinksDone = 0;                       // number of links reached end of data
   size_t mNChipsFired = 0;                        // global counter
   size_t mNPixelsFired = 0;                       // global counter
+  size_t mNROFsUnordered = 0;                     // global counter of ROFs reordered in the whole-TF mode
+  size_t mNROFsSkipped = 0;                       // global counter of ROFs skipped in the whole-TF mode due to repeated IR
+  int mNROFErrorsReported = 0;                    // number of reports on skipped ROFs
   TStopwatch mTimerTFStart;
   TStopwatch mTimerDecode;
   TStopwatch mTimerFetchData;
@@ -16,6 +16,76 @@
 using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
+bool AlpideCoder::mUseTableDecoder = false;
+const AlpideCoder::ByteActionsTable AlpideCoder::mByteActions = AlpideCoder::buildByteActions();
+const AlpideCoder::HitMapExpansionsTable AlpideCoder::mHitMapExpansions = AlpideCoder::buildHitMapExpansions();
+
+//_____________________________________
+AlpideCoder::ByteActionsTable AlpideCoder::buildByteActions()
+{
+  // define the action of the decodeChipTable for every byte in every state,
+  // reproducing the order of checks done in the decodeChip
+  ByteActionsTable table{};
+  const uint32_t expectations[NDecoderStates] = {ExpectChipHeader | ExpectChipEmpty, ExpectRegion, ExpectData,
+                                                 ExpectChipTrailer | ExpectData | ExpectRegion};
+  for (int st = 0; st < NDecoderStates; st++) {
+    auto expectInp = expectations[st];
+    for (int b = 0; b < 256; b++) {
+      uint8_t dataC = b, dataCM = dataC & (~MaskChipID);
+      uint8_t act = ActUnknown;
+      if ((expectInp & ExpectChipEmpty) && dataCM == CHIPEMPTY) {
+        act = ActChipEmpty;
+      } else if ((expectInp & ExpectChipHeader) && dataCM == CHIPHEADER) {
+        act = ActChipHeader;
+      } else if ((expectInp & ExpectRegion) && (dataC & REGION) == REGION) {
+        act = ActRegion;
+      } else if ((expectInp & ExpectChipTrailer) && dataCM == CHIPTRAILER) {
+        act = ActChipTrailer;
+      } else if (expectInp & ExpectData) {
+        act = isData(dataC) ? ActData : ActNoData;
+      } else if (dataC == BUSYON) {
+        act = ActBusyOn;
+      } else if (dataC == BUSYOFF) {
+        act = ActBusyOff;
+      } else if (!dataC) {
+        act = ActPadding;
+      }
+      table[st][b] = act;
+    }
+  }
+  return table;
+}
+
+//_____________________________________
+AlpideCoder::HitMapExpansionsTable AlpideCoder::buildHitMapExpansions()
+{
+  // for every combination of 2 lowest bits of the pixel address and of the DATALONG hit map define the
+  // hits of the record (the hit of the record address itself included) as row offsets wrt the row of the address,
+  // separately for the left and right columns, in the order of increasing address
+  HitMapExpansionsTable table{};
+  for (int addrL = 0; addrL < 4; addrL++) {
+    for (int hmap = 0; hmap <= MaskHitMap; hmap++) {
+      auto& hits = table[addrL][hmap];
+      uint32_t mask = (hmap << 1) | 0x1;
+      for (int side = 0; side < 2; side++) { // left column hits first, then right column ones
+        for (int ip = 0; ip <= HitMapSize; ip++) {
+          if (!(mask & (0x1 << ip))) {
+            continue;
+          }
+          int addr = addrL + ip, rowE = addr >> 1;
+          bool rightC = (rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1); // true for right column / false for left
+          if (int(rightC) == side) {
+            hits.rowOffset[hits.nHits++] = rowE - (addrL >> 1); // offset wrt the row of the record address
+          }
+        }
+        if (!side) {
+          hits.nLeft = hits.nHits;
+        }
+      }
+    }
+  }
+  return table;
+}
 
 //_____________________________________
 void AlpideCoder::print() const
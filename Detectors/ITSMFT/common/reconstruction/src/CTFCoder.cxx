@@ -16,6 +16,10 @@
 #include "CommonUtils/StringUtils.h"
 #include <TTree.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::itsmft;
 
 ///___________________________________________________________________________________
@@ -186,3 +190,68 @@ size_t CTFCoder::estimateCompressedSize(const CompressedClusters& cc)
   LOG(INFO) << "Estimated output size is " << sz << " bytes";
   return sz;
 }
+
+///________________________________
+void CTFCoder::encodeBlocksMT(const CompressedClusters& cc, const o2::ctf::Metadata::OptStore* optField, BlockBuffers& blockBuffs)
+{
+  // every block is encoded to the slot 0 of its own container, to be copied later to the final one
+#define ENCODEITSMFTMT(part, slot, bits)                                                                                                  \
+  case int(slot):                                                                                                                         \
+    CTF::create(blockBuffs[int(slot)])->setANSHeader(o2::ctf::ANSVersionInterleaved);                                                     \
+    CTF::get(blockBuffs[int(slot)].data())->encode(part, 0, bits, optField[int(slot)], &blockBuffs[int(slot)], mCoders[int(slot)].get()); \
+    break;
+#ifdef WITH_OPENMP
+  omp_set_num_threads(std::min(mNThreads, CTF::getNBlocks()));
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+    switch (ib) {
+      // clang-format off
+      ENCODEITSMFTMT(cc.firstChipROF, CTF::BLCfirstChipROF, 0);
+      ENCODEITSMFTMT(cc.bcIncROF, CTF::BLCbcIncROF, 0);
+      ENCODEITSMFTMT(cc.orbitIncROF, CTF::BLCorbitIncROF, 0);
+      ENCODEITSMFTMT(cc.nclusROF, CTF::BLCnclusROF, 0);
+      //
+      ENCODEITSMFTMT(cc.chipInc, CTF::BLCchipInc, 0);
+      ENCODEITSMFTMT(cc.chipMul, CTF::BLCchipMul, 0);
+      ENCODEITSMFTMT(cc.row, CTF::BLCrow, 0);
+      ENCODEITSMFTMT(cc.colInc, CTF::BLCcolInc, 0);
+      ENCODEITSMFTMT(cc.pattID, CTF::BLCpattID, 0);
+      ENCODEITSMFTMT(cc.pattMap, CTF::BLCpattMap, 0);
+      // clang-format on
+    }
+  }
+#undef ENCODEITSMFTMT
+}
+
+///________________________________
+void CTFCoder::decodeBlocksMT(const CTF::base& ec, CompressedClusters& cc)
+{
+  // blocks are independent and decoded to separate vectors
+#define DECODEITSMFTMT(part, slot)                         \
+  case int(slot):                                          \
+    ec.decode(part, int(slot), mCoders[int(slot)].get()); \
+    break;
+#ifdef WITH_OPENMP
+  omp_set_num_threads(std::min(mNThreads, CTF::getNBlocks()));
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int ib = 0; ib < CTF::getNBlocks(); ib++) {
+    switch (ib) {
+      // clang-format off
+      DECODEITSMFTMT(cc.firstChipROF, CTF::BLCfirstChipROF);
+      DECODEITSMFTMT(cc.bcIncROF,     CTF::BLCbcIncROF);
+      DECODEITSMFTMT(cc.orbitIncROF,  CTF::BLCorbitIncROF);
+      DECODEITSMFTMT(cc.nclusROF,     CTF::BLCnclusROF);
+      //
+      DECODEITSMFTMT(cc.chipInc,      CTF::BLCchipInc);
+      DECODEITSMFTMT(cc.chipMul,      CTF::BLCchipMul);
+      DECODEITSMFTMT(cc.row,          CTF::BLCrow);
+      DECODEITSMFTMT(cc.colInc,       CTF::BLCcolInc);
+      DECODEITSMFTMT(cc.pattID,       CTF::BLCpattID);
+      DECODEITSMFTMT(cc.pattMap,      CTF::BLCpattMap);
+      // clang-format on
+    }
+  }
+#undef DECODEITSMFTMT
+}
@@ -154,6 +154,75 @@ void Clusterer::process(int nThreads, PixelReader& reader, CompClusCont* compClu
 #endif
 }
 
+//__________________________________________________
+void Clusterer::prepareThreads(int nThreads, bool withPatterns)
+{
+  // make sure the buffers are available for nThreads threads before the fused decoding+clustering starts
+  if (nThreads > mThreads.size()) {
+    int oldSz = mThreads.size();
+    mThreads.resize(nThreads);
+    for (int i = oldSz; i < nThreads; i++) {
+      mThreads[i] = std::make_unique<ClustererThread>(this);
+    }
+  }
+  mDecodedWithPatterns = withPatterns;
+}
+
+//__________________________________________________
+void Clusterer::processDecodedChips(int ith, ChipPixelData* chips, int nChips)
+{
+  // cluster chips decoded by the thread ith, while their data is still in the cache.
+  // The output of each chip is registered as a separate block, to be merged in chip ID order
+  auto& thr = *mThreads[ith];
+  for (int ic = 0; ic < nChips; ic++) {
+    auto& chip = chips[ic];
+    auto& stat = thr.stats.emplace_back(ThreadStat{chip.getChipID(), 1, uint32_t(thr.compClusters.size()), uint32_t(thr.patterns.size()), 0, 0});
+    thr.processChip(&chip, chip.getInteractionRecord(), &thr.compClusters, mDecodedWithPatterns ? &thr.patterns : nullptr, nullptr, nullptr);
+    stat.nClus = thr.compClusters.size() - stat.firstClus;
+    stat.nPatt = thr.patterns.size() - stat.firstPatt;
+  }
+}
+
+//__________________________________________________
+void Clusterer::finishDecodedROF(const o2::InteractionRecord& ir, CompClusCont* compClus, PatternCont* patterns, ROFRecCont* vecROFRec)
+{
+  // concatenate clusters of all threads of the fused decoding+clustering in chip ID order, as a new ROF
+  auto& rof = vecROFRec->emplace_back(ir, 0, compClus->size(), 0); // create new ROF
+  mDecodedBlocks.clear();
+  size_t nClTot = 0, nPattTot = 0;
+  for (int ith = 0; ith < mThreads.size(); ith++) {
+    const auto& thr = *mThreads[ith];
+    for (int is = 0; is < thr.stats.size(); is++) {
+      mDecodedBlocks.emplace_back(ith, is);
+    }
+    nClTot += thr.compClusters.size();
+    nPattTot += thr.patterns.size();
+  }
+  std::sort(mDecodedBlocks.begin(), mDecodedBlocks.end(), [this](const std::pair<uint16_t, uint16_t>& a, const std::pair<uint16_t, uint16_t>& b) {
+    return mThreads[a.first]->stats[a.second].firstChip < mThreads[b.first]->stats[b.second].firstChip;
+  });
+  compClus->reserve(compClus->size() + nClTot);
+  if (patterns) {
+    patterns->reserve(patterns->size() + nPattTot);
+  }
+  for (const auto& blk : mDecodedBlocks) {
+    const auto& thr = *mThreads[blk.first];
+    const auto& stat = thr.stats[blk.second];
+    const auto clbeg = thr.compClusters.begin() + stat.firstClus;
+    compClus->insert(compClus->end(), clbeg, clbeg + stat.nClus);
+    if (patterns) {
+      const auto ptbeg = thr.patterns.begin() + stat.firstPatt;
+      patterns->insert(patterns->end(), ptbeg, ptbeg + stat.nPatt);
+    }
+  }
+  for (auto& thr : mThreads) {
+    thr->patterns.clear();
+    thr->compClusters.clear();
+    thr->stats.clear();
+  }
+  rof.setNEntries(compClus->size() - rof.getFirstEntry());
+}
+
 //__________________________________________________
 void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
                                          const ConstMCTruth* labelsDigPtr, MCTruth* labelsClPtr, const ROFRecord& rofPtr)
@@ -163,33 +232,7 @@ void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClu
   }
 
   for (int ic = 0; ic < nChips; ic++) {
-    auto* curChipData = parent->mFiredChipsPtr[chip + ic];
-    auto chipID = curChipData->getChipID();
-    if (parent->mMaxBCSeparationToMask > 0) { // mask pixels fired from the previous ROF
-      const auto& chipInPrevROF = parent->mChipsOld[chipID];
-      if (std::abs(rofPtr.getBCData().differenceInBC(chipInPrevROF.getInteractionRecord())) < parent->mMaxBCSeparationToMask) {
-        parent->mMaxRowColDiffToMask ? curChipData->maskFiredInSample(parent->mChipsOld[chipID], parent->mMaxRowColDiffToMask) : curChipData->maskFiredInSample(parent->mChipsOld[chipID]);
-      }
-    }
-    auto validPixID = curChipData->getFirstUnmasked();
-    auto npix = curChipData->getData().size();
-    if (validPixID < npix) { // chip data may have all of its pixels masked!
-      auto valp = validPixID++;
-      if (validPixID == npix) { // special case of a single pixel fired on the chip
-        finishChipSingleHitFast(valp, curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
-      } else {
-        initChip(curChipData, valp);
-        for (; validPixID < npix; validPixID++) {
-          if (!curChipData->getData()[validPixID].isMasked()) {
-            updateChip(curChipData, validPixID);
-          }
-        }
-        finishChip(curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
-      }
-    }
-    if (parent->mMaxBCSeparationToMask > 0) { // current chip data will be used in the next ROF to mask overflow pixels
-      parent->mChipsOld[chipID].swap(*curChipData);
-    }
+    processChip(parent->mFiredChipsPtr[chip + ic], rofPtr.getBCData(), compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
   }
   auto& currStat = stats.back();
   currStat.nChips += nChips;
@@ -197,6 +240,38 @@ void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClu
   currStat.nPatt = patternsPtr ? (patternsPtr->size() - currStat.firstPatt) : 0;
 }
 
+//__________________________________________________
+void Clusterer::ClustererThread::processChip(ChipPixelData* curChipData, const o2::InteractionRecord& ir, CompClusCont* compClusPtr, PatternCont* patternsPtr,
+                                             const ConstMCTruth* labelsDigPtr, MCTruth* labelsClPtr)
+{
+  auto chipID = curChipData->getChipID();
+  if (parent->mMaxBCSeparationToMask > 0) { // mask pixels fired from the previous ROF
+    const auto& chipInPrevROF = parent->mChipsOld[chipID];
+    if (std::abs(ir.differenceInBC(chipInPrevROF.getInteractionRecord())) < parent->mMaxBCSeparationToMask) {
+      parent->mMaxRowColDiffToMask ? curChipData->maskFiredInSample(parent->mChipsOld[chipID], parent->mMaxRowColDiffToMask) : curChipData->maskFiredInSample(parent->mChipsOld[chipID]);
+    }
+  }
+  auto validPixID = curChipData->getFirstUnmasked();
+  auto npix = curChipData->getData().size();
+  if (validPixID < npix) { // chip data may have all of its pixels masked!
+    auto valp = validPixID++;
+    if (validPixID == npix) { // special case of a single pixel fired on the chip
+      finishChipSingleHitFast(valp, curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
+    } else {
+      initChip(curChipData, valp);
+      for (; validPixID < npix; validPixID++) {
+        if (!curChipData->getData()[validPixID].isMasked()) {
+          updateChip(curChipData, validPixID);
+        }
+      }
+      finishChip(curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
+    }
+  }
+  if (parent->mMaxBCSeparationToMask > 0) { // current chip data will be used in the next ROF to mask overflow pixels
+    parent->mChipsOld[chipID].swap(*curChipData);
+  }
+}
+
 //__________________________________________________
 void Clusterer::ClustererThread::finishChip(ChipPixelData* curChipData, CompClusCont* compClusPtr,
                                             PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPtr)
@@ -24,7 +24,10 @@ namespace o2
 namespace itsmft
 {
 
-LookUp::LookUp() : mDictionary{}, mTopologiesOverThreshold{0} {}
+LookUp::LookUp() : mDictionary{}, mTopologiesOverThreshold{0}
+{
+  buildLookUpTables();
+}
 
 LookUp::LookUp(std::string fileName)
 {
@@ -35,6 +38,50 @@ void LookUp::loadDictionary(std::string fileName)
 {
   mDictionary.readBinaryFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildLookUpTables();
+}
+
+void LookUp::buildLookUpTables()
+{
+  // fill the flat tables used by findGroupID from the dictionary maps
+  for (int i = 0; i < TopologyDictionary::NumberOfRareGroups; i++) {
+    auto it = mDictionary.mGroupMap.find(i);
+    mGroupIDs[i] = it != mDictionary.mGroupMap.end() ? it->second : 0;
+  }
+  // open-addressed hash table with linear probing, kept at most half full
+  unsigned int tableSize = 16;
+  while (tableSize < 2 * mDictionary.mCommonMap.size()) {
+    tableSize <<= 1;
+  }
+  mHashMask = tableSize - 1;
+  mHashKeys.clear();
+  mHashKeys.resize(tableSize, 0);
+  mHashIDs.clear();
+  mHashIDs.resize(tableSize, -1);
+  for (const auto& entry : mDictionary.mCommonMap) {
+    auto slot = hashSlot(entry.first) & mHashMask;
+    while (mHashIDs[slot] >= 0) {
+      slot = (slot + 1) & mHashMask;
+    }
+    mHashKeys[slot] = entry.first;
+    mHashIDs[slot] = entry.second;
+  }
+  // direct-index table of all possible topologies fitting in MaxSmallSpan x MaxSmallSpan
+  mSmallPatternIDs.clear();
+  mSmallPatternIDs.resize(SmallPatternLUTSize, 0);
+  unsigned char patt[ClusterPattern::MaxPatternBytes] = {0};
+  for (int nRow = 1; nRow <= MaxSmallSpan; nRow++) {
+    for (int nCol = 1; nCol <= MaxSmallSpan; nCol++) {
+      int nBits = nRow * nCol;
+      int offs = ((nRow - 1) * MaxSmallSpan + nCol - 1) << SmallPatternBits;
+      for (unsigned int bits = 1; bits < (1u << nBits); bits++) {
+        unsigned int pattWord = bits << (16 - nBits); // pattern bits are stored starting from the MSB of the 1st byte
+        patt[0] = pattWord >> 8;
+        patt[1] = pattWord & 0xff;
+        mSmallPatternIDs[offs + bits] = findGroupIDSlow(nRow, nCol, patt);
+      }
+    }
+  }
 }
 
 int LookUp::groupFinder(int nRow, int nCol)
@@ -56,8 +103,40 @@ int LookUp::groupFinder(int nRow, int nCol)
   return grNum;
 }
 
-int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes])
+int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const
+{
+  int nBits = nRow * nCol;
+  // Topology fitting in 3x3: direct lookup by its pixels bitmask
+  if (nRow <= MaxSmallSpan && nCol <= MaxSmallSpan) {
+    unsigned int pattWord = (((unsigned int)patt[0]) << 8) + (nBits > 8 ? patt[1] : 0);
+    return mSmallPatternIDs[(((nRow - 1) * MaxSmallSpan + nCol - 1) << SmallPatternBits) + (pattWord >> (16 - nBits))];
+  }
+  // Other small topology
+  if (nBits < 9) {
+    int ID = mDictionary.mSmallTopologiesLUT[(nCol - 1) * 255 + (int)patt[0]];
+    return ID >= 0 ? ID : mGroupIDs[groupFinder(nRow, nCol)]; // small rare topology (inside groups)
+  }
+  // Big topology
+  int ID = findCommonID(ClusterTopology::getCompleteHash(nRow, nCol, patt));
+  return ID >= 0 ? ID : mGroupIDs[groupFinder(nRow, nCol)]; // big rare topology (inside groups)
+}
+
+int LookUp::findCommonID(unsigned long hash) const
+{
+  // probe the open-addressed hash table, return -1 if the hash is not there
+  auto slot = hashSlot(hash) & mHashMask;
+  while (mHashIDs[slot] >= 0) {
+    if (mHashKeys[slot] == hash) {
+      return mHashIDs[slot];
+    }
+    slot = (slot + 1) & mHashMask;
+  }
+  return -1;
+}
+
+int LookUp::findGroupIDSlow(int nRow, int nCol, const unsigned char patt[ClusterPattern::MaxPatternBytes]) const
 {
+  // reference lookup in the dictionary maps, used to build the tables
   int nBits = nRow * nCol;
   // Small topology
   if (nBits < 9) {
@@ -65,8 +144,7 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     if (ID >= 0) {
       return ID;
     } else { //small rare topology (inside groups)
-      int index = groupFinder(nRow, nCol);
-      return mDictionary.mGroupMap[index];
+      return mGroupIDs[groupFinder(nRow, nCol)];
     }
   }
   // Big topology
@@ -75,8 +153,7 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
   if (ret != mDictionary.mCommonMap.end()) {
     return ret->second;
   } else { // Big rare topology (inside groups)
-    int index = groupFinder(nRow, nCol);
-    return mDictionary.mGroupMap[index];
+    return mGroupIDs[groupFinder(nRow, nCol)];
   }
 }
 
@@ -13,6 +13,7 @@
 
 #include "DetectorsRaw/RDHUtils.h"
 #include "ITSMFTReconstruction/RawPixelDecoder.h"
+#include "ITSMFTReconstruction/Clusterer.h"
 #include "DPLUtils/DPLRawParser.h"
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/StringUtils.h"
@@ -43,6 +44,9 @@ template <class Mapping>
 void RawPixelDecoder<Mapping>::printReport(bool decstat, bool skipNoErr) const
 {
   LOGF(INFO, "%s Decoded %zu hits in %zu non-empty chips in %u ROFs with %d threads", mSelfName, mNPixelsFired, mNChipsFired, mROFCounter, mNThreads);
+  if (mNROFsUnordered || mNROFsSkipped) {
+    LOGF(INFO, "%s Reordered %zu ROFs received out of IR order, skipped %zu ROFs with repeated IR", mSelfName, mNROFsUnordered, mNROFsSkipped);
+  }
   double cpu = 0, real = 0;
   auto& tmrS = const_cast<TStopwatch&>(mTimerTFStart);
   LOGF(INFO, "%s Timing Start TF:  CPU = %.3e Real = %.3e in %d slots", mSelfName, tmrS.CpuTime(), tmrS.RealTime(), tmrS.Counter() - 1);
@@ -78,6 +82,15 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
   mNPixelsFiredROF = 0;
   mInteractionRecord.clear();
   int nLinksWithData = 0, nru = mRUDecodeVec.size();
+  if (mDecodeWholeTF) {
+    if (!mTFDecoded) {
+      decodeTF();
+    }
+    nLinksWithData = stageNextTFTrigger();
+    ensureChipOrdering();
+    mTimerDecode.Stop();
+    return nLinksWithData;
+  }
   do {
 #ifdef WITH_OPENMP
     omp_set_num_threads(mNThreads);
@@ -92,6 +105,15 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
         npix += mRUDecodeVec[iru].chipsData[ic].getData().size();
       }
       mNPixelsFiredROF += npix;
+      if (mClusterer) { // clusterize the chips while they are still hot in the cache, they will not be provided by getNextChipData
+#ifdef WITH_OPENMP
+        int ith = omp_get_thread_num();
+#else
+        int ith = 0;
+#endif
+        mClusterer->processDecodedChips(ith, mRUDecodeVec[iru].chipsData.data(), mRUDecodeVec[iru].nChipsFired);
+        mRUDecodeVec[iru].lastChipChecked = mRUDecodeVec[iru].nChipsFired;
+      }
     }
 
     if (nLinksWithData) { // fill some statistics
@@ -132,6 +154,12 @@ void RawPixelDecoder<Mapping>::startNewTF(InputRecord& inputs)
   for (auto& ru : mRUDecodeVec) {
     ru.clear();
   }
+  for (auto& ruTF : mRUTFData) {
+    ruTF.clear();
+  }
+  mTFIRs.clear();
+  mTFROFCounter = 0;
+  mTFDecoded = false;
   setupLinks(inputs);
   mNLinksDone = 0;
   mTimerTFStart.Stop();
@@ -162,6 +190,145 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger(int iru)
   return ndec;
 }
 
+///______________________________________________________________
+/// Decode all triggers of the TF, every RU independently of others, return number of ROFs seen
+template <class Mapping>
+int RawPixelDecoder<Mapping>::decodeTF()
+{
+  int nru = mRUDecodeVec.size();
+  mRUTFData.resize(nru);
+#ifdef WITH_OPENMP
+  omp_set_num_threads(mNThreads);
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int iru = 0; iru < nru; iru++) {
+    decodeTF(iru);
+  }
+  // collect the ROFs seen by any RU in increasing IR order, they will be provided one by one by decodeNextTrigger
+  mTFIRs.clear();
+  for (const auto& ruTF : mRUTFData) {
+    mNROFsUnordered += ruTF.nROFsUnordered;
+    for (const auto& rof : ruTF.rofs) {
+      mTFIRs.push_back(rof.ir);
+    }
+  }
+  std::sort(mTFIRs.begin(), mTFIRs.end());
+  mTFIRs.erase(std::unique(mTFIRs.begin(), mTFIRs.end()), mTFIRs.end());
+  mTFROFCounter = 0;
+  mNLinksDone = mGBTLinks.size();
+  mTFDecoded = true;
+  return mTFIRs.size();
+}
+
+///______________________________________________________________
+/// Decode all triggers of the TF for given RU into its TF buffer, return number of decoded ROFs
+template <class Mapping>
+int RawPixelDecoder<Mapping>::decodeTF(int iru)
+{
+  auto& ru = mRUDecodeVec[iru];
+  auto& ruTF = mRUTFData[iru];
+  ruTF.clear();
+  uint32_t linksMask = 0, linksDone = 0;
+  for (int il = 0; il < RUDecodeData::MaxLinksPerRU; il++) {
+    if (getGBTLink(ru.links[il])) {
+      linksMask |= 0x1 << il;
+    }
+  }
+  while (linksDone != linksMask) {
+    ru.clear();
+    int ndec = 0; // number of yet non-empty links
+    const GBTLink* linkSeen = nullptr;
+    for (int il = 0; il < RUDecodeData::MaxLinksPerRU; il++) {
+      if (!(linksMask & (0x1 << il)) || (linksDone & (0x1 << il))) {
+        continue;
+      }
+      auto* link = getGBTLink(ru.links[il]);
+      auto res = link->collectROFCableData(mMAP);
+      if (res == GBTLink::DataSeen) { // at the moment process only DataSeen
+        if (!ndec++) {
+          linkSeen = link;
+        }
+      } else if (res == GBTLink::StoppedOnEndOfData || res == GBTLink::AbortedOnError) { // this link has exhausted its data or it has to be discarded due to the error
+        linksDone |= 0x1 << il;
+      }
+    }
+    if (!ndec) {
+      continue;
+    }
+    ru.decodeROF(mMAP);
+    auto& rof = ruTF.rofs.emplace_back();
+    rof.ir = linkSeen->ir;
+    rof.irHB = o2::raw::RDHUtils::getHeartBeatIR(*linkSeen->lastRDH);
+    rof.trigger = linkSeen->trigger;
+    rof.calibData = ru.calibData;
+    rof.nLinks = ndec;
+    rof.firstChip = ruTF.nChipsFired;
+    rof.nChips = ru.nChipsFired;
+    // move the decoded chips to the TF pool, recycling the pool buffers for the next ROF
+    if (ruTF.chipsData.size() < size_t(ruTF.nChipsFired + ru.nChipsFired)) {
+      ruTF.chipsData.resize(ruTF.nChipsFired + ru.nChipsFired);
+    }
+    for (int ic = 0; ic < ru.nChipsFired; ic++) {
+      ruTF.chipsData[ruTF.nChipsFired++].swap(ru.chipsData[ic]);
+    }
+  }
+  ru.clear();
+  ruTF.sortROFs(); // links may deliver ROFs out of IR order, they are provided by stageNextTFTrigger in IR order
+  return ruTF.rofs.size();
+}
+
+///______________________________________________________________
+/// Make the chips of the next ROF of the TF decoded in the whole-TF mode available in the RUs,
+/// return number of links with data
+template <class Mapping>
+int RawPixelDecoder<Mapping>::stageNextTFTrigger()
+{
+  if (mTFROFCounter >= int(mTFIRs.size())) {
+    return 0;
+  }
+  const auto& ir = mTFIRs[mTFROFCounter++];
+  int nLinksWithData = 0, nru = mRUDecodeVec.size();
+  for (int iru = 0; iru < nru; iru++) {
+    auto& ru = mRUDecodeVec[iru];
+    auto& ruTF = mRUTFData[iru];
+    ru.nChipsFired = 0;
+    ru.lastChipChecked = 0;
+    ru.calibData.clear();
+    int nSkipped = 0;
+    const auto* rofPtr = ruTF.nextROFForIR(ir, nSkipped);
+    if (nSkipped) {
+      mNROFsSkipped += nSkipped;
+      if (mNROFErrorsReported < MaxROFErrorsReported) {
+        LOG(ERROR) << mSelfName << " RU#" << ru.ruSWID << " skipped " << nSkipped << " ROF(s) with repeated IR preceding " << ir
+                   << (++mNROFErrorsReported == MaxROFErrorsReported ? ", further reports are suppressed" : "");
+      }
+    }
+    if (!rofPtr) {
+      continue; // this RU has no data for this ROF
+    }
+    const auto& rof = *rofPtr;
+    if (!nLinksWithData) { // set IR and trigger from the 1st non empty RU
+      mInteractionRecord = rof.ir;
+      mInteractionRecordHB = rof.irHB;
+      mTrigger = rof.trigger;
+    }
+    nLinksWithData += rof.nLinks;
+    ru.calibData = rof.calibData;
+    for (int ic = 0; ic < rof.nChips; ic++) {
+      auto& chip = ru.chipsData[ru.nChipsFired++];
+      chip.swap(ruTF.chipsData[rof.firstChip + ic]);
+      mNPixelsFiredROF += chip.getData().size();
+    }
+    mNChipsFiredROF += rof.nChips;
+  }
+  mROFCounter++;
+  mNChipsFired += mNChipsFiredROF;
+  mNPixelsFired += mNPixelsFiredROF;
+  mCurRUDecodeID = 0; // getNextChipData will start from here
+  mLastReadChipID = -1;
+  return nLinksWithData;
+}
+
 ///______________________________________________________________
 /// Setup links checking the very RDH of every input
 template <class Mapping>
@@ -0,0 +1,114 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <set>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+
+using namespace o2::itsmft;
+
+namespace
+{
+// encode nChips chips with random hits (clustered to produce DATALONG records), optionally corrupting the stream
+void fillPayload(PayLoadCont& buffer, std::mt19937& gen, int nChips, bool corrupt)
+{
+  AlpideCoder coder;
+  std::uniform_int_distribution<int> rowDist(0, AlpideCoder::NRows - 1), colDist(0, AlpideCoder::NCols - 1), nHitDist(0, 300), sizeDist(0, 4);
+  for (int ich = 0; ich < nChips; ich++) {
+    std::set<std::pair<int, int>> hits; // sorted in row, then col
+    int nSeeds = nHitDist(gen);
+    for (int is = 0; is < nSeeds; is++) {
+      int row = rowDist(gen), col = colDist(gen), dr = sizeDist(gen), dc = sizeDist(gen);
+      for (int r = row; r <= std::min(row + dr, AlpideCoder::NRows - 1); r++) {
+        for (int c = col; c <= std::min(col + dc, AlpideCoder::NCols - 1); c++) {
+          hits.emplace(r, c);
+        }
+      }
+    }
+    ChipPixelData chip;
+    for (const auto& h : hits) {
+      chip.getData().emplace_back(h.first, h.second);
+    }
+    buffer.ensureFreeCapacity(40 * (hits.size() + 1000));
+    coder.encodeChip(buffer, chip, ich & AlpideCoder::MaskChipID, ich * 8, ich % 3 ? 0 : 0x8);
+  }
+  if (corrupt) {
+    std::uniform_int_distribution<size_t> posDist(0, buffer.getSize() - 1);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    for (int i = 0; i < 20; i++) {
+      buffer[posDist(gen)] = byteDist(gen);
+    }
+  }
+  buffer.add(uint8_t(0)); // padding
+}
+
+// decode the buffer with the standard and table-driven decoders and compare the results
+void compareDecoders(const PayLoadCont& buffer)
+{
+  PayLoadCont bufStd(buffer), bufTab(buffer);
+  auto cidGetter = [](int cid) { return cid; };
+  ChipPixelData chipStd, chipTab;
+  while (true) {
+    int resStd = AlpideCoder::decodeChip(chipStd, bufStd, cidGetter);
+    int resTab = AlpideCoder::decodeChipTable(chipTab, bufTab, cidGetter);
+    BOOST_REQUIRE_EQUAL(resStd, resTab);
+    BOOST_REQUIRE_EQUAL(bufStd.getOffset(), bufTab.getOffset());
+    BOOST_REQUIRE_EQUAL(bufStd.getUnusedSize(), bufTab.getUnusedSize());
+    BOOST_REQUIRE_EQUAL(chipStd.getChipID(), chipTab.getChipID());
+    BOOST_REQUIRE_EQUAL(chipStd.getROFlags(), chipTab.getROFlags());
+    BOOST_REQUIRE_EQUAL(chipStd.getErrorFlags(), chipTab.getErrorFlags());
+    BOOST_REQUIRE_EQUAL(chipStd.getData().size(), chipTab.getData().size());
+    for (size_t i = 0; i < chipStd.getData().size(); i++) {
+      BOOST_REQUIRE_EQUAL(chipStd.getData()[i].getRow(), chipTab.getData()[i].getRow());
+      BOOST_REQUIRE_EQUAL(chipStd.getData()[i].getCol(), chipTab.getData()[i].getCol());
+    }
+    if (!resStd && !chipStd.isErrorSet()) {
+      break;
+    }
+    if (bufStd.isEmpty()) {
+      break;
+    }
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_TableDecoder)
+{
+  std::mt19937 gen(12345);
+  for (int iter = 0; iter < 20; iter++) {
+    PayLoadCont buffer;
+    fillPayload(buffer, gen, 10, false);
+    // check that the encoded hits are recovered
+    PayLoadCont bufTab(buffer);
+    ChipPixelData chip;
+    int nChips = 0;
+    while (AlpideCoder::decodeChipTable(chip, bufTab, [](int cid) { return cid; }) > 0) {
+      BOOST_CHECK(!chip.isErrorSet() || chip.getROFlags());
+      nChips++;
+    }
+    BOOST_CHECK(nChips > 0);
+    compareDecoders(buffer);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_TableDecoderCorrupted)
+{
+  std::mt19937 gen(54321);
+  for (int iter = 0; iter < 200; iter++) {
+    PayLoadCont buffer;
+    fillPayload(buffer, gen, 5, true);
+    compareDecoders(buffer);
+  }
+}
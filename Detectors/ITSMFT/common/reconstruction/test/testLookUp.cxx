@@ -0,0 +1,115 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test LookUp
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <array>
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/BuildTopologyDictionary.h"
+#include "ITSMFTReconstruction/LookUp.h"
+
+using namespace o2::itsmft;
+
+namespace
+{
+using Pattern = std::array<unsigned char, ClusterPattern::MaxPatternBytes>;
+
+struct Topology {
+  int nRow;
+  int nCol;
+  Pattern patt;
+};
+
+// random pattern of nRow x nCol pixels with at least 1 fired pixel, the bits beyond the last pixel are cleared
+Pattern randomPattern(std::mt19937& gen, int nRow, int nCol)
+{
+  std::uniform_int_distribution<int> byteDist(0, 255);
+  int nBits = nRow * nCol, nBytes = (nBits + 7) / 8;
+  Pattern patt{};
+  do {
+    for (int i = 0; i < nBytes; i++) {
+      patt[i] = byteDist(gen);
+    }
+    patt[nBytes - 1] &= 0xff << (nBytes * 8 - nBits);
+  } while (patt[0] == 0 && (nBytes == 1 || patt[1] == 0));
+  return patt;
+}
+
+// dictionary of common topologies of various sizes, the rest being grouped
+LookUp createLookUp(std::vector<Topology>& pool)
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> spanDist(1, 6), bigSpanDist(7, 20);
+  for (int i = 0; i < 400; i++) {
+    int nRow = i % 10 ? spanDist(gen) : bigSpanDist(gen), nCol = i % 7 ? spanDist(gen) : bigSpanDist(gen);
+    pool.push_back({nRow, nCol, randomPattern(gen, nRow, nCol)});
+  }
+  BuildTopologyDictionary builder;
+  for (size_t i = 0; i < pool.size(); i++) {
+    ClusterTopology topology(pool[i].nRow, pool[i].nCol, pool[i].patt.data());
+    for (size_t n = 2000 / (i + 1); n--;) { // falling frequency: the tail of the pool ends up in the groups
+      builder.accountTopology(topology);
+    }
+  }
+  builder.setThreshold(0.0005);
+  builder.groupRareTopologies();
+  builder.printDictionaryBinary("test_LookUp_dict.bin");
+  return LookUp("test_LookUp_dict.bin");
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(LookUpFastVsSlow)
+{
+  std::vector<Topology> pool;
+  const LookUp lookUp = createLookUp(pool);
+  BOOST_REQUIRE(lookUp.size() > 0);
+  int nGroups = 0;
+
+  // all topologies of the dictionary pool, common and rare
+  for (const auto& t : pool) {
+    int id = lookUp.findGroupID(t.nRow, t.nCol, t.patt.data());
+    BOOST_CHECK_EQUAL(id, lookUp.findGroupIDSlow(t.nRow, t.nCol, t.patt.data()));
+    nGroups += lookUp.isGroup(id);
+  }
+  BOOST_CHECK(nGroups > 0);
+
+  // every pattern which fits in 1 byte, including all those of the direct-index table of the spans up to 3x3
+  for (int nRow = 1; nRow <= 8; nRow++) {
+    for (int nCol = 1; nRow * nCol <= 8; nCol++) {
+      for (int bits = 1; bits < (1 << (nRow * nCol)); bits++) {
+        Pattern patt{};
+        patt[0] = bits << (8 - nRow * nCol);
+        BOOST_CHECK_EQUAL(lookUp.findGroupID(nRow, nCol, patt.data()), lookUp.findGroupIDSlow(nRow, nCol, patt.data()));
+      }
+    }
+  }
+
+  // every 9-bit pattern: the 3x3 ones go to the direct-index table, the others to the hash table
+  for (auto [nRow, nCol] : {std::pair{3, 3}, std::pair{1, 9}, std::pair{9, 1}}) {
+    for (int bits = 1; bits < (1 << 9); bits++) {
+      Pattern patt{};
+      patt[0] = bits >> 1;
+      patt[1] = (bits & 0x1) << 7;
+      BOOST_CHECK_EQUAL(lookUp.findGroupID(nRow, nCol, patt.data()), lookUp.findGroupIDSlow(nRow, nCol, patt.data()));
+    }
+  }
+
+  // random patterns up to the largest spans, mostly missing from the dictionary
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> spanDist(1, 32), bigSpanDist(1, ClusterPattern::MaxColSpan);
+  for (int i = 0; i < 20000; i++) {
+    int nRow = spanDist(gen), nCol = i % 100 ? spanDist(gen) : bigSpanDist(gen);
+    auto patt = randomPattern(gen, nRow, nCol);
+    BOOST_CHECK_EQUAL(lookUp.findGroupID(nRow, nCol, patt.data()), lookUp.findGroupIDSlow(nRow, nCol, patt.data()));
+  }
+}
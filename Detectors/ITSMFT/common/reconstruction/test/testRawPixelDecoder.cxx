@@ -0,0 +1,89 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RawPixelDecoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <vector>
+#include "ITSMFTReconstruction/RawPixelDecoder.h"
+
+using namespace o2::itsmft;
+using RUTFData = RawPixelDecoder<ChipMappingITS>::RUTFData;
+using RUROFEntry = RawPixelDecoder<ChipMappingITS>::RUROFEntry;
+
+namespace
+{
+// add to the RU TF buffer a ROF with given BC and nChips chips whose IDs encode the BC
+void addROF(RUTFData& ruTF, uint16_t bc, int nChips)
+{
+  auto& rof = ruTF.rofs.emplace_back();
+  rof.ir = {bc, 1000};
+  rof.nLinks = 1;
+  rof.firstChip = ruTF.nChipsFired;
+  rof.nChips = nChips;
+  ruTF.chipsData.resize(ruTF.nChipsFired + nChips);
+  for (int ic = 0; ic < nChips; ic++) {
+    ruTF.chipsData[ruTF.nChipsFired++].setChipID(bc * 10 + ic);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(RUTFDataOrdered)
+{
+  RUTFData ruTF;
+  for (uint16_t bc : {10, 20, 30}) {
+    addROF(ruTF, bc, 2);
+  }
+  BOOST_CHECK_EQUAL(ruTF.sortROFs(), 0);
+  int nSkipped = 0;
+  BOOST_CHECK(ruTF.nextROFForIR({5, 1000}, nSkipped) == nullptr); // no data for this IR, nothing is consumed
+  for (uint16_t bc : {10, 20, 30}) {
+    const auto* rof = ruTF.nextROFForIR({bc, 1000}, nSkipped);
+    BOOST_REQUIRE(rof != nullptr);
+    BOOST_CHECK_EQUAL(rof->ir.bc, bc);
+  }
+  BOOST_CHECK(ruTF.nextROFForIR({40, 1000}, nSkipped) == nullptr);
+  BOOST_CHECK_EQUAL(nSkipped, 0);
+}
+
+BOOST_AUTO_TEST_CASE(RUTFDataOutOfOrder)
+{
+  // links of the RU deliver ROFs out of IR order, one of them twice
+  RUTFData ruTF;
+  const std::vector<uint16_t> received{30, 10, 20, 50, 40, 20, 60};
+  for (auto bc : received) {
+    addROF(ruTF, bc, bc / 10);
+  }
+  BOOST_CHECK_EQUAL(ruTF.sortROFs(), 3);
+  BOOST_CHECK_EQUAL(ruTF.nROFsUnordered, 3);
+
+  // the decoder asks for the union of the IRs of all RUs in increasing order, including those of other RUs
+  int nSkipped = 0;
+  std::vector<uint16_t> provided;
+  for (uint16_t bc : {5, 10, 20, 30, 35, 40, 50, 60}) {
+    const auto* rof = ruTF.nextROFForIR({bc, 1000}, nSkipped);
+    if (!rof) {
+      BOOST_CHECK(bc == 5 || bc == 35);
+      continue;
+    }
+    provided.push_back(rof->ir.bc);
+    BOOST_CHECK_EQUAL(rof->ir.bc, bc);
+    // the ROF still refers to its own chips in the pool
+    BOOST_REQUIRE_EQUAL(rof->nChips, bc / 10);
+    for (int ic = 0; ic < rof->nChips; ic++) {
+      BOOST_CHECK_EQUAL(ruTF.chipsData[rof->firstChip + ic].getChipID(), bc * 10 + ic);
+    }
+  }
+  const std::vector<uint16_t> expected{10, 20, 30, 40, 50, 60};
+  BOOST_CHECK_EQUAL_COLLECTIONS(provided.begin(), provided.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(nSkipped, 1); // the repeated BC 20 cannot be provided
+  BOOST_CHECK_EQUAL(ruTF.nextROF, int(received.size()));
+}
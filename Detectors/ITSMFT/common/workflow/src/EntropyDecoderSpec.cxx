@@ -38,6 +38,7 @@ void EntropyDecoderSpec::init(o2::framework::InitContext& ic)
   if (!dictPath.empty() && dictPath != "none") {
     mCTFCoder.createCoders(dictPath, o2::ctf::CTFCoderBase::OpType::Decoder);
   }
+  mCTFCoder.setNThreads(ic.options().get<int>("nthreads"));
 }
 
 void EntropyDecoderSpec::run(ProcessingContext& pc)
@@ -77,7 +78,8 @@ DataProcessorSpec getEntropyDecoderSpec(o2::header::DataOrigin orig)
     Inputs{InputSpec{"ctf", orig, "CTFDATA", 0, Lifetime::Timeframe}},
     outputs,
     AlgorithmSpec{adaptFromTask<EntropyDecoderSpec>(orig)},
-    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF decoding dictionary"}}}};
+    Options{{"ctf-dict", VariantType::String, o2::base::NameConf::getCTFDictFileName(), {"File of CTF decoding dictionary"}},
+            {"nthreads", VariantType::Int, 1, {"Number of threads for concurrent decoding of CTF blocks"}}}};
 }
 
 } // namespace itsmft
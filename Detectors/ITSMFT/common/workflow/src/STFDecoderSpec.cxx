@@ -59,6 +59,8 @@ void STFDecoder<Mapping>::init(InitContext& ic)
   mNThreads = std::max(1, ic.options().get<int>("nthreads"));
   mDecoder->setNThreads(mNThreads);
   mDecoder->setFormat(ic.options().get<bool>("old-format") ? GBTLink::OldFormat : GBTLink::NewFormat);
+  mDecoder->setDecodeWholeTF(ic.options().get<bool>("decode-whole-tf"));
+  AlpideCoder::setUseTableDecoder(ic.options().get<bool>("table-decoder"));
   mDecoder->setVerbosity(ic.options().get<int>("decoder-verbosity"));
   mDecoder->setFillCalibData(mDoCalibData);
   std::string noiseFile = o2::base::NameConf::getAlpideClusterDictionaryFileName(detID, mNoiseName, "root");
@@ -97,6 +99,14 @@ void STFDecoder<Mapping>::init(InitContext& ic)
       LOG(INFO) << mSelfName << " Dictionary " << dictFile << " is absent, " << Mapping::getName() << " clusterer expects cluster patterns";
     }
     mClusterer->print();
+    if (ic.options().get<bool>("fused-clustering")) {
+      if (mDoDigits || mDecoder->getDecodeWholeTF()) {
+        LOG(WARNING) << mSelfName << " fused decoding+clustering is incompatible with digits output and whole-TF decoding, disabling it";
+      } else {
+        mClusterer->prepareThreads(mNThreads, mDoPatterns);
+        mDecoder->setClusterer(mClusterer.get());
+      }
+    }
   }
 }
 
@@ -126,7 +136,9 @@ void STFDecoder<Mapping>::run(ProcessingContext& pc)
       }
     }
 
-    if (mDoClusters) { // !!! THREADS !!!
+    if (mDecoder->getClusterer()) { // chips were already clusterized by the decoding threads
+      mClusterer->finishDecodedROF(mDecoder->getInteractionRecord(), &clusCompVec, mDoPatterns ? &clusPattVec : nullptr, &clusROFVec);
+    } else if (mDoClusters) { // !!! THREADS !!!
       mClusterer->process(mNThreads, *mDecoder.get(), &clusCompVec, mDoPatterns ? &clusPattVec : nullptr, &clusROFVec);
     }
   }
@@ -203,6 +215,9 @@ DataProcessorSpec getSTFDecoderITSSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
+      {"decode-whole-tf", VariantType::Bool, false, {"Decode every RU for the whole TF at once instead of trigger by trigger"}},
+      {"table-decoder", VariantType::Bool, false, {"Use table-driven ALPIDE chip decoder"}},
+      {"fused-clustering", VariantType::Bool, false, {"Clusterize the chips in the decoding threads right after their decoding"}},
       {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
 }
 
@@ -239,6 +254,9 @@ DataProcessorSpec getSTFDecoderMFTSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
+      {"decode-whole-tf", VariantType::Bool, false, {"Decode every RU for the whole TF at once instead of trigger by trigger"}},
+      {"table-decoder", VariantType::Bool, false, {"Use table-driven ALPIDE chip decoder"}},
+      {"fused-clustering", VariantType::Bool, false, {"Clusterize the chips in the decoding threads right after their decoding"}},
       {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
 }
 
@@ -46,14 +46,16 @@
 /// At least mMinNumberOfNeighbours neighbours (= direct neighbours) has a signal.
 ///
 /// Implementation:
-/// The RAW data is "expanded" for each sector and stored in a big signal
-/// mMapOfAllDigits = 3d vector of all digits
+/// The digits of a sector are stored in a sparse list (time bin, row, pad, charge),
+/// which is sorted by time bin, row and pad before looking for maxima.
+/// Only a few time bins around the one being processed are "expanded" into
+/// dense (row, pad) planes, kept in a ring buffer (mTimeBinWindow) and filled
+/// from the sorted digits when needed. The local maxima are searched for starting
+/// from the filled digits only, in the same order as a scan of the full map.
 ///
 /// To make sure that one never has to check if one is inside the sector or not
-/// the arrays are larger than a sector. For the size in row-direction, a constant is used.
-/// For time and pad direction, a number is set (here is room for improvements).
-///
-/// ToDo: Find an elegant way to split the huge map into four (IROC, OROC1, OROC2 and OROC3) smaller maps. Unfortunately, this seems to interfere with the rest of the code.
+/// the planes are larger than a sector. For the size in row-direction, a constant is used.
+/// For the pad direction, a number is set (here is room for improvements).
 ///
 /// How to use:
 /// Load tpcdigits.root
@@ -76,9 +78,10 @@
 
 #include "TPCBase/CalDet.h"
 
+#include <array>
+#include <cstdint>
 #include <tuple>
 #include <vector>
-#include <array>
 
 namespace o2
 {
@@ -97,8 +100,8 @@ class KrBoxClusterFinder
 {
  public:
   /// Constructor:
-  /// The constructor allocates a three dimensional array (Pad,Row,Time) which is
-  /// later filled with the recorded charges for each digit
+  /// The recorded charges are stored as a sparse list of digits, the dense
+  /// (Row,Pad) planes are only allocated for the time bins being analysed
   explicit KrBoxClusterFinder() = default;
 
   explicit KrBoxClusterFinder(int sector) : mSector(sector){};
@@ -205,8 +208,34 @@ class KrBoxClusterFinder
 
   KrCluster mTempCluster; ///< Used to save the cluster data
 
-  /// Here the map is defined where all digits are temporarily stored
-  std::array<std::array<std::array<float, MaxPads>, MaxRows>, MaxTimes> mMapOfAllDigits{};
+  /// A filled digit, with the pad already shifted to the map coordinates
+  struct SparseDigit {
+    uint16_t time; ///< time bin
+    uint8_t row;   ///< row in sector
+    uint8_t pad;   ///< corrected pad, see fillADCValue
+    float adc;     ///< (gain corrected) charge
+  };
+
+  using TimeBinPlane = std::array<std::array<float, MaxPads>, MaxRows>;
+
+  /// Here all digits are temporarily stored
+  std::vector<SparseDigit> mDigits;         //! digits of the sector
+  bool mDigitsSorted = false;               //! mDigits is sorted by (time, row, pad) without duplicates and mTimeBinOffsets is filled
+  std::vector<uint32_t> mTimeBinOffsets;    //! digits of time bin t are [mTimeBinOffsets[t], mTimeBinOffsets[t + 1])
+  std::vector<TimeBinPlane> mTimeBinWindow; //! dense maps of the time bins around the one being processed
+  std::vector<int> mTimeBinWindowContent;   //! time bin stored in each plane of mTimeBinWindow, -1 if none
+
+  /// Sort the digits and remove the duplicates, the last filled value is kept
+  void sortDigits();
+
+  /// Fill mTimeBinWindow with all the time bins needed around timeBin
+  void loadTimeBins(int timeBin);
+
+  /// Reset the planes of mTimeBinWindow which contain some digits
+  void clearTimeBinWindow();
+
+  /// Charge in the map, the time bin must be loaded with loadTimeBins
+  float getADC(int timeBin, int row, int pad) const { return mTimeBinWindow[timeBin % mTimeBinWindow.size()][row][pad]; }
 
   /// For each ROC, the maximum cluster size has to be chosen
   void setMaxClusterSize(int row);
@@ -19,6 +19,7 @@
 #include "Framework/Logger.h"
 
 #include <TFile.h>
+#include <algorithm>
 #include <vector>
 
 using namespace o2::tpc;
@@ -39,14 +40,90 @@ void KrBoxClusterFinder::loadGainMapFromFile(const std::string_view calDetFileNa
 
 void KrBoxClusterFinder::resetADCMap()
 {
-  // Reset whole map:
-  for (int iTime = 0; iTime < MaxTimes; iTime++) {
-    for (int iRow = 0; iRow < MaxRows; iRow++) {
-      std::fill(mMapOfAllDigits[iTime][iRow].begin(), mMapOfAllDigits[iTime][iRow].end(), 0.);
-      //for (int iPad = 0; iPad < MaxPads; iPad++) {
-      //mMapOfAllDigits[iTime][iRow][iPad] = 0;
-      //}
+  // Only the planes which were filled need to be reset
+  clearTimeBinWindow();
+  mDigits.clear();
+  mDigitsSorted = false;
+}
+
+void KrBoxClusterFinder::clearTimeBinWindow()
+{
+  for (size_t iPlane = 0; iPlane < mTimeBinWindow.size(); ++iPlane) {
+    const int timeBin = mTimeBinWindowContent[iPlane];
+    if (timeBin < 0) {
+      continue;
+    }
+    auto& plane = mTimeBinWindow[iPlane];
+    for (auto iDigit = mTimeBinOffsets[timeBin]; iDigit < mTimeBinOffsets[timeBin + 1]; ++iDigit) {
+      plane[mDigits[iDigit].row][mDigits[iDigit].pad] = 0.;
+    }
+    mTimeBinWindowContent[iPlane] = -1;
+  }
+}
+
+void KrBoxClusterFinder::sortDigits()
+{
+  // The window is filled using the offsets of the current order
+  clearTimeBinWindow();
+
+  auto key = [](const SparseDigit& digit) {
+    return (uint32_t(digit.time) << 16) | (uint32_t(digit.row) << 8) | digit.pad;
+  };
+  // stable, so that the last value filled for a pad is kept, as in the dense map
+  std::stable_sort(mDigits.begin(), mDigits.end(), [&key](const auto& a, const auto& b) { return key(a) < key(b); });
+  size_t nDigits = 0;
+  for (const auto& digit : mDigits) {
+    if (nDigits && key(mDigits[nDigits - 1]) == key(digit)) {
+      mDigits[nDigits - 1] = digit;
+    } else {
+      mDigits[nDigits++] = digit;
+    }
+  }
+  mDigits.resize(nDigits);
+
+  mTimeBinOffsets.assign(MaxTimes + 1, 0);
+  for (const auto& digit : mDigits) {
+    ++mTimeBinOffsets[digit.time + 1];
+  }
+  for (size_t iTime = 0; iTime < MaxTimes; ++iTime) {
+    mTimeBinOffsets[iTime + 1] += mTimeBinOffsets[iTime];
+  }
+  mDigitsSorted = true;
+}
+
+void KrBoxClusterFinder::loadTimeBins(int timeBin)
+{
+  if (!mDigitsSorted) {
+    sortDigits();
+  }
+
+  // The maximum search looks at the direct neighbours in time, the box
+  // around the maximum at mMaxClusterSizeTime time bins on each side
+  const int halfWidth = std::max(mMaxClusterSizeTime, 1);
+  const size_t windowSize = 2 * halfWidth + 1;
+  if (mTimeBinWindow.size() != windowSize) {
+    clearTimeBinWindow();
+    mTimeBinWindow.resize(windowSize);
+    mTimeBinWindowContent.assign(windowSize, -1);
+  }
+
+  const int lastTimeBin = std::min(timeBin + halfWidth, int(MaxTimes) - 1);
+  for (int iTime = std::max(timeBin - halfWidth, 0); iTime <= lastTimeBin; ++iTime) {
+    const size_t iPlane = iTime % windowSize;
+    auto& content = mTimeBinWindowContent[iPlane];
+    if (content == iTime) {
+      continue;
+    }
+    auto& plane = mTimeBinWindow[iPlane];
+    if (content >= 0) {
+      for (auto iDigit = mTimeBinOffsets[content]; iDigit < mTimeBinOffsets[content + 1]; ++iDigit) {
+        plane[mDigits[iDigit].row][mDigits[iDigit].pad] = 0.;
+      }
+    }
+    for (auto iDigit = mTimeBinOffsets[iTime]; iDigit < mTimeBinOffsets[iTime + 1]; ++iDigit) {
+      plane[mDigits[iDigit].row][mDigits[iDigit].pad] = mDigits[iDigit].adc;
     }
+    content = iTime;
   }
 }
 
@@ -64,7 +141,7 @@ void KrBoxClusterFinder::fillAndCorrectMap(std::vector<o2::tpc::Digit>& eventSec
     // max/min pointer (which are nullptr if data is empty) empty events should
     // be catched in the main function, hence, this "if" is no longer necessary
     LOGP(warning, "Sector size (amount of data points) in current run is 0!");
-    LOGP(warning, "mMapOfAllDigits with 0's is generated in order to prevent a segementation fault.");
+    LOGP(warning, "Empty map is generated in order to prevent a segementation fault.");
 
     return;
   }
@@ -96,7 +173,8 @@ void KrBoxClusterFinder::fillADCValue(int cru, int rowInSector, int padInRow, in
 
   const auto correctionFactorCalDet = mGainMap.get();
   if (!correctionFactorCalDet) {
-    mMapOfAllDigits[timeBin][rowInSector][corPad] = adcValue;
+    mDigits.push_back({uint16_t(timeBin), uint8_t(rowInSector), uint8_t(corPad), adcValue});
+    mDigitsSorted = false;
     return;
   }
 
@@ -111,7 +189,8 @@ void KrBoxClusterFinder::fillADCValue(int cru, int rowInSector, int padInRow, in
     adcValue /= correctionFactor;
   }
 
-  mMapOfAllDigits[timeBin][rowInSector][corPad] = adcValue;
+  mDigits.push_back({uint16_t(timeBin), uint8_t(rowInSector), uint8_t(corPad), adcValue});
+  mDigitsSorted = false;
 }
 
 void KrBoxClusterFinder::init()
@@ -196,124 +275,121 @@ void KrBoxClusterFinder::updateTempCluster(float tempCharge, int tempPad, int te
   }
 }
 
-// This function finds and evaluates all clusters in a 3D mMapOfAllDigits generated by the
-// mMapOfAllDigitsCreator function, this function also updates the cluster tree
+// This function finds and evaluates all clusters in the map of the filled digits,
+// this function also updates the cluster tree
 std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool directFilling)
 {
   std::vector<std::tuple<int, int, int>> localMaximaCoords;
-  // loop over whole mMapOfAllDigits the find clusters
-  for (int iTime = 0; iTime < MaxTimes; iTime++) { //mMapOfAllDigits.size()
-    const auto& mapRow = mMapOfAllDigits[iTime];
-    for (int iRow = 0; iRow < MaxRows; iRow++) { // mapRow.size()
+  if (!mDigitsSorted) {
+    sortDigits();
+  }
+  // loop over the filled digits, in the (time, row, pad) order, to find clusters
+  for (size_t iDigit = 0; iDigit < mDigits.size();) {
+    const int iTime = mDigits[iDigit].time;
+    const size_t lastDigit = mTimeBinOffsets[iTime + 1];
+    loadTimeBins(iTime);
+
+    for (; iDigit < lastDigit; ++iDigit) {
+      const int iRow = mDigits[iDigit].row;
+      const int iPad = mDigits[iDigit].pad;
+
       // Since pad size is different for each ROC, we take this into account while looking for maxima:
-      // setMaxClusterSize(iRow);
-      if (iRow == 0) {
-        mMaxClusterSizePad = mMaxClusterSizePadIROC;
-        mMaxClusterSizeRow = mMaxClusterSizeRowIROC;
-      } else if (iRow == MaxRowsIROC) {
-        mMaxClusterSizePad = mMaxClusterSizePadOROC1;
-        mMaxClusterSizeRow = mMaxClusterSizeRowOROC1;
-      } else if (iRow == MaxRowsIROC + MaxRowsOROC1) {
-        mMaxClusterSizePad = mMaxClusterSizePadOROC2;
-        mMaxClusterSizeRow = mMaxClusterSizeRowOROC2;
-      } else if (iRow == MaxRowsIROC + MaxRowsOROC1 + MaxRowsOROC2) {
-        mMaxClusterSizePad = mMaxClusterSizePadOROC3;
-        mMaxClusterSizeRow = mMaxClusterSizeRowOROC3;
-      }
+      setMaxClusterSize(iRow);
 
-      const auto& mapPad = mapRow[iRow];
+      // Only look at existing pads:
       const int padsInRow = mMapperInstance.getNumberOfPadsInRowSector(iRow);
+      if ((iPad < int(MaxPads / 2 - padsInRow / 2)) || (iPad >= int(MaxPads / 2 + padsInRow / 2))) {
+        continue;
+      }
 
-      // Only loop over existing pads:
-      for (int iPad = MaxPads / 2 - padsInRow / 2; iPad < MaxPads / 2 + padsInRow / 2; iPad++) { // mapPad.size()
+      const float qMax = mDigits[iDigit].adc;
 
-        const float qMax = mapPad[iPad];
+      // cluster Maximum must at least be larger than Threshold
+      if (qMax <= mQThresholdMax) {
+        continue;
+      }
 
-        // cluster Maximum must at least be larger than Threshold
-        if (qMax <= mQThresholdMax) {
+      // Acceptance condition: Require at least mMinNumberOfNeighbours neigbours
+      // with signal in any direction!
+      int noNeighbours = 0;
+      if ((iPad + 1 < MaxPads) && (getADC(iTime, iRow, iPad + 1) > mQThreshold)) {
+        if (getADC(iTime, iRow, iPad + 1) > qMax) {
           continue;
         }
-
-        // Acceptance condition: Require at least mMinNumberOfNeighbours neigbours
-        // with signal in any direction!
-        int noNeighbours = 0;
-        if ((iPad + 1 < MaxPads) && (mMapOfAllDigits[iTime][iRow][iPad + 1] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime][iRow][iPad + 1] > qMax) {
-            continue;
-          }
-          noNeighbours++;
-        }
-        if ((iPad - 1 >= 0) && (mMapOfAllDigits[iTime][iRow][iPad - 1] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime][iRow][iPad - 1] > qMax) {
-            continue;
-          }
-          noNeighbours++;
-        }
-        if ((iRow + 1 < MaxRows) && (mMapOfAllDigits[iTime][iRow + 1][iPad] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime][iRow + 1][iPad] > qMax) {
-            continue;
-          }
-          noNeighbours++;
+        noNeighbours++;
+      }
+      if ((iPad - 1 >= 0) && (getADC(iTime, iRow, iPad - 1) > mQThreshold)) {
+        if (getADC(iTime, iRow, iPad - 1) > qMax) {
+          continue;
         }
-        if ((iRow - 1 >= 0) && (mMapOfAllDigits[iTime][iRow - 1][iPad] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime][iRow - 1][iPad] > qMax) {
-            continue;
-          }
-          noNeighbours++;
+        noNeighbours++;
+      }
+      if ((iRow + 1 < MaxRows) && (getADC(iTime, iRow + 1, iPad) > mQThreshold)) {
+        if (getADC(iTime, iRow + 1, iPad) > qMax) {
+          continue;
         }
-        if ((iTime + 1 < MaxTimes) && (mMapOfAllDigits[iTime + 1][iRow][iPad] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime + 1][iRow][iPad] > qMax) {
-            continue;
-          }
-          noNeighbours++;
+        noNeighbours++;
+      }
+      if ((iRow - 1 >= 0) && (getADC(iTime, iRow - 1, iPad) > mQThreshold)) {
+        if (getADC(iTime, iRow - 1, iPad) > qMax) {
+          continue;
         }
-        if ((iTime - 1 >= 0) && (mMapOfAllDigits[iTime - 1][iRow][iPad] > mQThreshold)) {
-          if (mMapOfAllDigits[iTime - 1][iRow][iPad] > qMax) {
-            continue;
-          }
-          noNeighbours++;
+        noNeighbours++;
+      }
+      if ((iTime + 1 < MaxTimes) && (getADC(iTime + 1, iRow, iPad) > mQThreshold)) {
+        if (getADC(iTime + 1, iRow, iPad) > qMax) {
+          continue;
         }
-        if (noNeighbours < mMinNumberOfNeighbours) {
+        noNeighbours++;
+      }
+      if ((iTime - 1 >= 0) && (getADC(iTime - 1, iRow, iPad) > mQThreshold)) {
+        if (getADC(iTime - 1, iRow, iPad) > qMax) {
           continue;
         }
+        noNeighbours++;
+      }
+      if (noNeighbours < mMinNumberOfNeighbours) {
+        continue;
+      }
 
-        // Check that this is a local maximum
-        // Note that the checking is done so that if 2 charges have the same
-        // qMax then only 1 cluster is generated
-        // (that is why there is BOTH > and >=)
-        // -> only the maximum with the smalest indices will be accepted
-        bool thisIsMax = true;
+      // Check that this is a local maximum
+      // Note that the checking is done so that if 2 charges have the same
+      // qMax then only 1 cluster is generated
+      // (that is why there is BOTH > and >=)
+      // -> only the maximum with the smalest indices will be accepted
+      bool thisIsMax = true;
 
-        for (int j = -mMaxClusterSizeTime; (j <= mMaxClusterSizeTime) && thisIsMax; j++) {
-          if ((iTime + j >= MaxTimes) || (iTime + j < 0)) {
+      for (int j = -mMaxClusterSizeTime; (j <= mMaxClusterSizeTime) && thisIsMax; j++) {
+        if ((iTime + j >= MaxTimes) || (iTime + j < 0)) {
+          continue;
+        }
+        for (int k = -mMaxClusterSizeRow; (k <= mMaxClusterSizeRow) && thisIsMax; k++) {
+          if ((iRow + k >= MaxRows) || (iRow + k < 0)) {
             continue;
           }
-          for (int k = -mMaxClusterSizeRow; (k <= mMaxClusterSizeRow) && thisIsMax; k++) {
-            if ((iRow + k >= MaxRows) || (iRow + k < 0)) {
+          for (int i = -mMaxClusterSizePad; (i <= mMaxClusterSizePad) && thisIsMax; i++) {
+            if ((iPad + i >= MaxPads) || (iPad + i < 0)) {
               continue;
             }
-            for (int i = -mMaxClusterSizePad; (i <= mMaxClusterSizePad) && thisIsMax; i++) {
-              if ((iPad + i >= MaxPads) || (iPad + i < 0)) {
-                continue;
-              }
-              if (mMapOfAllDigits[iTime + j][iRow + k][iPad + i] > qMax) {
-                thisIsMax = false;
-              }
+            if (getADC(iTime + j, iRow + k, iPad + i) > qMax) {
+              thisIsMax = false;
             }
           }
         }
+      }
 
-        if (!thisIsMax) {
-          continue;
+      if (!thisIsMax) {
+        continue;
+      } else {
+        if (directFilling) {
+          buildCluster(iPad, iRow, iTime, directFilling);
         } else {
-          if (directFilling) {
-            buildCluster(iPad, iRow, iTime, directFilling);
-          } else {
-            localMaximaCoords.emplace_back(std::make_tuple(iPad, iRow, iTime));
-          }
+          localMaximaCoords.emplace_back(std::make_tuple(iPad, iRow, iTime));
+        }
 
-          // If we have found a local maximum, we can also skip the next few entries:
-          iPad += mMaxClusterSizePad;
+        // If we have found a local maximum, we can also skip the next few pads:
+        while ((iDigit + 1 < lastDigit) && (mDigits[iDigit + 1].row == iRow) && (mDigits[iDigit + 1].pad <= iPad + mMaxClusterSizePad)) {
+          ++iDigit;
         }
       }
     }
@@ -343,6 +419,7 @@ KrCluster KrBoxClusterFinder::buildCluster(int clusterCenterPad, int clusterCent
   mTempCluster.reset();
 
   setMaxClusterSize(clusterCenterRow);
+  loadTimeBins(clusterCenterTime);
 
   // Loop over all neighbouring time bins:
   for (int iTime = -mMaxClusterSizeTime; iTime <= mMaxClusterSizeTime; iTime++) {
@@ -391,42 +468,42 @@ KrCluster KrBoxClusterFinder::buildCluster(int clusterCenterPad, int clusterCent
 
         // Second: Check if charge is above threshold
         // Might be not necessary since we deal with pedestal subtracted data
-        if (mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad] <= mQThreshold) {
+        if (getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad) <= mQThreshold) {
           continue;
         }
         // If not, there are several cases which were explained (for 2D) in the header of the code.
         // The first one is for the diagonal. So, the digit we are investigating here is on the diagonal:
         if (std::abs(iTime) == std::abs(iPad) && std::abs(iTime) == std::abs(iRow)) {
           // Now we check, if the next inner digit has a signal above threshold:
-          if (mMapOfAllDigits[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+          if (getADC(clusterCenterTime + iTime - signnum(iTime), clusterCenterRow + iRow - signnum(iRow), clusterCenterPad + iPad - signnum(iPad)) > mQThreshold) {
             // If yes, the cluster gets updated with the digit on the diagonal.
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
         // Basically, we go through every possible case in the next few if-else conditions:
         else if (std::abs(iTime) == std::abs(iPad)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime - signnum(iTime), clusterCenterRow + iRow, clusterCenterPad + iPad - signnum(iPad)) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) == std::abs(iRow)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime - signnum(iTime), clusterCenterRow + iRow - signnum(iRow), clusterCenterPad + iPad) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iPad) == std::abs(iRow)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime, clusterCenterRow + iRow - signnum(iRow), clusterCenterPad + iPad - signnum(iPad)) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) > std::abs(iPad) && std::abs(iTime) > std::abs(iRow)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime - signnum(iTime), clusterCenterRow + iRow, clusterCenterPad + iPad) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iPad) && std::abs(iPad) > std::abs(iRow)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad - signnum(iPad)) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iRow) && std::abs(iPad) < std::abs(iRow)) {
-          if (mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mMapOfAllDigits[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getADC(clusterCenterTime + iTime, clusterCenterRow + iRow - signnum(iRow), clusterCenterPad + iPad) > mQThreshold) {
+            updateTempCluster(getADC(clusterCenterTime + iTime, clusterCenterRow + iRow, clusterCenterPad + iPad), clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
       }
@@ -27,6 +27,10 @@
 #include "TPCdEdxCalibrationSplines.h"
 #include "GPUO2Interface.h"
 #include "GPUO2InterfaceConfiguration.h"
+#include "GPUReconstruction.h"
+#include "GPUChainTracking.h"
+#include "GPUTPCTracker.h"
+#include "GPUTPCSliceOutput.h"
 #include "TPCPadGainCalib.h"
 
 using namespace o2::gpu;
@@ -34,6 +38,8 @@ using namespace o2::gpu;
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <cmath>
+#include <random>
 
 using namespace o2::dataformats;
 
@@ -104,5 +110,146 @@ BOOST_AUTO_TEST_CASE(CATracking_test1)
   BOOST_CHECK_EQUAL(retVal, 0);
   BOOST_CHECK_EQUAL((int)ptrs.nMergedTracks, 1);
 }
+namespace
+{
+/// Clusters of helices from the vertex, the low momentum tracks cross into the neighbouring sectors
+std::vector<ClusterNativeContainer> createHelixClusters(const TPCFastTransform& transform, float solenoidBz)
+{
+  const auto& geo = transform.getGeometry();
+  std::vector<ClusterNativeContainer> cont(constants::MAXSECTOR * constants::MAXGLOBALPADROW);
+  for (int iSector = 0; iSector < constants::MAXSECTOR; iSector++) {
+    for (int iRow = 0; iRow < constants::MAXGLOBALPADROW; iRow++) {
+      cont[iSector * constants::MAXGLOBALPADROW + iRow].sector = iSector;
+      cont[iSector * constants::MAXGLOBALPADROW + iRow].globalPadRow = iRow;
+    }
+  }
+
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> phiDist(0.f, 2.f * M_PI), tanLambdaDist(0.1f, 0.8f), ptDist(0.3f, 3.f), unitDist(0.f, 1.f);
+  for (int iTrack = 0; iTrack < 400; iTrack++) {
+    const float phi0 = phiDist(gen);
+    const bool sideC = iTrack % 2;
+    const float tanLambda = (sideC ? -1.f : 1.f) * tanLambdaDist(gen);
+    const float radius = (unitDist(gen) > 0.5f ? 1.f : -1.f) * ptDist(gen) / (0.000299792458f * std::abs(solenoidBz)); // [cm]
+    for (int iSector = sideC ? geo.getNumberOfSlicesA() : 0; iSector < (sideC ? constants::MAXSECTOR : geo.getNumberOfSlicesA()); iSector++) {
+      const auto& sliceInfo = geo.getSliceInfo(iSector);
+      const float alpha = std::atan2(sliceInfo.sinAlpha, sliceInfo.cosAlpha);
+      for (int iRow = 0; iRow < constants::MAXGLOBALPADROW; iRow++) {
+        const auto& rowInfo = geo.getRowInfo(iRow);
+        // radius at which the helix crosses the pad row
+        float r = rowInfo.x, dPhi = 0.f;
+        for (int i = 0; i < 5 && r < 2.f * std::abs(radius); i++) {
+          dPhi = std::remainder(phi0 + std::asin(r / (2.f * radius)) - alpha, 2.f * (float)M_PI);
+          r = std::abs(dPhi) < 0.6f ? rowInfo.x / std::cos(dPhi) : 2.f * std::abs(radius);
+        }
+        if (r >= 2.f * std::abs(radius) || std::abs(dPhi) > 0.5f) {
+          continue;
+        }
+        const float y = r * std::sin(dPhi);
+        const float z = tanLambda * 2.f * radius * std::asin(r / (2.f * radius));
+        float u, v, pad, time;
+        geo.convLocalToUV(iSector, y, z, u, v);
+        transform.convUVtoPadTime(iSector, iRow, u, v, pad, time, 0.f);
+        if (pad < 0.f || pad > rowInfo.maxPad || time < 0.f || unitDist(gen) < 0.05f) {
+          continue;
+        }
+        ClusterNative cl;
+        cl.setTimeFlags(time, 0);
+        cl.setPad(pad);
+        cl.setSigmaTime(1);
+        cl.setSigmaPad(1);
+        cl.qMax = 10;
+        cl.qTot = 50;
+        cont[iSector * constants::MAXGLOBALPADROW + iRow].clusters.emplace_back(cl);
+      }
+    }
+  }
+  return cont;
+}
+
+struct SliceTracks {
+  unsigned int nLocalTracks = 0;
+  std::vector<std::vector<unsigned int>> clusterIds;
+  std::vector<float> y, z;
+};
+
+/// Runs the slice tracker alone and returns the slice output of all sectors
+std::vector<SliceTracks> runSliceTracking(const ClusterNativeAccess* clusters, TPCFastTransform* transform, float solenoidBz, int debugLevel)
+{
+  GPUO2InterfaceConfiguration config;
+  config.configDeviceBackend.deviceType = GPUDataTypes::DeviceType::CPU;
+  config.configDeviceBackend.forceDeviceType = true;
+  config.configProcessing.ompThreads = 4;
+  config.configProcessing.ompKernels = 0; // parallelize over the sectors only, the kernels are then deterministic
+  config.configProcessing.debugLevel = debugLevel;
+  config.configGRP.solenoidBz = solenoidBz;
+  config.configGRP.continuousMaxTimeBin = 0;
+  config.configReconstruction.tpc.globalTracking = 1;
+  config.configWorkflow.steps.set(GPUDataTypes::RecoStep::TPCConversion, GPUDataTypes::RecoStep::TPCSliceTracking);
+  config.configWorkflow.inputs.set(GPUDataTypes::InOutType::TPCClusters);
+  config.configWorkflow.outputs.set(GPUDataTypes::InOutType::TPCSectorTracks);
+  config.configCalib.fastTransform = transform;
+
+  std::unique_ptr<GPUReconstruction> rec(GPUReconstruction::CreateInstance(config.configDeviceBackend));
+  BOOST_REQUIRE(rec != nullptr);
+  GPUChainTracking* chain = rec->AddChain<GPUChainTracking>();
+  rec->SetSettings(&config.configGRP, &config.configReconstruction, &config.configProcessing, &config.configWorkflow);
+  chain->SetCalibObjects(config.configCalib);
+  BOOST_REQUIRE_EQUAL(rec->Init(), 0);
+  chain->mIOPtrs.clustersNative = clusters;
+  BOOST_REQUIRE_EQUAL(rec->RunChains(), 0);
+
+  std::vector<SliceTracks> result(constants::MAXSECTOR);
+  for (int iSector = 0; iSector < constants::MAXSECTOR; iSector++) {
+    const GPUTPCSliceOutput* output = chain->GetTPCSliceTrackers()[iSector].Output();
+    BOOST_REQUIRE(output != nullptr);
+    result[iSector].nLocalTracks = output->NLocalTracks();
+    const GPUTPCTrack* track = output->GetFirstTrack();
+    for (unsigned int iTrack = 0; iTrack < output->NTracks(); iTrack++) {
+      std::vector<unsigned int> ids;
+      for (int iCl = 0; iCl < track->NHits(); iCl++) {
+        ids.emplace_back(track->OutTrackCluster(iCl).GetId());
+      }
+      result[iSector].clusterIds.emplace_back(std::move(ids));
+      result[iSector].y.emplace_back(track->Param().GetY());
+      result[iSector].z.emplace_back(track->Param().GetZ());
+      track = track->GetNextTrack();
+    }
+  }
+  rec->Finalize();
+  return result;
+}
+} // namespace
+
+/// @brief The global tracking and the output run inside the slice loop with debugLevel < 1, check against the separate loops of debugLevel >= 1
+BOOST_AUTO_TEST_CASE(CATracking_sliceOutput)
+{
+  float solenoidBz = -5.00668;
+  std::unique_ptr<TPCFastTransform> fastTransform(TPCFastTransformHelperO2::instance()->create(0));
+  std::vector<ClusterNativeContainer> cont = createHelixClusters(*fastTransform, solenoidBz);
+  std::unique_ptr<ClusterNative[]> clusterBuffer;
+  std::unique_ptr<ClusterNativeAccess> clusters = ClusterNativeHelper::createClusterNativeIndex(clusterBuffer, cont, nullptr, nullptr);
+
+  const auto inLoop = runSliceTracking(clusters.get(), fastTransform.get(), solenoidBz, -1);
+  const auto separate = runSliceTracking(clusters.get(), fastTransform.get(), solenoidBz, 1);
+
+  unsigned int nLocalTracks = 0, nGlobalTracks = 0;
+  for (int iSector = 0; iSector < constants::MAXSECTOR; iSector++) {
+    BOOST_TEST_CONTEXT("sector " << iSector)
+    {
+      BOOST_CHECK_EQUAL(inLoop[iSector].nLocalTracks, separate[iSector].nLocalTracks);
+      BOOST_REQUIRE_EQUAL(inLoop[iSector].clusterIds.size(), separate[iSector].clusterIds.size());
+      for (size_t iTrack = 0; iTrack < inLoop[iSector].clusterIds.size(); iTrack++) {
+        BOOST_CHECK(inLoop[iSector].clusterIds[iTrack] == separate[iSector].clusterIds[iTrack]);
+        BOOST_CHECK_EQUAL(inLoop[iSector].y[iTrack], separate[iSector].y[iTrack]);
+        BOOST_CHECK_EQUAL(inLoop[iSector].z[iTrack], separate[iSector].z[iTrack]);
+      }
+      nLocalTracks += inLoop[iSector].nLocalTracks;
+      nGlobalTracks += inLoop[iSector].clusterIds.size() - inLoop[iSector].nLocalTracks;
+    }
+  }
+  BOOST_CHECK_GT(nLocalTracks, 0u);
+  BOOST_CHECK_GT(nGlobalTracks, 0u);
+}
 } // namespace tpc
 } // namespace o2
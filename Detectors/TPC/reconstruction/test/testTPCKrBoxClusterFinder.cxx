@@ -0,0 +1,293 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCKrBoxClusterFinder.cxx
+/// \brief This task tests the KrBoxClusterFinder with synthetic digits
+
+#define BOOST_TEST_MODULE Test TPC KrBoxClusterFinder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsTPC/Digit.h"
+#include "TPCBase/Mapper.h"
+#include "TPCReconstruction/KrBoxClusterFinder.h"
+
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace o2
+{
+namespace tpc
+{
+
+/// A charge in the sector, the pad is counted from the center of the row,
+/// so that the same value is the same position in neighbouring rows
+struct KrCharge {
+  int row;
+  int padFromCenter;
+  int time;
+  float q;
+};
+
+int padsInRow(int row)
+{
+  return Mapper::instance().getNumberOfPadsInRowSector(row);
+}
+
+int padInRow(int row, int padFromCenter)
+{
+  return padFromCenter + padsInRow(row) / 2;
+}
+
+/// Cluster finder with a 3x3x3 box, one neighbour and a maximum above 10 ADC counts
+std::unique_ptr<KrBoxClusterFinder> createClusterFinder(const std::vector<KrCharge>& charges)
+{
+  auto clusterFinder = std::make_unique<KrBoxClusterFinder>(0);
+  clusterFinder->setMaxClusterSize(1, 1, 1, 1, 1, 1, 1, 1, 1);
+  clusterFinder->setMinNumberOfNeighbours(1);
+  clusterFinder->setMinQTreshold(10);
+  for (const auto& charge : charges) {
+    clusterFinder->fillADCValue(0, charge.row, padInRow(charge.row, charge.padFromCenter), charge.time, charge.q);
+  }
+  return clusterFinder;
+}
+
+/// The cluster made of all the charges, computed as written in KrCluster
+KrCluster expectedCluster(const std::vector<KrCharge>& charges)
+{
+  KrCluster cluster;
+  double sumPad = 0, sumPad2 = 0, sumRow = 0, sumRow2 = 0, sumTime = 0, sumTime2 = 0;
+  int maxRow = 0, maxPad = 0;
+  for (const auto& charge : charges) {
+    cluster.size++;
+    cluster.totCharge += charge.q;
+    sumPad += charge.padFromCenter * charge.q;
+    sumPad2 += charge.padFromCenter * charge.padFromCenter * charge.q;
+    sumRow += charge.row * charge.q;
+    sumRow2 += charge.row * charge.row * charge.q;
+    sumTime += charge.time * charge.q;
+    sumTime2 += charge.time * charge.time * charge.q;
+    if (charge.q > cluster.maxCharge) {
+      cluster.maxCharge = charge.q;
+      maxRow = charge.row;
+      maxPad = charge.padFromCenter;
+    }
+  }
+  const double q = cluster.totCharge;
+  cluster.meanRow = sumRow / q;
+  cluster.meanPad = sumPad / q + padsInRow(int(cluster.meanRow)) / 2.;
+  cluster.meanTime = sumTime / q;
+  cluster.sigmaRow = std::sqrt(sumRow2 / q - sumRow * sumRow / q / q);
+  cluster.sigmaPad = std::sqrt(sumPad2 / q - sumPad * sumPad / q / q);
+  cluster.sigmaTime = std::sqrt(sumTime2 / q - sumTime * sumTime / q / q);
+  cluster.maxChargeRow = maxRow;
+  cluster.maxChargePad = padInRow(maxRow, maxPad);
+  return cluster;
+}
+
+void checkCluster(const KrCluster& cluster, const KrCluster& expected)
+{
+  BOOST_CHECK_EQUAL(int(cluster.size), int(expected.size));
+  BOOST_CHECK_EQUAL(int(cluster.sector), 0);
+  BOOST_CHECK_CLOSE(cluster.totCharge, expected.totCharge, 1e-4);
+  BOOST_CHECK_CLOSE(cluster.maxCharge, expected.maxCharge, 1e-4);
+  BOOST_CHECK_EQUAL(int(cluster.maxChargeRow), int(expected.maxChargeRow));
+  BOOST_CHECK_EQUAL(int(cluster.maxChargePad), int(expected.maxChargePad));
+  BOOST_CHECK_SMALL(cluster.meanPad - expected.meanPad, 1e-3f);
+  BOOST_CHECK_SMALL(cluster.meanRow - expected.meanRow, 1e-3f);
+  BOOST_CHECK_SMALL(cluster.meanTime - expected.meanTime, 1e-3);
+  // the second moments are summed in single precision around the absolute position,
+  // at time bins of a few hundreds the time sigma is only precise to 0.1 time bins
+  BOOST_CHECK_SMALL(cluster.sigmaPad - expected.sigmaPad, 1e-2f);
+  BOOST_CHECK_SMALL(cluster.sigmaRow - expected.sigmaRow, 1e-2f);
+  BOOST_CHECK_SMALL(cluster.sigmaTime - expected.sigmaTime, 0.15);
+}
+
+/// \brief One maximum with charges all around it, a single cluster made of the box
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_localMaximum)
+{
+  const std::vector<KrCharge> cluster{
+    {10, 0, 100, 100.f},
+    {10, 1, 100, 50.f},
+    {10, -1, 100, 30.f},
+    {11, 0, 100, 20.f},
+    {10, 0, 101, 40.f},
+    {10, 1, 101, 10.f},
+    {9, -1, 99, 5.f}};
+  auto charges = cluster;
+  // outside of the box, below the threshold of a maximum
+  charges.push_back({10, 2, 100, 5.f});
+  // above the threshold of a maximum, but without any neighbour
+  charges.push_back({10, 20, 100, 200.f});
+
+  auto clusterFinder = createClusterFinder(charges);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 1);
+  const auto [pad, row, time] = maxima[0];
+  BOOST_CHECK_EQUAL(row, 10);
+  BOOST_CHECK_EQUAL(time, 100);
+  auto result = clusterFinder->buildCluster(pad, row, time);
+  checkCluster(result, expectedCluster(cluster));
+  BOOST_CHECK_EQUAL(int(result.size), 7);
+  BOOST_CHECK_CLOSE(result.totCharge, 255.f, 1e-4);
+  BOOST_CHECK_CLOSE(result.meanTime, (99. * 5. + 100. * 200. + 101. * 50.) / 255., 1e-4);
+
+  // the same cluster is stored when filling directly
+  clusterFinder->findLocalMaxima(true);
+  BOOST_REQUIRE_EQUAL(clusterFinder->getClusters().size(), 1);
+  checkCluster(clusterFinder->getClusters()[0], expectedCluster(cluster));
+}
+
+/// \brief Two equal charges next to each other give a single maximum
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_equalCharges)
+{
+  const std::vector<KrCharge> cluster{
+    {20, 3, 50, 60.f},
+    {20, 4, 50, 60.f},
+    {20, 3, 51, 15.f}};
+  auto clusterFinder = createClusterFinder(cluster);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 1);
+  const auto [pad, row, time] = maxima[0];
+  BOOST_CHECK_EQUAL(row, 20);
+  BOOST_CHECK_EQUAL(time, 50);
+  auto result = clusterFinder->buildCluster(pad, row, time);
+  checkCluster(result, expectedCluster(cluster));
+  BOOST_CHECK_EQUAL(int(result.maxChargePad), padInRow(20, 3));
+}
+
+/// \brief Clusters on the first and last pad of a row do not reach beyond the row
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_padEdges)
+{
+  const int row = 30;
+  const int firstPad = -padsInRow(row) / 2;
+  const int lastPad = padsInRow(row) / 2 - 1;
+  const std::vector<KrCharge> clusterFirst{
+    {row, firstPad, 200, 80.f},
+    {row, firstPad + 1, 200, 40.f},
+    {row, firstPad, 201, 20.f}};
+  const std::vector<KrCharge> clusterLast{
+    {row, lastPad, 300, 70.f},
+    {row, lastPad - 1, 300, 35.f},
+    {row + 1, lastPad, 300, 15.f}};
+  auto charges = clusterFirst;
+  charges.insert(charges.end(), clusterLast.begin(), clusterLast.end());
+
+  auto clusterFinder = createClusterFinder(charges);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 2);
+  BOOST_CHECK_EQUAL(std::get<2>(maxima[0]), 200);
+  BOOST_CHECK_EQUAL(std::get<2>(maxima[1]), 300);
+  auto first = clusterFinder->buildCluster(std::get<0>(maxima[0]), std::get<1>(maxima[0]), std::get<2>(maxima[0]));
+  checkCluster(first, expectedCluster(clusterFirst));
+  BOOST_CHECK_EQUAL(int(first.maxChargePad), 0);
+  auto last = clusterFinder->buildCluster(std::get<0>(maxima[1]), std::get<1>(maxima[1]), std::get<2>(maxima[1]));
+  checkCluster(last, expectedCluster(clusterLast));
+  BOOST_CHECK_EQUAL(int(last.maxChargePad), padsInRow(row) - 1);
+}
+
+/// \brief Clusters at the first row of the sector and at the first row of an OROC
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_rowEdges)
+{
+  const std::vector<KrCharge> clusterFirstRow{
+    {0, 5, 400, 90.f},
+    {1, 5, 400, 45.f},
+    {0, 6, 400, 25.f}};
+  // the charge in the last row of the IROC is not part of the cluster of the OROC
+  const std::vector<KrCharge> clusterOROC{
+    {63, 0, 500, 85.f},
+    {64, 0, 500, 30.f},
+    {63, 0, 501, 20.f}};
+  auto charges = clusterFirstRow;
+  charges.insert(charges.end(), clusterOROC.begin(), clusterOROC.end());
+  charges.push_back({62, 0, 500, 8.f});
+
+  auto clusterFinder = createClusterFinder(charges);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 2);
+  BOOST_CHECK_EQUAL(std::get<1>(maxima[0]), 0);
+  BOOST_CHECK_EQUAL(std::get<1>(maxima[1]), 63);
+  checkCluster(clusterFinder->buildCluster(std::get<0>(maxima[0]), std::get<1>(maxima[0]), std::get<2>(maxima[0])), expectedCluster(clusterFirstRow));
+  checkCluster(clusterFinder->buildCluster(std::get<0>(maxima[1]), std::get<1>(maxima[1]), std::get<2>(maxima[1])), expectedCluster(clusterOROC));
+}
+
+/// \brief Clusters at the first and last time bin, and clusters built out of order
+/// so that the time bins around them have to be loaded again
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_timeEdges)
+{
+  const std::vector<KrCharge> clusterFirstTime{
+    {40, 0, 0, 60.f},
+    {40, 0, 1, 30.f},
+    {40, 1, 0, 12.f}};
+  const std::vector<KrCharge> clusterMiddle{
+    {40, 10, 2, 55.f},
+    {40, 10, 3, 25.f},
+    {40, 11, 2, 0.f}};
+  const std::vector<KrCharge> clusterLastTime{
+    {50, 0, 19999, 75.f},
+    {50, 0, 19998, 35.f},
+    {51, 0, 19999, 18.f}};
+  std::vector<KrCharge> charges;
+  for (const auto* cluster : {&clusterFirstTime, &clusterMiddle, &clusterLastTime}) {
+    charges.insert(charges.end(), cluster->begin(), cluster->end());
+  }
+  // beyond the last time bin, not filled
+  charges.push_back({50, 0, 20000, 500.f});
+
+  auto clusterFinder = createClusterFinder(charges);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 3);
+  BOOST_CHECK_EQUAL(std::get<2>(maxima[0]), 0);
+  BOOST_CHECK_EQUAL(std::get<2>(maxima[1]), 2);
+  BOOST_CHECK_EQUAL(std::get<2>(maxima[2]), 19999);
+
+  auto build = [&clusterFinder](const std::tuple<int, int, int>& maximum) {
+    return clusterFinder->buildCluster(std::get<0>(maximum), std::get<1>(maximum), std::get<2>(maximum));
+  };
+  checkCluster(build(maxima[2]), expectedCluster(clusterLastTime));
+  checkCluster(build(maxima[0]), expectedCluster(clusterFirstTime));
+  // the zero charge is not part of the cluster
+  checkCluster(build(maxima[1]), expectedCluster({clusterMiddle[0], clusterMiddle[1]}));
+  checkCluster(build(maxima[0]), expectedCluster(clusterFirstTime));
+}
+
+/// \brief The last value filled for a position is kept, also after resetting the map
+BOOST_AUTO_TEST_CASE(KrBoxClusterFinder_duplicateDigits)
+{
+  const std::vector<KrCharge> first{
+    {70, 2, 600, 70.f},
+    {70, 3, 600, 20.f}};
+  const std::vector<KrCharge> second{
+    {70, 2, 600, 90.f},
+    {70, 3, 600, 30.f},
+    {70, 2, 601, 10.f}};
+  auto charges = first;
+  charges.insert(charges.end(), second.begin(), second.end());
+
+  auto clusterFinder = createClusterFinder(charges);
+  auto maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 1);
+  checkCluster(clusterFinder->buildCluster(std::get<0>(maxima[0]), std::get<1>(maxima[0]), std::get<2>(maxima[0])), expectedCluster(second));
+
+  // after the reset only the new digits are used, using the Digit interface
+  std::vector<Digit> digits;
+  for (const auto& charge : first) {
+    digits.emplace_back(0, charge.q, charge.row, padInRow(charge.row, charge.padFromCenter), charge.time);
+  }
+  clusterFinder->fillAndCorrectMap(digits, 0);
+  maxima = clusterFinder->findLocalMaxima();
+  BOOST_REQUIRE_EQUAL(maxima.size(), 1);
+  checkCluster(clusterFinder->buildCluster(std::get<0>(maxima[0]), std::get<1>(maxima[0]), std::get<2>(maxima[0])), expectedCluster(first));
+}
+
+} // namespace tpc
+} // namespace o2
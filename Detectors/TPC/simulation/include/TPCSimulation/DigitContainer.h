@@ -76,6 +76,14 @@ class DigitContainer
   /// \param finalFlush Flag whether the whole container is dumped
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
 
+  /// Merge the time bins of another container, which are written out by the next call to fillOutputContainer,
+  /// into this container and remove them from the other one
+  /// \param other Container filled in parallel to this one, with the same start time
+  /// \param eventTimeBin time stamp of the event
+  /// \param isContinuous Switch for continuous readout
+  /// \param finalFlush Flag whether the whole container is dumped
+  void mergeTimeBins(DigitContainer& other, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
+
   /// Get the size of the container for one event
   size_t size() const { return mTimeBins.size(); }
 
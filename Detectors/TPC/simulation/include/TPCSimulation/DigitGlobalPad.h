@@ -65,6 +65,13 @@ class DigitGlobalPad
   void addDigit(const MCCompLabel& label, float signal,
                 o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>&);
 
+  /// Add the charge and the MC labels of the same pad in another container, filled in parallel
+  /// \param other Pad to be merged
+  /// \param labels Label container of the time bin of this pad
+  /// \param otherLabels Label container of the time bin of the other pad
+  void merge(DigitGlobalPad& other, o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels,
+             o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& otherLabels);
+
   void setID(int id) { mID = id; }
   int getID() const { return mID; }
 
@@ -89,18 +96,40 @@ class DigitGlobalPad
   /// \return true, if trackID, eventID and sourceID are the same
   bool compareMClabels(const MCCompLabel& label1, const MCCompLabel& label2) const;
 
+  /// Add a MC label to this pad, or increase its number of occurrences if it is already known
+  /// \param label MC label
+  /// \param nOccurrences Number of occurrences of the label
+  void addLabel(const MCCompLabel& label, int nOccurrences,
+                o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels);
+
   float mChargePad = 0.; ///< Total accumulated charge on that GlobalPad for a given time bin
   int mID = -1;          ///< ID of this digit to refer into labels (-1 means not initialized)
 };
 
 inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
                                      o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels)
+{
+  addLabel(label, 1, labels);
+  mChargePad += signal;
+}
+
+inline void DigitGlobalPad::merge(DigitGlobalPad& other, o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels,
+                                  o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& otherLabels)
+{
+  for (auto& mcLabel : otherLabels.getLabels(other.mID)) {
+    addLabel(mcLabel.first, mcLabel.second, labels);
+  }
+  mChargePad += other.mChargePad;
+}
+
+inline void DigitGlobalPad::addLabel(const MCCompLabel& label, int nOccurrences,
+                                     o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false>& labels)
 {
   bool isKnown = false;
   auto view = labels.getLabels(mID);
   for (auto& mcLabel : view) {
     if (compareMClabels(label, mcLabel.first)) {
-      ++mcLabel.second;
+      mcLabel.second += nOccurrences;
       isKnown = true;
       break;
     }
@@ -108,10 +137,9 @@ inline void DigitGlobalPad::addDigit(const MCCompLabel& label, float signal,
 
   //
   if (!isKnown) {
-    std::pair<MCCompLabel, int> newlabel(label, 1);
+    std::pair<MCCompLabel, int> newlabel(label, nOccurrences);
     labels.addLabel(mID, newlabel);
   }
-  mChargePad += signal;
 }
 
 inline void DigitGlobalPad::reset()
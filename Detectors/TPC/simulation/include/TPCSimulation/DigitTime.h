@@ -64,6 +64,10 @@ class DigitTime
   /// \param signal Charge of the digit in ADC counts
   void addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal);
 
+  /// Add the digits of the same time bin in another container, filled in parallel
+  /// \param other Time bin to be merged
+  void merge(DigitTime& other);
+
   /// Fill output vector
   /// \param output Output container
   /// \param mcTruth MC Truth container
@@ -102,6 +106,27 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
   mCommonMode[cru.gemStack()] += signal;
 }
 
+inline void DigitTime::merge(DigitTime& other)
+{
+  if (other.mDigitCounter == 0) {
+    return;
+  }
+  for (size_t globalPad = 0; globalPad < mGlobalPads.size(); ++globalPad) {
+    auto& otherPad = other.mGlobalPads[globalPad];
+    if (otherPad.getID() == -1) {
+      continue;
+    }
+    auto& paddigit = mGlobalPads[globalPad];
+    if (paddigit.getID() == -1) {
+      paddigit.setID(mDigitCounter++);
+    }
+    paddigit.merge(otherPad, mLabels, other.mLabels);
+  }
+  for (size_t i = 0; i < mCommonMode.size(); ++i) {
+    mCommonMode[i] += other.mCommonMode[i];
+  }
+}
+
 inline void DigitTime::reset()
 {
   for (auto& pad : mGlobalPads) {
@@ -16,6 +16,8 @@
 #define ALICEO2_TPC_Digitizer_H_
 
 #include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
 #include "TPCSimulation/PadResponse.h"
 #include "TPCSimulation/Point.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
@@ -23,6 +25,8 @@
 #include "TPCBase/Mapper.h"
 
 #include <cmath>
+#include <memory>
+#include <vector>
 
 using std::vector;
 
@@ -48,6 +52,8 @@ class DigitContainer;
 /// The such created Digits and then sorted in an intermediate Container (DigitContainer) and after processing of the
 /// full event/drift time summed up
 /// and sorted as Digits into a vector which is then passed further on
+/// With more than one thread, the hit groups are shared among the threads, each of them with its own DigitContainer,
+/// and the containers are merged when the Digits are written out
 
 class Digitizer
 {
@@ -88,11 +94,27 @@ class Digitizer
   {
     mSector = sec;
     mDigitContainer.reset();
+    for (auto& thread : mThreads) {
+      thread.digitContainer.reset();
+    }
   }
 
   /// Set the start time of the first event
   /// \param time Time of the first event
-  void setStartTime(TimeBin time) { mDigitContainer.setStartTime(time); }
+  void setStartTime(TimeBin time)
+  {
+    mDigitContainer.setStartTime(time);
+    for (auto& thread : mThreads) {
+      thread.digitContainer.setStartTime(time);
+    }
+  }
+
+  /// Set the number of threads used to process the hits, only effective with OpenMP
+  /// \param nThreads Number of threads
+  void setNThreads(int nThreads);
+
+  /// Get the number of threads used to process the hits
+  int getNThreads() const { return mThreads.empty() ? 1 : static_cast<int>(mThreads.size()); }
 
   /// Set the time of the event to be processed
   /// \param time Time of the event
@@ -122,7 +144,28 @@ class Digitizer
   void setUseSCDistortions(TFile& finp);
 
  private:
+  /// Containers and random number generators of each thread, if more than one is used
+  struct ThreadData {
+    DigitContainer digitContainer;                        ///< Container for the Digits of this thread
+    std::unique_ptr<ElectronTransport> electronTransport; ///< Electron transport with its own random numbers
+    std::unique_ptr<GEMAmplification> gemAmplification;  ///< GEM amplification with its own random numbers
+  };
+
+  /// Process a single hit group
+  /// \param hitGroup Hit group to be processed
+  /// \param eventID ID of the event to be processed
+  /// \param sourceID ID of the source to be processed
+  /// \param digitContainer Container where the signals are added
+  /// \param electronTransport Electron transport of the thread
+  /// \param gemAmplification GEM amplification of the thread
+  /// \param signalArray Workspace for the shaped signal
+  /// \param maxEleTime Maximum drift time + hit time which can be processed
+  void processHitGroup(const o2::tpc::HitGroup& hitGroup, const int eventID, const int sourceID,
+                       DigitContainer& digitContainer, ElectronTransport& electronTransport,
+                       GEMAmplification& gemAmplification, std::vector<float>& signalArray, float maxEleTime);
+
   DigitContainer mDigitContainer;   ///< Container for the Digits
+  std::vector<ThreadData> mThreads; //! Data of the threads, empty with a single thread
   std::unique_ptr<SC> mSpaceCharge; ///< Handler of space-charge distortions
   Sector mSector = -1;              ///< ID of the currently processed sector
   float mEventTime = 0.f;           ///< Time of the currently processed event
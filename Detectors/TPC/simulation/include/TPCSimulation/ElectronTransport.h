@@ -71,6 +71,9 @@ class ElectronTransport
   float getDriftTime(float zPos, float signChange = 1.f) const;
 
  private:
+  /// The Digitizer creates one instance per additional thread in the parallel mode
+  friend class Digitizer;
+
   ElectronTransport();
 
   /// Circular random buffer containing random values of the Gauss distribution to take into account diffusion of the
@@ -89,6 +89,9 @@ class GEMAmplification
   int getGEMMultiplication(int nElectrons, int GEM);
 
  private:
+  /// The Digitizer creates one instance per additional thread in the parallel mode
+  friend class Digitizer;
+
   GEMAmplification();
 
   /// Circular random buffer containing random Gaus values for gain fluctuation if the number of electrons is larger
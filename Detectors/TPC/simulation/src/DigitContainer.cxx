@@ -18,6 +18,9 @@
 #include "TPCBase/CDBInterface.h"
 #include "TPCBase/ParameterElectronics.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace o2::tpc;
 
 void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
@@ -66,3 +69,22 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     }
   }
 }
+
+void DigitContainer::mergeTimeBins(DigitContainer& other, TimeBin eventTimeBin, bool isContinuous, bool finalFlush)
+{
+  /// same time bins as written out by fillOutputContainer, all of them in the triggered mode
+  size_t nFlushedTimeBins = std::numeric_limits<size_t>::max();
+  if (isContinuous && !finalFlush) {
+    nFlushedTimeBins = eventTimeBin > mFirstTimeBin ? eventTimeBin - mFirstTimeBin : 0;
+  }
+  const size_t nTimeBins = std::min(other.mTimeBins.size(), nFlushedTimeBins);
+  if (mTimeBins.size() < nTimeBins) {
+    mTimeBins.resize(nTimeBins);
+  }
+  for (size_t i = 0; i < nTimeBins; ++i) {
+    mTimeBins[i].merge(other.mTimeBins[i]);
+  }
+  /// keep the other container aligned with this one, which may flush more (empty) time bins
+  other.mFirstTimeBin += std::min(mTimeBins.size(), nFlushedTimeBins);
+  other.mTimeBins.erase(other.mTimeBins.begin(), other.mTimeBins.begin() + nTimeBins);
+}
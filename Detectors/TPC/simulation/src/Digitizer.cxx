@@ -30,6 +30,12 @@
 
 #include "FairLogger.h"
 
+#include <algorithm>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 ClassImp(o2::tpc::Digitizer);
 
 using namespace o2::tpc;
@@ -47,10 +53,7 @@ void Digitizer::init()
 void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
                         const int eventID, const int sourceID)
 {
-  const static Mapper& mapper = Mapper::instance();
-  auto& detParam = ParameterDetector::Instance();
   auto& eleParam = ParameterElectronics::Instance();
-  auto& gemParam = ParameterGEM::Instance();
 
   static GEMAmplification& gemAmplification = GEMAmplification::instance();
   gemAmplification.updateParameters();
@@ -60,98 +63,144 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
   sampaProcessing.updateParameters();
 
   const int nShapedPoints = eleParam.NShapedPoints;
-  const auto amplificationMode = gemParam.AmplMode;
   static std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
-  mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime));
+  const TimeBin eventTimeBin = sampaProcessing.getTimeBinFromTime(mEventTime);
+  mDigitContainer.reserve(eventTimeBin);
 
   /// obtain max drift_time + hitTime which can be processed
   float maxEleTime = (int(mDigitContainer.size()) - nShapedPoints) * eleParam.ZbinWidth;
 
-  for (auto& hitGroup : hits) {
-    const int MCTrackID = hitGroup.GetTrackID();
-    for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
-      const auto& eh = hitGroup.getHit(hitindex);
+  int nThreads = getNThreads();
+  if (mUseSCDistortions) {
+    /// the interpolation of the distortions has buffers for a limited number of threads
+    nThreads = std::min(nThreads, SC::getNThreads());
+  }
+
+  if (nThreads == 1) {
+    for (auto& hitGroup : hits) {
+      processHitGroup(hitGroup, eventID, sourceID, mDigitContainer, electronTransport, gemAmplification, signalArray, maxEleTime);
+    }
+    return;
+  }
+
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    auto& thread = mThreads[iThread];
+    thread.electronTransport->updateParameters();
+    thread.gemAmplification->updateParameters();
+    thread.digitContainer.reserve(eventTimeBin);
+    maxEleTime = std::min(maxEleTime, (int(thread.digitContainer.size()) - nShapedPoints) * eleParam.ZbinWidth);
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(nThreads)
+  {
+    auto& thread = mThreads[omp_get_thread_num()];
+    std::vector<float> threadSignalArray(nShapedPoints);
+    // a static schedule always gives the same hit groups to the same random numbers
+#pragma omp for schedule(static)
+    for (size_t iHitGroup = 0; iHitGroup < hits.size(); ++iHitGroup) {
+      processHitGroup(hits[iHitGroup], eventID, sourceID, thread.digitContainer, *thread.electronTransport, *thread.gemAmplification, threadSignalArray, maxEleTime);
+    }
+  }
+#endif
+}
+
+void Digitizer::processHitGroup(const o2::tpc::HitGroup& hitGroup, const int eventID, const int sourceID,
+                                DigitContainer& digitContainer, ElectronTransport& electronTransport,
+                                GEMAmplification& gemAmplification, std::vector<float>& signalArray, float maxEleTime)
+{
+  const static Mapper& mapper = Mapper::instance();
+  auto& detParam = ParameterDetector::Instance();
+  auto& eleParam = ParameterElectronics::Instance();
+  auto& gemParam = ParameterGEM::Instance();
+  static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+
+  const int nShapedPoints = eleParam.NShapedPoints;
+  const auto amplificationMode = gemParam.AmplMode;
+
+  const int MCTrackID = hitGroup.GetTrackID();
+  for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
+    const auto& eh = hitGroup.getHit(hitindex);
+
+    GlobalPosition3D posEle(eh.GetX(), eh.GetY(), eh.GetZ());
 
-      GlobalPosition3D posEle(eh.GetX(), eh.GetY(), eh.GetZ());
+    // Distort the electron position in case space-charge distortions are used
+    if (mUseSCDistortions) {
+      mSpaceCharge->distortElectron(posEle);
+    }
+
+    /// Remove electrons that end up more than three sigma of the hit's average diffusion away from the current sector
+    /// boundary
+    if (electronTransport.isCompletelyOutOfSectorCoarseElectronDrift(posEle, mSector)) {
+      continue;
+    }
+
+    /// The energy loss stored corresponds to nElectrons
+    const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
+    const float hitTime = eh.GetTime() * 0.001; /// in us
+    float driftTime = 0.f;
 
-      // Distort the electron position in case space-charge distortions are used
-      if (mUseSCDistortions) {
-        mSpaceCharge->distortElectron(posEle);
+    /// TODO: add primary ions to space-charge density
+
+    /// Loop over electrons
+    for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
+
+      /// Drift and Diffusion
+      const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
+      const float eleTime = driftTime + hitTime; /// in us
+      if (eleTime > maxEleTime) {
+        LOG(WARNING) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
+        continue;
       }
+      const float absoluteTime = eleTime + mEventTime; /// in us
 
-      /// Remove electrons that end up more than three sigma of the hit's average diffusion away from the current sector
-      /// boundary
-      if (electronTransport.isCompletelyOutOfSectorCoarseElectronDrift(posEle, mSector)) {
+      /// Attachment
+      if (electronTransport.isElectronAttachment(driftTime)) {
         continue;
       }
 
-      /// The energy loss stored corresponds to nElectrons
-      const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
-      const float hitTime = eh.GetTime() * 0.001; /// in us
-      float driftTime = 0.f;
-
-      /// TODO: add primary ions to space-charge density
-
-      /// Loop over electrons
-      for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
-
-        /// Drift and Diffusion
-        const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
-        const float eleTime = driftTime + hitTime; /// in us
-        if (eleTime > maxEleTime) {
-          LOG(WARNING) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
-          continue;
-        }
-        const float absoluteTime = eleTime + mEventTime; /// in us
-
-        /// Attachment
-        if (electronTransport.isElectronAttachment(driftTime)) {
-          continue;
-        }
-
-        /// Remove electrons that end up outside the active volume
-        if (std::abs(posEleDiff.Z()) > detParam.TPClength) {
-          continue;
-        }
-
-        /// When the electron is not in the sector we're processing, abandon
-        if (mapper.isOutOfSector(posEleDiff, mSector)) {
-          continue;
-        }
-
-        /// Compute digit position and check for validity
-        const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
-        if (!digiPadPos.isValid()) {
-          continue;
-        }
-
-        /// Remove digits the end up outside the currently produced sector
-        if (digiPadPos.getCRU().sector() != mSector) {
-          continue;
-        }
-
-        /// Electron amplification
-        const int nElectronsGEM = gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
-        if (nElectronsGEM == 0) {
-          continue;
-        }
-
-        const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
-        const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
-        const MCCompLabel label(MCTrackID, eventID, sourceID, false);
-        sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
-        for (float i = 0; i < nShapedPoints; ++i) {
-          const float time = absoluteTime + i * eleParam.ZbinWidth;
-          mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
-                                   signalArray[i]);
-        }
-        /// TODO: add ion backflow to space-charge density
+      /// Remove electrons that end up outside the active volume
+      if (std::abs(posEleDiff.Z()) > detParam.TPClength) {
+        continue;
       }
-      /// end of loop over electrons
+
+      /// When the electron is not in the sector we're processing, abandon
+      if (mapper.isOutOfSector(posEleDiff, mSector)) {
+        continue;
+      }
+
+      /// Compute digit position and check for validity
+      const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
+      if (!digiPadPos.isValid()) {
+        continue;
+      }
+
+      /// Remove digits the end up outside the currently produced sector
+      if (digiPadPos.getCRU().sector() != mSector) {
+        continue;
+      }
+
+      /// Electron amplification
+      const int nElectronsGEM = gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
+      if (nElectronsGEM == 0) {
+        continue;
+      }
+
+      const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
+      const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
+      const MCCompLabel label(MCTrackID, eventID, sourceID, false);
+      sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
+      for (float i = 0; i < nShapedPoints; ++i) {
+        const float time = absoluteTime + i * eleParam.ZbinWidth;
+        digitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
+                                signalArray[i]);
+      }
+      /// TODO: add ion backflow to space-charge density
     }
+    /// end of loop over electrons
   }
 }
 
@@ -161,7 +210,31 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
                       bool finalFlush)
 {
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
-  mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime), mIsContinuous, finalFlush);
+  const TimeBin eventTimeBin = sampaProcessing.getTimeBinFromTime(mEventTime);
+  for (auto& thread : mThreads) {
+    mDigitContainer.mergeTimeBins(thread.digitContainer, eventTimeBin, mIsContinuous, finalFlush);
+  }
+  mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, eventTimeBin, mIsContinuous, finalFlush);
+}
+
+void Digitizer::setNThreads(int nThreads)
+{
+#ifdef WITH_OPENMP
+  nThreads = std::max(1, nThreads);
+#else
+  if (nThreads > 1) {
+    LOG(WARNING) << "TPC digitizer compiled without OpenMP, using a single thread";
+  }
+  nThreads = 1;
+#endif
+  // a single thread uses the common containers and random numbers
+  mThreads.resize(nThreads > 1 ? nThreads : 0);
+  for (auto& thread : mThreads) {
+    if (!thread.electronTransport) {
+      thread.electronTransport.reset(new ElectronTransport());
+      thread.gemAmplification.reset(new GEMAmplification());
+    }
+  }
 }
 
 void Digitizer::setUseSCDistortions(SC::SCDistortionType distortionType, const TH3* hisInitialSCDensity)
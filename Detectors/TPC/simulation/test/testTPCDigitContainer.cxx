@@ -166,5 +166,73 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the merging of DigitContainers
+/// The same values as in DigitContainer_test2 are shared between two DigitContainers, as done by the threads of the
+/// Digitizer, and we check that the merged container gives the same charge and MC labels
+BOOST_AUTO_TEST_CASE(DigitContainer_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString("TPCEleParam.DigiMode=3"); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer digitContainer;
+  DigitContainer digitContainerThread;
+  digitContainer.reset();
+  digitContainerThread.reset();
+  dataformats::MCTruthContainer<MCCompLabel> mMCTruthArray;
+
+  // MC labels to add to each voxel
+  const std::vector<int> MCevent = {1, 62, 1, 62, 62, 50, 62, 1, 1, 1};
+  const std::vector<int> MCtrack = {22, 3, 22, 3, 3, 70, 3, 7, 7, 7};
+
+  // voxel definitions
+  const std::vector<int> cru = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const std::vector<int> Time = {231, 231, 231, 231, 231, 231, 231, 231, 231, 231};
+  const std::vector<int> Row = {11, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+  const std::vector<int> Pad = {15, 15, 15, 15, 15, 15, 15, 15, 15, 15};
+  const std::vector<int> nEle = {60, 1, 252, 10, 2, 3, 5, 25, 24, 23};
+
+  const std::vector<int> MCeventSorted = {62, 1, 1, 50};
+  const std::vector<int> MCtrackSorted = {3, 7, 22, 70};
+
+  for (int i = 0; i < cru.size(); ++i) {
+    const CRU c(cru[i]);
+    const DigitPos digiPadPos(c, PadPos(Row[i], Pad[i]));
+    const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
+
+    // every second label goes to the container of the other thread
+    for (int j = 0; j < MCevent.size(); ++j) {
+      auto& container = (j % 2) ? digitContainerThread : digitContainer;
+      container.addDigit(MCCompLabel(MCtrack[j], MCevent[j], 0, false), cru[i], Time[i], globalPad, nEle[i]);
+    }
+  }
+
+  digitContainer.mergeTimeBins(digitContainerThread, 0, true, true);
+
+  std::vector<Digit> mDigitsArray;
+  std::vector<o2::tpc::CommonMode> commonMode;
+  digitContainer.fillOutputContainer(mDigitsArray, mMCTruthArray, commonMode, 0, 0, true, true);
+
+  BOOST_CHECK(mDigitsArray.size() == cru.size());
+
+  int digits = 0;
+  for (const auto& digit : mDigitsArray) {
+    const auto& mcArray = mMCTruthArray.getLabels(digits);
+    BOOST_CHECK(mcArray.size() == MCtrackSorted.size());
+    for (int j = 0; j < static_cast<int>(mcArray.size()); ++j) {
+      BOOST_CHECK(mcArray[j].getTrackID() == MCtrackSorted[j]);
+      BOOST_CHECK(mcArray[j].getEventID() == MCeventSorted[j]);
+    }
+
+    BOOST_CHECK(digit.getCRU() == cru[digits]);
+    BOOST_CHECK(digit.getTimeStamp() == Time[digits]);
+    BOOST_CHECK_CLOSE(digit.getChargeFloat(), nEle[digits] * MCevent.size(), 1E-6);
+    ++digits;
+  }
+
+  // all time bins of the other container have been moved
+  BOOST_CHECK(digitContainerThread.size() == 0);
+}
 } // namespace tpc
 } // namespace o2
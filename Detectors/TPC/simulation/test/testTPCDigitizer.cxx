@@ -0,0 +1,100 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCDigitizer.cxx
+/// \brief This task tests the reproducibility of the multi-threaded TPC digitization
+
+#define BOOST_TEST_MODULE Test TPC Digitizer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "TRandom.h"
+#include "DataFormatsTPC/Digit.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/Point.h"
+#include "TPCBase/CDBInterface.h"
+#include "CommonUtils/ConfigurableParam.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+/// Hit groups of straight tracks crossing sector 0 at different z
+std::vector<HitGroup> createHits()
+{
+  std::vector<HitGroup> hits;
+  for (int iTrack = 0; iTrack < 40; ++iTrack) {
+    HitGroup group(iTrack);
+    const float phi = (1.f + 0.4f * iTrack) * M_PI / 180.f;
+    const float z = 10.f + 5.f * iTrack;
+    for (float r = 90.f; r < 240.f; r += 10.f) {
+      group.addHit(r * std::cos(phi), r * std::sin(phi), z, 0.f, 30);
+    }
+    hits.emplace_back(std::move(group));
+  }
+  return hits;
+}
+
+/// Digitize the hits in sector 0 with a fresh digitizer using nThreads threads
+std::vector<Digit> digitize(const std::vector<HitGroup>& hits, int nThreads)
+{
+  // the random numbers of the threads are drawn when the threads are set up
+  gRandom->SetSeed(1234);
+  Digitizer digitizer;
+  digitizer.setNThreads(nThreads);
+  digitizer.init();
+  digitizer.setStartTime(0);
+  digitizer.setEventTime(0.f);
+  digitizer.setSector(Sector(0));
+  digitizer.process(hits, 0);
+
+  std::vector<Digit> digits;
+  dataformats::MCTruthContainer<MCCompLabel> labels;
+  std::vector<CommonMode> commonMode;
+  digitizer.flush(digits, labels, commonMode, true);
+  return digits;
+}
+
+/// \brief The multi-threaded digitization gives the same digits every time it is run
+BOOST_AUTO_TEST_CASE(Digitizer_multiThreadReproducible)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  // propagate the ADC values, the noise is not drawn from the random numbers of the digitizer
+  o2::conf::ConfigurableParam::updateFromString("TPCEleParam.DigiMode=3");
+
+  // without OpenMP a single thread uses the common random numbers, which go on from run to run
+  Digitizer probe;
+  probe.setNThreads(4);
+  if (probe.getNThreads() == 1) {
+    BOOST_TEST_MESSAGE("TPC digitizer compiled without OpenMP, nothing to compare");
+    return;
+  }
+
+  const auto hits = createHits();
+  const auto digits1 = digitize(hits, 4);
+  const auto digits2 = digitize(hits, 4);
+
+  BOOST_CHECK(!digits1.empty());
+  BOOST_REQUIRE_EQUAL(digits1.size(), digits2.size());
+  for (size_t i = 0; i < digits1.size(); ++i) {
+    BOOST_CHECK_EQUAL(digits1[i].getCRU(), digits2[i].getCRU());
+    BOOST_CHECK_EQUAL(digits1[i].getRow(), digits2[i].getRow());
+    BOOST_CHECK_EQUAL(digits1[i].getPad(), digits2[i].getPad());
+    BOOST_CHECK_EQUAL(digits1[i].getTimeStamp(), digits2[i].getTimeStamp());
+    BOOST_CHECK_EQUAL(digits1[i].getChargeFloat(), digits2[i].getChargeFloat());
+  }
+}
+
+} // namespace tpc
+} // namespace o2
@@ -9,6 +9,7 @@
 // or submit itself to any jurisdiction.
 
 #include "AODJAlienReaderHelpers.h"
+#include "DataFrameReadAhead.h"
 #include "Framework/TableTreeHelpers.h"
 #include "Framework/AnalysisHelpers.h"
 #include "Framework/RootTableBuilderHelpers.h"
@@ -23,6 +24,7 @@
 #include "Framework/DataInputDirector.h"
 #include "Framework/SourceInfoHeader.h"
 #include "Framework/ChannelInfo.h"
+#include "Framework/ComputingQuotaEvaluator.h"
 #include "Framework/Logger.h"
 
 #if __has_include(<TJAlienFile.h>)
@@ -30,6 +32,7 @@
 #endif
 #include <TGrid.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTreeCache.h>
 
 #include <arrow/ipc/reader.h>
@@ -38,7 +41,6 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
-#include <thread>
 
 using namespace o2;
 using namespace o2::aod;
@@ -131,10 +133,10 @@ static inline auto extractOriginalsTuple(framework::pack<Os...>, ProcessingConte
   return std::make_tuple(extractTypedOriginal<Os>(pc)...);
 }
 
-void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead)
+std::string AODJAlienReaderHelpers::fileMetricsInfo(TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead)
 {
   if (currentFile == nullptr) {
-    return;
+    return "";
   }
   std::string monitoringInfo(fmt::format("lfn={},size={},total_tf={},read_tf={},read_bytes={},read_calls={},io_time={:.1f},wait_time={:.1f}", currentFile->GetName(),
                                          currentFile->GetSize(), tfPerFile, tfRead, currentFile->GetBytesRead(), currentFile->GetReadCalls(),
@@ -145,10 +147,189 @@ void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* curr
     monitoringInfo += fmt::format(",se={},open_time={:.1f}", alienFile->GetSE(), alienFile->GetElapsed());
   }
 #endif
+  return monitoringInfo;
+}
+
+void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, std::string const& monitoringInfo)
+{
+  if (monitoringInfo.empty()) {
+    return;
+  }
   monitoring.send(Metric{monitoringInfo, "aod-file-read-info"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
   LOGP(INFO, "Read info: {}", monitoringInfo);
 }
 
+namespace
+{
+/// Size of the buffers of a table read from an Arrow IPC file
+size_t arrayDataSize(arrow::ArrayData const& data)
+{
+  size_t size = 0;
+  for (auto const& buffer : data.buffers) {
+    if (buffer) {
+      size += buffer->size();
+    }
+  }
+  for (auto const& child : data.child_data) {
+    size += arrayDataSize(*child);
+  }
+  return size;
+}
+
+size_t tableBufferSize(arrow::Table const& table)
+{
+  size_t size = 0;
+  for (auto const& column : table.columns()) {
+    for (auto const& chunk : column->chunks()) {
+      size += arrayDataSize(*chunk->data());
+    }
+  }
+  return size;
+}
+
+/// Reads the dataframes of the input files one after the other.
+/// Each parallel reader device.inputTimesliceId reads the files
+/// k*device.maxInputTimeslices+device.inputTimesliceId.
+class DataFrameReader
+{
+ public:
+  DataFrameReader(std::shared_ptr<DataInputDirector> didir, std::vector<OutputRoute> requestedTables, int firstFile, int fileStep)
+    : mDidir{std::move(didir)},
+      mRequestedTables{std::move(requestedTables)},
+      mFileCounter{firstFile},
+      mFileStep{fileStep}
+  {
+  }
+
+  /// Read the dataframe following the last one read
+  DataFrame next()
+  {
+    DataFrame frame;
+    auto ioStart = uv_hrtime();
+    int fcnt = mFileCounter;
+    int ntf = mNumTF + 1;
+
+    // loop over requested tables
+    bool first = true;
+    for (auto& route : mRequestedTables) {
+
+      // create header
+      auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+      auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+
+      // the tables of an arrow input are read as they are
+      TTree* tr = nullptr;
+      std::shared_ptr<arrow::Table> table;
+      size_t fileSize = 0;
+      auto readTable = [&]() {
+        if (mDidir->isArrowFile(dh, fcnt)) {
+          fileSize = 0;
+          table = mDidir->getArrowTable(dh, fcnt, ntf, &fileSize);
+          return table != nullptr;
+        }
+        tr = mDidir->getDataTree(dh, fcnt, ntf);
+        return tr != nullptr;
+      };
+
+      if (!readTable()) {
+        if (first) {
+          // metrics of file which is done for reading
+          frame.closedFileInfo = currentFileInfo(ntf);
+          mCurrentFile = nullptr;
+          mCurrentFileStartedAt = uv_hrtime();
+          mCurrentFileIOTime = 0;
+
+          // check if there is a next file to read
+          fcnt += mFileStep;
+          if (mDidir->atEnd(fcnt)) {
+            frame.endOfInput = true;
+            return frame;
+          }
+          // get first folder of next file
+          ntf = 0;
+          if (!readTable()) {
+            LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
+            throw std::runtime_error("Processing is stopped!");
+          }
+        } else {
+          LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
+          throw std::runtime_error("Processing is stopped!");
+        }
+      }
+
+      if (first) {
+        frame.timeFrameNumber = mDidir->getTimeFrameNumber(dh, fcnt, ntf);
+      }
+
+      if (table) {
+        // the IPC files are compressed, if at all, on disk
+        frame.sizeCompressed += fileSize;
+        frame.sizeUncompressed += tableBufferSize(*table);
+        frame.tables.emplace_back(dh, table);
+      } else {
+        // add branches to read
+        // fill the table
+        TreeToTable t2t;
+        auto colnames = getColumnNames(dh);
+        if (colnames.size() == 0) {
+          frame.sizeCompressed += tr->GetZipBytes();
+          frame.sizeUncompressed += tr->GetTotBytes();
+          t2t.addAllColumns(tr);
+        } else {
+          for (auto& colname : colnames) {
+            TBranch* branch = tr->GetBranch(colname.c_str());
+            frame.sizeCompressed += branch->GetZipBytes("*");
+            frame.sizeUncompressed += branch->GetTotBytes("*");
+            t2t.addColumn(colname.c_str());
+          }
+        }
+        t2t.fill(tr);
+        delete tr;
+        frame.tables.emplace_back(dh, t2t.finalize());
+      }
+
+      // needed for metrics dumping (upon next file read, or terminate due to watchdog)
+      if (mCurrentFile == nullptr) {
+        mCurrentFile = mDidir->getFileFolder(dh, fcnt, ntf).file;
+        mTFCurrentFile = mDidir->getTimeFramesInFile(dh, fcnt);
+      }
+
+      first = false;
+    }
+
+    // save file number and time frame
+    frame.fileCounter = fcnt;
+    frame.numTF = ntf;
+    mFileCounter = fcnt;
+    mNumTF = ntf;
+    mCurrentFileIOTime += (uv_hrtime() - ioStart);
+    return frame;
+  }
+
+  std::string currentFileInfo(int tfRead)
+  {
+    return AODJAlienReaderHelpers::fileMetricsInfo(mCurrentFile, mCurrentFileStartedAt, mCurrentFileIOTime, mTFCurrentFile, tfRead);
+  }
+
+  int lastTimeFrame() const { return mNumTF; }
+
+  void closeInputFiles() { mDidir->closeInputFiles(); }
+
+ private:
+  std::shared_ptr<DataInputDirector> mDidir;
+  std::vector<OutputRoute> mRequestedTables;
+  int mFileCounter;
+  int mFileStep;
+  int mNumTF = -1;
+
+  TFile* mCurrentFile = nullptr;
+  int mTFCurrentFile = -1;
+  uint64_t mCurrentFileStartedAt = uv_hrtime();
+  uint64_t mCurrentFileIOTime = 0;
+};
+
+} // namespace
+
 AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 {
   auto callback = AlgorithmSpec{adaptStateful([](ConfigParamRegistry const& options,
@@ -193,132 +374,90 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
-    auto fileCounter = std::make_shared<int>(0);
-    auto numTF = std::make_shared<int>(-1);
+    assert(spec.inputTimesliceId < spec.maxInputTimeslices);
+    auto reader = std::make_shared<DataFrameReader>(didir, requestedTables, spec.inputTimesliceId, spec.maxInputTimeslices);
+
+    // read the next dataframes in the background, if requested
+    std::shared_ptr<DataFrameReadAhead> readAhead;
+    auto readAheadDepth = options.get<int>("aod-read-ahead");
+    if (readAheadDepth > 0) {
+      ROOT::EnableThreadSafety();
+      readAhead = std::make_shared<DataFrameReadAhead>([reader]() { return reader->next(); }, readAheadDepth);
+    }
+
     return adaptStateless([TFNumberHeader,
-                           requestedTables,
-                           fileCounter,
-                           numTF,
-                           watchdog,
-                           didir](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
-      // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
-      // the TF to read is numTF
-      assert(device.inputTimesliceId < device.maxInputTimeslices);
-      uint64_t timeFrameNumber = 0;
-      int fcnt = (*fileCounter * device.maxInputTimeslices) + device.inputTimesliceId;
-      int ntf = *numTF + 1;
+                           reader,
+                           readAhead,
+                           watchdog](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device, ComputingQuotaEvaluator& quotaEvaluator) {
       static int currentFileCounter = -1;
       static int filesProcessed = 0;
-      if (currentFileCounter != *fileCounter) {
-        currentFileCounter = *fileCounter;
-        monitoring.send(Metric{(uint64_t)++filesProcessed, "files-opened"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
-      }
-
-      // loop over requested tables
-      bool first = true;
       static size_t totalSizeUncompressed = 0;
       static size_t totalSizeCompressed = 0;
-      static TFile* currentFile = nullptr;
-      static int tfCurrentFile = -1;
-      static auto currentFileStartedAt = uv_hrtime();
-      static uint64_t currentFileIOTime = 0;
 
       // check if RuntimeLimit is reached
       if (!watchdog->update()) {
         LOGP(INFO, "Run time exceeds run time limit of {} seconds. Exiting gracefully...", watchdog->runTimeLimit);
         LOGP(INFO, "Stopping reader {} after time frame {}.", device.inputTimesliceId, watchdog->numberTimeFrames - 1);
-        dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
+        if (readAhead) {
+          readAhead->stop();
+        }
+        dumpFileMetrics(monitoring, reader->currentFileInfo(reader->lastTimeFrame() + 1));
         monitoring.flushBuffer();
-        didir->closeInputFiles();
+        reader->closeInputFiles();
         control.endOfStream();
         control.readyToQuit(QuitRequest::Me);
         return;
       }
 
-      auto ioStart = uv_hrtime();
-
-      for (auto route : requestedTables) {
-
-        // create header
-        auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
-        auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
-
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
-          if (first) {
-            // dump metrics of file which is done for reading
-            dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
-            currentFile = nullptr;
-            currentFileStartedAt = uv_hrtime();
-            currentFileIOTime = 0;
-
-            // check if there is a next file to read
-            fcnt += device.maxInputTimeslices;
-            if (didir->atEnd(fcnt)) {
-              LOGP(INFO, "No input files left to read for reader {}!", device.inputTimesliceId);
-              didir->closeInputFiles();
-              control.endOfStream();
-              control.readyToQuit(QuitRequest::Me);
-              return;
-            }
-            // get first folder of next file
-            ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
-              LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
-              throw std::runtime_error("Processing is stopped!");
-            }
-          } else {
-            LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
-            throw std::runtime_error("Processing is stopped!");
+      DataFrame frame;
+      if (readAhead) {
+        // the dataframes read ahead are bounded by the shared memory we are
+        // offered. Without memory rate limiting nothing is offered, then
+        // only the read-ahead depth applies
+        int64_t offeredSharedMemory = 0;
+        for (auto& offer : quotaEvaluator.mOffers) {
+          if (offer.valid) {
+            offeredSharedMemory += offer.sharedMemory;
           }
         }
+        readAhead->setMemoryBudget(offeredSharedMemory > 0 ? offeredSharedMemory : DataFrameReadAhead::UnboundedMemory);
+        frame = readAhead->pop();
+      } else {
+        frame = reader->next();
+      }
 
-        if (first) {
-          timeFrameNumber = didir->getTimeFrameNumber(dh, fcnt, ntf);
-          auto o = Output(TFNumberHeader);
-          outputs.make<uint64_t>(o) = timeFrameNumber;
+      dumpFileMetrics(monitoring, frame.closedFileInfo);
+      if (frame.endOfInput) {
+        LOGP(INFO, "No input files left to read for reader {}!", device.inputTimesliceId);
+        if (readAhead) {
+          readAhead->stop();
         }
+        reader->closeInputFiles();
+        control.endOfStream();
+        control.readyToQuit(QuitRequest::Me);
+        return;
+      }
 
-        // create table output
-        auto o = Output(dh);
-        auto& t2t = outputs.make<TreeToTable>(o);
-
-        // add branches to read
-        // fill the table
-        auto colnames = getColumnNames(dh);
-        if (colnames.size() == 0) {
-          totalSizeCompressed += tr->GetZipBytes();
-          totalSizeUncompressed += tr->GetTotBytes();
-          t2t.addAllColumns(tr);
-        } else {
-          for (auto& colname : colnames) {
-            TBranch* branch = tr->GetBranch(colname.c_str());
-            totalSizeCompressed += branch->GetZipBytes("*");
-            totalSizeUncompressed += branch->GetTotBytes("*");
-            t2t.addColumn(colname.c_str());
-          }
-        }
-        t2t.fill(tr);
-        delete tr;
+      if (currentFileCounter != frame.fileCounter) {
+        currentFileCounter = frame.fileCounter;
+        monitoring.send(Metric{(uint64_t)++filesProcessed, "files-opened"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+      }
 
-        // needed for metrics dumping (upon next file read, or terminate due to watchdog)
-        if (currentFile == nullptr) {
-          currentFile = didir->getFileFolder(dh, fcnt, ntf).file;
-          tfCurrentFile = didir->getTimeFramesInFile(dh, fcnt);
-        }
+      if (!frame.tables.empty()) {
+        auto o = Output(TFNumberHeader);
+        outputs.make<uint64_t>(o) = frame.timeFrameNumber;
+      }
 
-        first = false;
+      // create table outputs
+      for (auto& [dh, table] : frame.tables) {
+        outputs.adopt(Output(dh), table);
       }
-      monitoring.send(Metric{(uint64_t)ntf, "tf-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+      totalSizeCompressed += frame.sizeCompressed;
+      totalSizeUncompressed += frame.sizeUncompressed;
+
+      monitoring.send(Metric{(uint64_t)frame.numTF, "tf-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
-
-      // save file number and time frame
-      *fileCounter = (fcnt - device.inputTimesliceId) / device.maxInputTimeslices;
-      *numTF = ntf;
-      currentFileIOTime += (uv_hrtime() - ioStart);
     });
   })};
 
@@ -0,0 +1,172 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_DATAFRAMEREADAHEAD_H_
+#define O2_FRAMEWORK_DATAFRAMEREADAHEAD_H_
+
+#include "Headers/DataHeader.h"
+#include "Framework/Logger.h"
+
+#include <arrow/type_fwd.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace o2::framework::readers
+{
+
+/// A dataframe (DF_ folder) read from the input files and converted
+/// to the requested tables, ready to be sent.
+struct DataFrame {
+  uint64_t timeFrameNumber = 0;
+  int fileCounter = 0;
+  int numTF = 0;
+  std::vector<std::pair<header::DataHeader, std::shared_ptr<arrow::Table>>> tables;
+  size_t sizeCompressed = 0;
+  size_t sizeUncompressed = 0;
+  // metrics of the input file which was completed before this dataframe
+  std::string closedFileInfo;
+  // no input files left to read, tables is empty
+  bool endOfInput = false;
+};
+
+/// Reads the next dataframes on a background thread, while the
+/// current one is processed downstream. At most depth dataframes are
+/// kept ready. Since all of them end up in shared memory once sent,
+/// their size is also bounded by the shared memory offered to the reader,
+/// if any is offered. All the I/O of the reader happens on the background
+/// thread.
+class DataFrameReadAhead
+{
+ public:
+  /// A negative memory budget means that no shared memory is offered,
+  /// hence only the depth limits the dataframes read ahead
+  static constexpr int64_t UnboundedMemory = -1;
+
+  DataFrameReadAhead(std::function<DataFrame()> next, size_t depth)
+    : mNext{std::move(next)},
+      mDepth{depth}
+  {
+    mThread = std::thread([this]() { run(); });
+  }
+
+  ~DataFrameReadAhead()
+  {
+    stop();
+  }
+
+  /// Update the shared memory currently offered to the reader
+  void setMemoryBudget(int64_t budget)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMemoryBudget = budget;
+    mCondition.notify_all();
+  }
+
+  /// Wait for the next dataframe to be ready
+  DataFrame pop()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() { return !mFrames.empty() || mError; });
+    if (mFrames.empty()) {
+      std::rethrow_exception(mError);
+    }
+    DataFrame frame = std::move(mFrames.front());
+    mFrames.pop_front();
+    mQueuedBytes -= frame.sizeUncompressed;
+    mCondition.notify_all();
+    return frame;
+  }
+
+  /// Number of dataframes which are ready to be popped
+  size_t ready()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFrames.size();
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+      mCondition.notify_all();
+    }
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+ private:
+  bool withinMemoryBudget() const
+  {
+    return mMemoryBudget < 0 || (int64_t)mQueuedBytes < mMemoryBudget;
+  }
+
+  void run()
+  {
+    while (true) {
+      {
+        // always keep at least one dataframe ready
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || mFrames.empty() || (mFrames.size() < mDepth && withinMemoryBudget()); });
+        if (mStop) {
+          return;
+        }
+      }
+      DataFrame frame;
+      try {
+        frame = mNext();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mError = std::current_exception();
+        mCondition.notify_all();
+        return;
+      }
+      std::lock_guard<std::mutex> lock(mMutex);
+      bool endOfInput = frame.endOfInput;
+      mQueuedBytes += frame.sizeUncompressed;
+      mFrames.push_back(std::move(frame));
+      mCondition.notify_all();
+      if (!mBudgetWarningDone && mFrames.size() < mDepth && !withinMemoryBudget()) {
+        LOGP(WARNING, "Read-ahead depth reduced from {} to {} dataframes by the {} bytes of shared memory offered", mDepth, mFrames.size(), mMemoryBudget);
+        mBudgetWarningDone = true;
+      }
+      if (endOfInput) {
+        return;
+      }
+    }
+  }
+
+  std::function<DataFrame()> mNext;
+  size_t mDepth;
+  std::deque<DataFrame> mFrames;
+  size_t mQueuedBytes = 0;
+  int64_t mMemoryBudget = UnboundedMemory;
+  bool mBudgetWarningDone = false;
+  bool mStop = false;
+  std::exception_ptr mError;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+};
+
+} // namespace o2::framework::readers
+
+#endif // O2_FRAMEWORK_DATAFRAMEREADAHEAD_H_
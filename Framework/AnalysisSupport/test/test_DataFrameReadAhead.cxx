@@ -0,0 +1,121 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework DataFrameReadAhead
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "../src/DataFrameReadAhead.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace o2::framework::readers;
+
+namespace
+{
+/// A source of nFrames dataframes of 100 bytes each, followed by the end of input.
+/// The first dataframe is only produced once started is set.
+struct FakeDataFrames {
+  int nFrames;
+  std::atomic<int> produced{0};
+  std::atomic<bool> started{false};
+
+  DataFrame next()
+  {
+    while (!started) {
+      std::this_thread::yield();
+    }
+    DataFrame frame;
+    int n = produced++;
+    frame.numTF = n;
+    frame.timeFrameNumber = n;
+    frame.sizeUncompressed = 100;
+    frame.endOfInput = n >= nFrames;
+    return frame;
+  }
+};
+
+/// Wait until the read-ahead thread does not prepare any more dataframes
+size_t waitUntilStable(DataFrameReadAhead& readAhead)
+{
+  size_t ready = readAhead.ready();
+  for (int stable = 0; stable < 20;) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto now = readAhead.ready();
+    stable = now == ready ? stable + 1 : 0;
+    ready = now;
+  }
+  return ready;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestReadAheadDepth)
+{
+  // no shared memory offered, only the depth limits the read-ahead
+  FakeDataFrames source{10};
+  DataFrameReadAhead readAhead([&source]() { return source.next(); }, 3);
+  readAhead.setMemoryBudget(DataFrameReadAhead::UnboundedMemory);
+  source.started = true;
+
+  BOOST_CHECK_EQUAL(waitUntilStable(readAhead), 3);
+  BOOST_CHECK_EQUAL(source.produced, 3);
+
+  // every dataframe taken is replaced by the next one
+  for (int i = 0; i < 10; ++i) {
+    auto frame = readAhead.pop();
+    BOOST_CHECK_EQUAL(frame.numTF, i);
+    BOOST_CHECK(!frame.endOfInput);
+    if (i < 7) {
+      BOOST_CHECK_EQUAL(waitUntilStable(readAhead), 3);
+    }
+  }
+  BOOST_CHECK(readAhead.pop().endOfInput);
+  BOOST_CHECK_EQUAL(source.produced, 11);
+}
+
+BOOST_AUTO_TEST_CASE(TestReadAheadMemoryBudget)
+{
+  // 250 bytes offered are enough to start reading a third dataframe of 100 bytes
+  FakeDataFrames source{10};
+  DataFrameReadAhead readAhead([&source]() { return source.next(); }, 5);
+  readAhead.setMemoryBudget(250);
+  source.started = true;
+
+  BOOST_CHECK_EQUAL(waitUntilStable(readAhead), 3);
+
+  // with no memory offered at all, one dataframe is still prepared
+  readAhead.setMemoryBudget(0);
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(readAhead.pop().numTF, i);
+  }
+  BOOST_CHECK_EQUAL(waitUntilStable(readAhead), 1);
+
+  // more memory offered, read ahead up to the depth
+  readAhead.setMemoryBudget(DataFrameReadAhead::UnboundedMemory);
+  BOOST_CHECK_EQUAL(waitUntilStable(readAhead), 5);
+  readAhead.stop();
+}
+
+BOOST_AUTO_TEST_CASE(TestReadAheadError)
+{
+  std::atomic<int> calls{0};
+  DataFrameReadAhead readAhead([&calls]() -> DataFrame {
+    if (calls++ == 2) {
+      throw std::runtime_error("Processing is stopped!");
+    }
+    return DataFrame{};
+  },
+                               4);
+  readAhead.pop();
+  readAhead.pop();
+  BOOST_CHECK_THROW(readAhead.pop(), std::runtime_error);
+}
@@ -1669,6 +1669,13 @@ class FilteredPolicy : public T
     resetRanges();
   }
 
+  FilteredPolicy(std::vector<std::shared_ptr<arrow::Table>>&& tables, gandiva::NodePtr const& tree, framework::expressions::SelectionCache& cache, uint64_t offset = 0)
+    : T{std::move(tables), offset},
+      mSelectedRows{copySelection(cache.select(T::hashes(), tree, this->asArrowTable()))}
+  {
+    resetRanges();
+  }
+
   iterator begin()
   {
     return iterator(mFilteredBegin);
@@ -1712,12 +1719,21 @@ class FilteredPolicy : public T
   static inline SelectionVector copySelection(framework::expressions::Selection const& sel)
   {
     SelectionVector rows;
+    rows.reserve(sel->GetNumSlots());
     for (auto i = 0; i < sel->GetNumSlots(); ++i) {
       rows.push_back(sel->GetIndex(i));
     }
     return rows;
   }
 
+  static inline SelectionVector copySelection(framework::expressions::CompactSelection const& sel)
+  {
+    SelectionVector rows;
+    rows.reserve(sel.size());
+    sel.forEach([&rows](int64_t row) { rows.push_back(row); });
+    return rows;
+  }
+
   /// Bind the columns which refer to other tables
   /// to the associated tables.
   template <typename... TA>
@@ -1790,6 +1806,9 @@ class Filtered : public FilteredPolicy<T>
   Filtered(std::vector<std::shared_ptr<arrow::Table>>&& tables, gandiva::NodePtr const& tree, uint64_t offset = 0)
     : FilteredPolicy<T>(std::move(tables), tree, offset) {}
 
+  Filtered(std::vector<std::shared_ptr<arrow::Table>>&& tables, gandiva::NodePtr const& tree, framework::expressions::SelectionCache& cache, uint64_t offset = 0)
+    : FilteredPolicy<T>(std::move(tables), tree, cache, offset) {}
+
   Filtered<T> operator+(SelectionVector const& selection)
   {
     Filtered<T> copy(*this);
@@ -16,7 +16,9 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <exception>
 #include <iterator>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -62,6 +64,21 @@ bool diffCategory(std::pair<uint64_t, uint64_t> const& a, std::pair<uint64_t, ui
   return a.first >= b.first;
 }
 
+// Remove categories of too small size
+inline void removeSmallCategories(std::vector<std::pair<uint64_t, uint64_t>>& groupedIndices, int minCatSize)
+{
+  if (minCatSize > 1) {
+    auto catBegin = groupedIndices.begin();
+    while (catBegin != groupedIndices.end()) {
+      auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
+      if (std::distance(catBegin, catEnd) < minCatSize) {
+        catEnd = groupedIndices.erase(catBegin, catEnd);
+      }
+      catBegin = catEnd;
+    }
+  }
+}
+
 template <typename T2, typename ARRAY>
 std::vector<std::pair<uint64_t, uint64_t>> doGroupTable(const std::shared_ptr<arrow::Table>& table, const std::string& categoryColumnName, int minCatSize, const T2& outsider)
 {
@@ -86,17 +103,7 @@ std::vector<std::pair<uint64_t, uint64_t>> doGroupTable(const std::shared_ptr<ar
   // grouped together.
   std::stable_sort(groupedIndices.begin(), groupedIndices.end());
 
-  // Remove categories of too small size
-  if (minCatSize > 1) {
-    auto catBegin = groupedIndices.begin();
-    while (catBegin != groupedIndices.end()) {
-      auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
-      if (std::distance(catBegin, catEnd) < minCatSize) {
-        catEnd = groupedIndices.erase(catBegin, catEnd);
-      }
-      catBegin = catEnd;
-    }
-  }
+  removeSmallCategories(groupedIndices, minCatSize);
 
   return groupedIndices;
 }
@@ -543,16 +550,19 @@ struct CombinationsBlockSameIndexPolicyBase : public CombinationsIndexPolicyBase
   using CombinationType = typename CombinationsIndexPolicyBase<T, Ts...>::CombinationType;
   using IndicesType = typename NTupleType<uint64_t, sizeof...(Ts) + 1>::type;
 
-  CombinationsBlockSameIndexPolicyBase(const std::string& categoryColumnName, int categoryNeighbours, const T1& outsider, int minWindowSize, const T& table, const Ts&... tables) : CombinationsIndexPolicyBase<T, Ts...>(table, tables...), mSlidingWindowSize(categoryNeighbours + 1)
+  CombinationsBlockSameIndexPolicyBase(const std::string& categoryColumnName, int categoryNeighbours, const T1& outsider, int minWindowSize, const T& table, const Ts&... tables) : CombinationsBlockSameIndexPolicyBase(groupTable(table, categoryColumnName, minWindowSize, outsider), categoryNeighbours, minWindowSize, table, tables...) {}
+
+  // groupedIndices as returned by groupTable() for the category column of table, so that one grouping can be reused for several policies
+  CombinationsBlockSameIndexPolicyBase(std::vector<std::pair<uint64_t, uint64_t>> groupedIndices, int categoryNeighbours, int minWindowSize, const T& table, const Ts&... tables) : CombinationsIndexPolicyBase<T, Ts...>(table, tables...), mSlidingWindowSize(categoryNeighbours + 1)
   {
-    constexpr auto k = sizeof...(Ts) + 1;
     // minWindowSize == 1 for upper and full, and k for strictly upper k-combination
     if (mSlidingWindowSize < minWindowSize) {
       this->mIsEnd = true;
       return;
     }
 
-    this->mGroupedIndices = groupTable(table, categoryColumnName, minWindowSize, outsider);
+    this->mGroupedIndices = std::move(groupedIndices);
+    removeSmallCategories(this->mGroupedIndices, minWindowSize);
 
     if (this->mGroupedIndices.size() == 0) {
       this->mIsEnd = true;
@@ -578,6 +588,13 @@ struct CombinationsBlockUpperSameIndexPolicy : public CombinationsBlockSameIndex
     }
   }
 
+  CombinationsBlockUpperSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>> groupedIndices, int categoryNeighbours, const T& table, const Ts&... tables) : CombinationsBlockSameIndexPolicyBase<T1, T, Ts...>(std::move(groupedIndices), categoryNeighbours, 1, table, tables...)
+  {
+    if (!this->mIsEnd) {
+      setRanges();
+    }
+  }
+
   void setRanges()
   {
     constexpr auto k = sizeof...(Ts) + 1;
@@ -645,6 +662,9 @@ struct CombinationsBlockUpperSameIndexPolicy : public CombinationsBlockSameIndex
   }
 };
 
+template <typename T, typename... Ts>
+CombinationsBlockUpperSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>>, int, const T&, const Ts&...) -> CombinationsBlockUpperSameIndexPolicy<int, T, Ts...>;
+
 template <typename T1, typename T, typename... Ts>
 struct CombinationsBlockStrictlyUpperSameIndexPolicy : public CombinationsBlockSameIndexPolicyBase<T1, T, Ts...> {
   using CombinationType = typename CombinationsBlockSameIndexPolicyBase<T1, T, Ts...>::CombinationType;
@@ -656,6 +676,13 @@ struct CombinationsBlockStrictlyUpperSameIndexPolicy : public CombinationsBlockS
     }
   }
 
+  CombinationsBlockStrictlyUpperSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>> groupedIndices, int categoryNeighbours, const T& table, const Ts&... tables) : CombinationsBlockSameIndexPolicyBase<T1, T, Ts...>(std::move(groupedIndices), categoryNeighbours, sizeof...(Ts) + 1, table, tables...)
+  {
+    if (!this->mIsEnd) {
+      setRanges();
+    }
+  }
+
   void setRanges()
   {
     constexpr auto k = sizeof...(Ts) + 1;
@@ -726,6 +753,9 @@ struct CombinationsBlockStrictlyUpperSameIndexPolicy : public CombinationsBlockS
   }
 };
 
+template <typename T, typename... Ts>
+CombinationsBlockStrictlyUpperSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>>, int, const T&, const Ts&...) -> CombinationsBlockStrictlyUpperSameIndexPolicy<int, T, Ts...>;
+
 template <typename T1, typename T, typename... Ts>
 struct CombinationsBlockFullSameIndexPolicy : public CombinationsBlockSameIndexPolicyBase<T1, T, Ts...> {
   using CombinationType = typename CombinationsBlockSameIndexPolicyBase<T1, T, Ts...>::CombinationType;
@@ -737,6 +767,13 @@ struct CombinationsBlockFullSameIndexPolicy : public CombinationsBlockSameIndexP
     }
   }
 
+  CombinationsBlockFullSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>> groupedIndices, int categoryNeighbours, const T& table, const Ts&... tables) : CombinationsBlockSameIndexPolicyBase<T1, T, Ts...>(std::move(groupedIndices), categoryNeighbours, 1, table, tables...), mCurrentlyFixed(0)
+  {
+    if (!this->mIsEnd) {
+      setRanges();
+    }
+  }
+
   void setRanges()
   {
     constexpr auto k = sizeof...(Ts) + 1;
@@ -834,6 +871,9 @@ struct CombinationsBlockFullSameIndexPolicy : public CombinationsBlockSameIndexP
   uint64_t mCurrentlyFixed;
 };
 
+template <typename T, typename... Ts>
+CombinationsBlockFullSameIndexPolicy(std::vector<std::pair<uint64_t, uint64_t>>, int, const T&, const Ts&...) -> CombinationsBlockFullSameIndexPolicy<int, T, Ts...>;
+
 /// @return next combination of rows of tables.
 /// FIXME: move to coroutines once we have C++20
 template <typename P>
@@ -1003,6 +1043,92 @@ CombinationsGenerator<P2<T2s...>> combinations(const P2<T2s...>& policy)
   return CombinationsGenerator<P2<T2s...>>(policy);
 }
 
+// Split a block same-index policy (upper, strictly upper or full) into at most nParts policies,
+// each restricted to a contiguous range of complete categories. As combinations never cross
+// category boundaries, the parts together yield exactly the combinations of the original policy
+// and can be iterated independently, e.g. on different threads. The categories are distributed
+// so that the sum of the squared category sizes, i.e. the number of pairs, is balanced.
+template <typename P>
+std::vector<CombinationsGenerator<P>> partitionCombinations(const P& policy, int nParts)
+{
+  std::vector<CombinationsGenerator<P>> parts;
+  if (policy.mIsEnd || nParts < 1) {
+    return parts;
+  }
+  auto const& groupedIndices = policy.mGroupedIndices;
+
+  std::vector<uint64_t> catBegins;
+  double total = 0.;
+  for (auto catBegin = groupedIndices.begin(); catBegin != groupedIndices.end();) {
+    auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
+    double size = std::distance(catBegin, catEnd);
+    total += size * size;
+    catBegins.push_back(std::distance(groupedIndices.begin(), catBegin));
+    catBegin = catEnd;
+  }
+  catBegins.push_back(groupedIndices.size());
+
+  auto addPart = [&](uint64_t begin, uint64_t end) {
+    P part(policy);
+    part.mGroupedIndices.assign(groupedIndices.begin() + begin, groupedIndices.begin() + end);
+    std::get<0>(part.mCurrentIndices) = 0;
+    part.setRanges();
+    parts.emplace_back(part);
+  };
+
+  // each category goes to the part in which the middle of its weight falls
+  double cumulative = 0.;
+  int currentPart = 0;
+  uint64_t partBegin = 0;
+  for (uint64_t cat = 0; cat + 1 < catBegins.size(); ++cat) {
+    double size = catBegins[cat + 1] - catBegins[cat];
+    int catPart = std::min(nParts - 1, static_cast<int>((cumulative + 0.5 * size * size) * nParts / total));
+    if (catPart != currentPart && catBegins[cat] != partBegin) {
+      addPart(partBegin, catBegins[cat]);
+      partBegin = catBegins[cat];
+    }
+    currentPart = catPart;
+    cumulative += size * size;
+  }
+  addPart(partBegin, groupedIndices.size());
+  return parts;
+}
+
+// Process the combinations of a block same-index policy on nThreads threads, see partitionCombinations().
+// func(part, combination) is called concurrently for different parts, so it must only write
+// to outputs owned by the part (e.g. a vector of results indexed by part, with nThreads elements).
+template <typename P, typename F>
+void parallelCombinations(const P& policy, int nThreads, F&& func)
+{
+  auto parts = partitionCombinations(policy, nThreads);
+  std::vector<std::exception_ptr> errors(parts.size());
+  auto processPart = [&parts, &errors, &func](size_t part) {
+    try {
+      for (auto& comb : parts[part]) {
+        func(part, comb);
+      }
+    } catch (...) {
+      errors[part] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t part = 1; part < parts.size(); ++part) {
+    workers.emplace_back(processPart, part);
+  }
+  if (!parts.empty()) {
+    processPart(0);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 } // namespace o2::soa
 
 #endif // O2_FRAMEWORK_ASOAHELPERS_H_
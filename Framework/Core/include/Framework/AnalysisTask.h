@@ -36,6 +36,7 @@
 #include <memory>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 namespace o2::framework
 {
 /// A more familiar task API for the DPL analysis framework.
@@ -172,13 +173,22 @@ struct AnalysisDataProcessorBuilder {
     }
   }
 
+  template <typename T>
+  static auto makeFiltered(std::vector<std::shared_ptr<arrow::Table>>&& tables, ExpressionInfo const& info)
+  {
+    if (info.selectionCache != nullptr) {
+      return T(std::move(tables), info.tree, *info.selectionCache);
+    }
+    return T(std::move(tables), info.tree);
+  }
+
   template <typename T, typename... Os>
   static auto extractFilteredFromRecord(InputRecord& record, ExpressionInfo const& info, pack<Os...> const&)
   {
     if constexpr (soa::is_soa_iterator_t<T>::value) {
-      return typename T::parent_t(std::vector<std::shared_ptr<arrow::Table>>{extractTableFromRecord<Os>(record)...}, info.tree);
+      return makeFiltered<typename T::parent_t>(std::vector<std::shared_ptr<arrow::Table>>{extractTableFromRecord<Os>(record)...}, info);
     } else {
-      return T(std::vector<std::shared_ptr<arrow::Table>>{extractTableFromRecord<Os>(record)...}, info.tree);
+      return makeFiltered<T>(std::vector<std::shared_ptr<arrow::Table>>{extractTableFromRecord<Os>(record)...}, info);
     }
   }
 
@@ -766,6 +776,11 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
         return FilterManager<std::decay_t<decltype(x)>>::createExpressionTrees(x, expressionInfos);
       },
                              *task.get());
+      /// identical filters on the same table are evaluated once per timeslice
+      auto& selectionCache = ic.services().get<expressions::SelectionCache>();
+      for (auto& info : expressionInfos) {
+        info.selectionCache = &selectionCache;
+      }
     }
 
     if constexpr (has_init_v<T>) {
@@ -73,6 +73,16 @@ class ArrowContext
     return mMessages.size();
   }
 
+  /// Move all the messages of @a other to this context, so that they are sent
+  /// together with the ones created here.
+  void merge(ArrowContext& other)
+  {
+    for (auto& message : other.mMessages) {
+      mMessages.push_back(std::move(message));
+    }
+    other.mMessages.clear();
+  }
+
   void clear()
   {
     // On send we move the header, but the payload remains
@@ -58,6 +58,7 @@ struct CommonServices {
   static ServiceSpec parallelSpec();
   static ServiceSpec rawDeviceSpec();
   static ServiceSpec callbacksSpec();
+  static ServiceSpec selectionCacheSpec();
   static ServiceSpec timesliceIndex();
   static ServiceSpec dataRelayer();
   static ServiceSpec tracingSpec();
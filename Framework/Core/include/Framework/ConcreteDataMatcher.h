@@ -11,6 +11,7 @@
 #define O2_FRAMEWORK_CONCRETEDATAMATCHER_H_
 
 #include "Headers/DataHeader.h"
+#include <functional>
 
 namespace o2::framework
 {
@@ -81,4 +82,23 @@ struct ConcreteDataMatcher {
 };
 
 } // namespace o2::framework
+
+namespace std
+{
+/// Allow ConcreteDataMatcher to be used as key of the unordered containers,
+/// e.g. to look up the route of an incoming message.
+template <>
+struct hash<o2::framework::ConcreteDataMatcher> {
+  size_t operator()(o2::framework::ConcreteDataMatcher const& matcher) const
+  {
+    auto combine = [](size_t seed, uint64_t value) {
+      return seed ^ (std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    };
+    size_t result = std::hash<uint64_t>{}(matcher.origin.itg[0]);
+    result = combine(result, matcher.description.itg[0]);
+    result = combine(result, matcher.description.itg[1]);
+    return combine(result, matcher.subSpec);
+  }
+};
+} // namespace std
 #endif
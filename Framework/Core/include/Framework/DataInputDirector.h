@@ -15,9 +15,15 @@
 
 #include "Framework/DataDescriptorMatcher.h"
 
+#include <memory>
 #include <regex>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -71,6 +77,11 @@ struct DataInputDescriptor {
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
 
+  // input files with extension .arrow are folders with Arrow IPC files
+  // as written by the internal-dpl-aod-writer in the arrow format
+  bool isArrowFile(int counter);
+  std::string getArrowFolder(int counter, int numTF);
+
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
 
@@ -113,6 +124,9 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  bool isArrowFile(header::DataHeader dh, int counter);
+  // fileSize, if given, is incremented by the size of the Arrow IPC files on disk
+  std::shared_ptr<arrow::Table> getArrowTable(header::DataHeader dh, int counter, int numTF, size_t* fileSize = nullptr);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
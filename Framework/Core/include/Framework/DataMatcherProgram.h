@@ -0,0 +1,101 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DATAMATCHERPROGRAM_H_
+#define O2_FRAMEWORK_DATAMATCHERPROGRAM_H_
+
+#include "Framework/DataDescriptorMatcher.h"
+#include "Headers/DataHeader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace o2::framework::data_matcher
+{
+
+/// A DataDescriptorMatcher flattened to a list of instructions.
+///
+/// Constant origins, descriptions and subspecifications are compared
+/// directly on the words of the DataHeader, masked so that the result is
+/// the same as the string comparison of the value matchers. The leaves
+/// which depend on the VariableContext (and the start time) are evaluated
+/// by the original value matcher, so match() gives the same result, with
+/// the same updates of the context, as DataDescriptorMatcher::match().
+///
+/// mayMatch() evaluates the constant leaves only, considering the others
+/// as unknown. When it returns false, no context can make the matcher
+/// succeed, which allows to discard a route once per message rather than
+/// once per timeslice.
+class DataMatcherProgram
+{
+ public:
+  /// Maximum number of headers evaluated together by mayMatch().
+  static constexpr size_t MAX_BATCH_SIZE = 64;
+
+  DataMatcherProgram() = default;
+  explicit DataMatcherProgram(DataDescriptorMatcher const& matcher);
+
+  /// Same as DataDescriptorMatcher::match() on the header stack @a d.
+  bool match(char const* d, VariableContext& context) const;
+  bool match(header::DataHeader const& header, VariableContext& context) const;
+
+  /// @return false if the matcher can not match @a header, whatever the
+  /// content of the VariableContext is.
+  bool mayMatch(header::DataHeader const& header) const;
+
+  /// Evaluate mayMatch() for @a n <= MAX_BATCH_SIZE headers at once.
+  /// @return a mask where bit i is set when headers[i] may match.
+  uint64_t mayMatch(header::DataHeader const* const* headers, size_t n) const;
+
+  size_t size() const { return mCode.size(); }
+
+ private:
+  enum struct OpCode : uint8_t {
+    MatchOrigin,      /// accumulator = masked origin == value
+    MatchDescription, /// accumulator = masked description == value
+    MatchSubSpec,     /// accumulator = subSpecification == value
+    MatchConstant,    /// accumulator = value
+    MatchDelegated,   /// accumulator = mDelegated[arg].match(...)
+    JumpIfFalse,      /// And: skip the right hand side if the left one failed
+    JumpIfTrue,       /// Or: skip the right hand side if the left one succeeded
+    Push,             /// Xor: save the left hand side
+    Xor,              /// Xor: combine with the saved left hand side
+    And,              /// only in the mask program
+    Or                /// only in the mask program
+  };
+
+  struct Instruction {
+    OpCode code;
+    uint32_t arg = 0;
+    uint64_t value[2] = {0, 0};
+    uint64_t mask[2] = {0, 0};
+  };
+
+  using Delegated = std::variant<OriginValueMatcher, DescriptionValueMatcher, SubSpecificationTypeValueMatcher, StartTimeValueMatcher>;
+
+  void compile(DataDescriptorMatcher const& matcher);
+  void compileLeaf(Node const& node);
+  void emit(Instruction const& instruction, bool maskOnly = false);
+
+  /// Program with short-circuit jumps, used by match()
+  std::vector<Instruction> mCode;
+  /// Postfix program evaluated on masks of headers, used by mayMatch()
+  std::vector<Instruction> mMaskCode;
+  std::vector<Delegated> mDelegated;
+  size_t mXorDepth = 0;
+  size_t mMaxXorDepth = 0;
+  size_t mMaskDepth = 0;
+  size_t mMaxMaskDepth = 0;
+};
+
+} // namespace o2::framework::data_matcher
+
+#endif // O2_FRAMEWORK_DATAMATCHERPROGRAM_H_
@@ -20,6 +20,22 @@
 
 #include "rapidjson/fwd.h"
 
+#include <map>
+#include <memory>
+
+namespace arrow
+{
+class Table;
+namespace io
+{
+class FileOutputStream;
+}
+namespace ipc
+{
+class RecordBatchWriter;
+}
+} // namespace arrow
+
 namespace o2::framework
 {
 using namespace rapidjson;
@@ -74,6 +90,14 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  // "root": tables are saved as TTrees in <filename>.root
+  // "arrow": tables are saved unchanged as Arrow IPC files <filename>.arrow/DF_x/<treename>[.<part>].arrow
+  std::string getFileFormat() { return mfileFormat; }
+  void setFileFormat(std::string fileformat);
+  // compression of the Arrow IPC files: "none", "lz4", or "zstd"
+  std::string getFileCompression() { return mfileCompression; }
+  void setFileCompression(std::string compression);
+  bool isArrowFormat() { return mfileFormat == "arrow"; }
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -82,6 +106,9 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // append the (selected columns of the) table to the matching Arrow IPC file
+  void writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -98,6 +125,22 @@ struct DataOutputDirector {
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
+  std::string mfileFormat = "root";
+  std::string mfileCompression = "none";
+
+  // only the Arrow IPC files of the newest DF_ folder are kept open
+  struct ArrowFileWriter {
+    uint64_t folderNumber = 0;
+    std::string fileName;
+    std::string localFileName; // staging file of a remote output
+    std::shared_ptr<arrow::io::FileOutputStream> stream;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+  };
+  std::map<std::string, ArrowFileWriter> mArrowWriters;
+  std::map<std::string, int> mArrowParts;
+  uint64_t mArrowLastFolder = 0;
+  int mArrowStaged = 0;
+  void closeArrowWriter(ArrowFileWriter& aw);
 
   std::tuple<std::string, std::string, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), -1);
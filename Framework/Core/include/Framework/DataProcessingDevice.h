@@ -25,10 +25,12 @@
 #include "Framework/TerminationPolicy.h"
 #include "Framework/Tracing.h"
 #include "Framework/RunningWorkflowInfo.h"
+#include "Framework/ArrowContext.h"
 
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/FairMQParts.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <uv.h>
@@ -91,6 +93,20 @@ struct TaskStreamRef {
   int index = -1;
 };
 
+/// A timeslice whose computation is handed over to a processing
+/// stream. The inputs are owned by the task until the outputs have
+/// been sent and the inputs forwarded.
+struct StreamTask {
+  DataRelayer::RecordAction action;
+  TimingInfo timingInfo;
+  std::vector<MessageSet> inputs;
+  /// When the computation was dispatched
+  uint64_t tStart = 0;
+  /// The error raised by the processing, if any
+  bool failed = false;
+  RuntimeErrorRef error;
+};
+
 struct TaskStreamInfo {
   /// The id of this stream
   TaskStreamRef id;
@@ -98,6 +114,24 @@ struct TaskStreamInfo {
   DataProcessorContext* context;
   /// Wether or not this task is running
   bool running = false;
+  /// Whether the computation is over and its outputs can be sent
+  bool done = false;
+  /// The timeslice being processed, when running multiple streams
+  StreamTask task;
+};
+
+/// What is private to a processing stream, so that different
+/// timeslices can be processed concurrently. Only the contexts
+/// collecting the outputs are duplicated, all the other services
+/// are shared with the device.
+struct StreamResources {
+  std::unique_ptr<ServiceRegistry> registry;
+  TimingInfo timingInfo;
+  std::unique_ptr<DataAllocator> allocator;
+  std::unique_ptr<MessageContext> messageContext;
+  std::unique_ptr<StringContext> stringContext;
+  std::unique_ptr<ArrowContext> arrowContext;
+  std::unique_ptr<RawBufferContext> rawBufferContext;
 };
 
 /// A device actually carrying out all the DPL
@@ -120,11 +154,24 @@ class DataProcessingDevice : public FairMQDevice
   static void doPrepare(DataProcessorContext& context);
   static void handleData(DataProcessorContext& context, FairMQParts&, InputChannelInfo&);
   static bool tryDispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed);
+  static void doProcess(DataProcessorContext& context, StreamTask& task);
   std::vector<DataProcessorContext> mDataProcessorContexes;
 
+  /// Whether the computation is carried out by more than one processing stream.
+  bool hasStreams() const { return mStreamResources.empty() == false; }
+  /// Queue a consumed timeslice to be processed by the first available stream.
+  void scheduleTask(StreamTask&& task);
+  /// Send, in the order they were scheduled, the outputs of the streams
+  /// which are done and hand the pending tasks to the free streams.
+  void flushStreams();
+  /// Wait for all the scheduled tasks to be processed and their outputs sent.
+  void drainStreams();
+
  protected:
   void error(const char* msg);
   void fillContext(DataProcessorContext& context, DeviceContext& deviceContext);
+  void initStreams(int numStreams);
+  void dispatchPendingTasks();
 
  private:
   DeviceContext mDeviceContext;
@@ -159,6 +206,9 @@ class DataProcessingDevice : public FairMQDevice
   std::vector<uv_work_t> mHandles;                               /// Handles to use to schedule work.
   std::vector<TaskStreamInfo> mStreams;                          /// Information about the task running in the associated mHandle.
   ComputingQuotaEvaluator& mQuotaEvaluator;                      /// The component which evaluates if the offer can be used to run a task
+  std::vector<StreamResources> mStreamResources;                 /// Per stream services, empty when processing synchronously.
+  std::deque<int> mStreamsInFlight;                              /// The streams which are busy, in the order their task was scheduled.
+  std::deque<StreamTask> mPendingTasks;                          /// Tasks waiting for a free stream.
 };
 
 } // namespace o2::framework
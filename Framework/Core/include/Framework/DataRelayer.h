@@ -13,6 +13,7 @@
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/InputRoute.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataMatcherProgram.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/CompletionPolicy.h"
 #include "Framework/MessageSet.h"
@@ -21,6 +22,7 @@
 
 #include <cstddef>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 class FairMQMessage;
@@ -140,7 +142,18 @@ class DataRelayer
 
   CompletionPolicy mCompletionPolicy;
   std::vector<size_t> mDistinctRoutesIndex;
-  std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// The matchers of the routes, compiled to programs
+  std::vector<data_matcher::DataMatcherProgram> mInputPrograms;
+  /// Positions in mDistinctRoutesIndex of the routes which accept only a
+  /// given (origin, description, subSpec), so that they are found with a
+  /// single lookup rather than evaluating all the matchers.
+  std::unordered_map<ConcreteDataMatcher, std::vector<size_t>> mConcreteRoutes;
+  /// Positions in mDistinctRoutesIndex of the routes which need to be
+  /// evaluated with their DataDescriptorMatcher, sorted.
+  std::vector<size_t> mWildcardRoutes;
+  /// Scratch list of the wildcard routes which may accept the message
+  /// being relayed, whatever the content of the VariableContext is.
+  std::vector<size_t> mWildcardCandidates;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
 
@@ -39,17 +39,27 @@ class Filter;
 #endif
 #include <variant>
 #include <string>
+#include <map>
 #include <memory>
 #include <typeinfo>
 #include <set>
+#include <tuple>
+#include <vector>
 
 using atype = arrow::Type;
+namespace o2::framework::expressions
+{
+class SelectionCache;
+}
+
 struct ExpressionInfo {
   int argumentIndex;
   int processIndex;
   std::set<size_t> hashes;
   gandiva::SchemaPtr schema;
   gandiva::NodePtr tree;
+  /// selections of the current timeslice, shared by all the filters of the device
+  o2::framework::expressions::SelectionCache* selectionCache = nullptr;
 };
 
 namespace o2::framework::expressions
@@ -333,6 +343,63 @@ Selection createSelection(std::shared_ptr<arrow::Table> table, Filter const& exp
 /// Function for creating gandiva selection from prepared gandiva expressions tree
 Selection createSelection(std::shared_ptr<arrow::Table> table, std::shared_ptr<gandiva::Filter> gfilter);
 
+/// Rows selected by a filter. Sparse selections are kept as the list of the
+/// selected row indices, dense ones as a bitmap with one bit per row, which is
+/// smaller as soon as more than 1 row in 64 is selected.
+class CompactSelection
+{
+ public:
+  CompactSelection() = default;
+  CompactSelection(Selection const& selection, int64_t nrows);
+
+  /// number of selected rows
+  int64_t size() const { return mSize; }
+  bool isBitmap() const { return !mBitmap.empty(); }
+  /// call @a f for each selected row index, in increasing order, the bitmap
+  /// is iterated directly
+  template <typename F>
+  void forEach(F&& f) const
+  {
+    if (!isBitmap()) {
+      for (auto row : mIndices) {
+        f(row);
+      }
+      return;
+    }
+    for (size_t w = 0; w < mBitmap.size(); ++w) {
+      for (auto word = mBitmap[w]; word != 0; word &= word - 1) {
+        f(static_cast<int64_t>(w * 64 + __builtin_ctzll(word)));
+      }
+    }
+  }
+
+ private:
+  int64_t mSize = 0;
+  std::vector<int64_t> mIndices;
+  std::vector<uint64_t> mBitmap;
+};
+
+/// Selections evaluated during the processing of a timeslice, available as a
+/// service to all the analysis tasks of a device and cleared after each
+/// timeslice. Identical filters, i.e. with the same canonical string form of
+/// the gandiva expression tree, applied to the same table of the same
+/// dataframe are evaluated only once.
+class SelectionCache
+{
+ public:
+  /// selected rows of @a table, whose type is identified by its @a hashes
+  CompactSelection const& select(std::set<size_t> const& hashes, gandiva::NodePtr const& tree, std::shared_ptr<arrow::Table> const& table);
+  void clear() { mSelections.clear(); }
+  /// number of selections actually evaluated, i.e. not found in the cache
+  size_t evaluations() const { return mEvaluations; }
+
+ private:
+  /// table type, expression hash, address of the first buffer of the table and its number of rows
+  using Key = std::tuple<std::set<size_t>, size_t, void const*, int64_t>;
+  std::map<Key, CompactSelection> mSelections;
+  size_t mEvaluations = 0;
+};
+
 struct ColumnOperationSpec;
 using Operations = std::vector<ColumnOperationSpec>;
 
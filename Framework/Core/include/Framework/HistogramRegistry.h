@@ -26,6 +26,8 @@
 #include <TDataType.h>
 
 #include <deque>
+#include <memory>
+#include <mutex>
 
 class TList;
 
@@ -33,6 +35,39 @@ class TList;
 
 namespace o2::framework
 {
+//**************************************************************************************************
+/**
+ * Flat buffer of the bin contents (and squared weights) accumulated for one histogram by one thread.
+ * It is sized lazily on the first fill and merged into the histogram by HistFiller::flushBuffer().
+ */
+//**************************************************************************************************
+struct HistFillBuffer {
+  std::vector<double> contents{};
+  std::vector<double> sumw2{};
+  double entries{};
+  bool weighted{};
+
+  void add(size_t nBins, Long64_t bin, double weight)
+  {
+    if (O2_BUILTIN_UNLIKELY(contents.empty())) {
+      contents.resize(nBins);
+      sumw2.resize(nBins);
+    }
+    contents[bin] += weight;
+    sumw2[bin] += weight * weight;
+    entries += 1.;
+    weighted |= (weight != 1.);
+  }
+
+  void reset()
+  {
+    std::fill(contents.begin(), contents.end(), 0.);
+    std::fill(sumw2.begin(), sumw2.end(), 0.);
+    entries = 0.;
+    weighted = false;
+  }
+};
+
 //**************************************************************************************************
 /**
  * Static helper class to fill root histograms of any type. Contains functionality to fill once per call or a whole (filtered) table at once.
@@ -47,6 +82,18 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill TH1, TH2, TH3 or THn with fixed (non-extendable) axes via a thread local bin buffer, all other histograms are filled directly
+  template <typename T, typename... Ts>
+  static void fillBufferAny(std::shared_ptr<T>& hist, HistFillBuffer& buffer, const Ts&... positionAndWeight);
+
+  // same as above with columns (Cs) of a filtered table
+  template <typename... Cs, typename R, typename T>
+  static void fillBufferAny(std::shared_ptr<R>& hist, HistFillBuffer& buffer, const T& table, const o2::framework::expressions::Filter& filter);
+
+  // add the buffered bin contents to the histogram and reset the buffer
+  template <typename T>
+  static void flushBuffer(std::shared_ptr<T>& hist, HistFillBuffer& buffer);
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T>& hist, double fillFraction = 1.);
@@ -131,6 +178,19 @@ class HistogramRegistry
   // print summary of the histograms stored in registry
   void print(bool showAxisDetails = false);
 
+  // fill TH1, TH2, TH3 and THn with fixed binning via per-thread bin buffers so that concurrent
+  // processing streams can fill the same registry; the buffers are merged into the histograms
+  // by flush(), which is called automatically when the output is created.
+  // NB: after merging, the statistics (mean, rms) are recomputed from the bin centers
+  void setBufferedFill(bool buffered);
+  bool isBufferedFill() const { return mFillShards != nullptr; }
+
+  // merge the per-thread fill buffers into the histograms (must not run concurrently with fill)
+  void flush();
+
+  // number of buffered registries the calling thread keeps a fill shard of, including the destroyed ones not yet pruned
+  static size_t getNThreadFillShards();
+
   // lookup distance counter for benchmarking
   mutable uint32_t lookup = 0;
 
@@ -163,6 +223,9 @@ class HistogramRegistry
   // helper function that checks if name of histogram is reasonable and keeps track of names already in use
   void registerName(const std::string& name);
 
+  // helper function to get the fill buffer of the histogram at position idx for the calling thread
+  HistFillBuffer& getFillBuffer(uint32_t idx);
+
   std::string mName{};
   OutputObjHandlingPolicy mPolicy{};
   bool mCreateRegistryDir{};
@@ -176,6 +239,18 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  // fill buffers of all histograms for one thread, each thread only ever creates and fills its own shard
+  struct FillShard {
+    std::array<HistFillBuffer, MAX_REGISTRY_SIZE> buffers{};
+  };
+  // the shards of one registry, filled by the threads found in the per-thread lookup of getFillBuffer()
+  struct FillShards {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<FillShard>> shards{};
+  };
+  std::shared_ptr<FillShards> mFillShards{};
+  static std::vector<std::pair<std::weak_ptr<FillShards>, FillShard*>>& threadFillShards();
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -233,6 +308,89 @@ void HistFiller::fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2:
   }
 }
 
+template <typename T, typename... Ts>
+void HistFiller::fillBufferAny(std::shared_ptr<T>& hist, HistFillBuffer& buffer, const Ts&... positionAndWeight)
+{
+  constexpr int nArgs = sizeof...(Ts);
+  constexpr int nDim = std::is_same_v<TH3, T> ? 3 : (std::is_same_v<TH2, T> ? 2 : (std::is_same_v<TH1, T> ? 1 : 0));
+
+  if constexpr (nDim > 0 && (nArgs == nDim || nArgs == nDim + 1)) {
+    TAxis* axes[] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+    if (O2_BUILTIN_UNLIKELY(hist->GetBuffer() || axes[0]->CanExtend() || axes[1]->CanExtend() || axes[2]->CanExtend())) {
+      fillHistAny(hist, positionAndWeight...);
+      return;
+    }
+    double values[] = {static_cast<double>(positionAndWeight)...};
+    int bins[] = {0, 0, 0};
+    for (int d = 0; d < nDim; ++d) {
+      bins[d] = axes[d]->FindFixBin(values[d]);
+    }
+    buffer.add(hist->GetNcells(), hist->GetBin(bins[0], bins[1], bins[2]), (nArgs == nDim + 1) ? values[nArgs - 1] : 1.);
+  } else if constexpr (std::is_same_v<THn, T>) {
+    double values[] = {static_cast<double>(positionAndWeight)...};
+    double weight{1.};
+    if (hist->GetNdimensions() == nArgs - 1) {
+      weight = values[nArgs - 1];
+    } else if (hist->GetNdimensions() != nArgs) {
+      LOGF(FATAL, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", hist->GetName());
+    }
+    buffer.add(hist->GetNbins(), hist->GetBin(values), weight);
+  } else {
+    fillHistAny(hist, positionAndWeight...);
+  }
+}
+
+template <typename... Cs, typename R, typename T>
+void HistFiller::fillBufferAny(std::shared_ptr<R>& hist, HistFillBuffer& buffer, const T& table, const o2::framework::expressions::Filter& filter)
+{
+  if constexpr (std::is_base_of_v<StepTHn, R>) {
+    LOGF(FATAL, "Table filling is not (yet?) supported for StepTHn.");
+    return;
+  }
+  auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, o2::framework::expressions::createSelection(table.asArrowTable(), filter)};
+  for (auto& t : filtered) {
+    fillBufferAny(hist, buffer, (*(static_cast<Cs>(t).getIterator()))...);
+  }
+}
+
+template <typename T>
+void HistFiller::flushBuffer(std::shared_ptr<T>& hist, HistFillBuffer& buffer)
+{
+  if (buffer.entries == 0.) {
+    return;
+  }
+  if constexpr (std::is_same_v<TH1, T> || std::is_same_v<TH2, T> || std::is_same_v<TH3, T>) {
+    double entries = hist->GetEntries();
+    // same as TH1::Fill: the first weighted fill switches on the storage of the squared weights
+    if (buffer.weighted && !hist->GetSumw2N() && !hist->TestBit(TH1::kIsNotW)) {
+      hist->Sumw2();
+    }
+    TArrayD* sumw2 = hist->GetSumw2N() ? hist->GetSumw2() : nullptr;
+    for (size_t bin = 0; bin < buffer.contents.size(); ++bin) {
+      if (buffer.contents[bin] != 0. || buffer.sumw2[bin] != 0.) {
+        hist->AddBinContent(bin, buffer.contents[bin]);
+        if (sumw2) {
+          sumw2->fArray[bin] += buffer.sumw2[bin];
+        }
+      }
+    }
+    hist->ResetStats();
+    hist->SetEntries(entries + buffer.entries);
+  } else if constexpr (std::is_same_v<THn, T>) {
+    double entries = hist->GetEntries();
+    for (size_t bin = 0; bin < buffer.contents.size(); ++bin) {
+      if (buffer.contents[bin] != 0. || buffer.sumw2[bin] != 0.) {
+        hist->AddBinContent(bin, buffer.contents[bin]);
+        if (hist->GetCalculateErrors()) {
+          hist->AddBinError2(bin, buffer.sumw2[bin]);
+        }
+      }
+    }
+    hist->SetEntries(entries + buffer.entries);
+  }
+  buffer.reset();
+}
+
 template <typename T>
 double HistFiller::getSize(std::shared_ptr<T>& hist, double fillFraction)
 {
@@ -378,12 +536,24 @@ uint32_t HistogramRegistry::getHistIndex(const T& histName)
 template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts&&... positionAndWeight)
 {
+  if (mFillShards) {
+    const uint32_t idx = getHistIndex(histName);
+    auto& buffer = getFillBuffer(idx);
+    std::visit([&buffer, &positionAndWeight...](auto&& hist) { HistFiller::fillBufferAny(hist, buffer, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[idx]);
+    return;
+  }
   std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[getHistIndex(histName)]);
 }
 
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
+  if (mFillShards) {
+    const uint32_t idx = getHistIndex(histName);
+    auto& buffer = getFillBuffer(idx);
+    std::visit([&buffer, &table, &filter](auto&& hist) { HistFiller::fillBufferAny<Cs...>(hist, buffer, table, filter); }, mRegistryValue[idx]);
+    return;
+  }
   std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
 }
 
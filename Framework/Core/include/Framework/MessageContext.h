@@ -501,6 +501,16 @@ class MessageContext
     return mMessages.size();
   }
 
+  /// Move all the messages of @a other to this context, so that they are sent
+  /// together with the ones created here. The channel references of the moved
+  /// objects point to @a other, which therefore has to outlive them.
+  void merge(MessageContext& other)
+  {
+    for (auto& message : other.getMessagesForSending()) {
+      mMessages.emplace_back(std::move(message));
+    }
+  }
+
   /// Prepares the context to create messages for the given timeslice. This
   /// expects that the previous context was already sent and can be completely
   /// discarded.
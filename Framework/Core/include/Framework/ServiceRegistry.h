@@ -168,6 +168,19 @@ struct ServiceRegistry {
   /// This method is supposed to be thread safe
   void registerService(hash_type typeHash, void* service, ServiceKind kind, uint64_t threadId, char const* name = nullptr) const;
 
+  /// Replace, in this registry only, every instance of the service identified
+  /// by @a typeHash with @a service. This is meant to be used on a copy of
+  /// the registry, to give it a private instance of a Serial service.
+  /// This method is not thread safe.
+  void overrideService(hash_type typeHash, void* service);
+
+  /// Typed version of overrideService.
+  template <typename T>
+  void overrideService(T* service)
+  {
+    overrideService(TypeIdHelpers::uniqueId<T>(), reinterpret_cast<void*>(service));
+  }
+
   // Lookup a given @a typeHash for a given @a threadId at
   // a unique (per typeHash) location. There might
   // be other typeHash which sit in the same place, but
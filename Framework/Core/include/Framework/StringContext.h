@@ -58,6 +58,16 @@ class StringContext
     return mMessages.size();
   }
 
+  /// Move all the messages of @a other to this context, so that they are sent
+  /// together with the ones created here.
+  void merge(StringContext& other)
+  {
+    for (auto& message : other.mMessages) {
+      mMessages.push_back(std::move(message));
+    }
+    other.mMessages.clear();
+  }
+
   void clear();
 
   FairMQDeviceProxy& proxy()
@@ -130,6 +130,7 @@ class TreeToTable
   bool addAllColumns(TTree* tree);
 
   // do the looping with the TTreeReader
+  // the flat numeric columns are read basket by basket with the TBranch bulk I/O
   void fill(TTree* tree);
 
   // create the table
@@ -26,6 +26,7 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/Tracing.h"
 #include "Framework/Monitoring.h"
+#include "Framework/Expressions.h"
 #include "TextDriverClient.h"
 #include "WSDriverClient.h"
 #include "HTTPParser.h"
@@ -440,6 +441,33 @@ o2::framework::ServiceSpec CommonServices::timesliceIndex()
     ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::selectionCacheSpec()
+{
+  return ServiceSpec{
+    "selection-cache",
+    simpleServiceInit<expressions::SelectionCache, expressions::SelectionCache>(),
+    noConfiguration(),
+    nullptr,
+    [](ProcessingContext&, void* service) {
+      // the selections refer to the tables of the timeslice just processed
+      reinterpret_cast<expressions::SelectionCache*>(service)->clear();
+    },
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    ServiceKind::Serial};
+}
+
 o2::framework::ServiceSpec CommonServices::callbacksSpec()
 {
   return ServiceSpec{
@@ -694,6 +722,7 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     rootFileSpec(),
     parallelSpec(),
     callbacksSpec(),
+    selectionCacheSpec(),
     dataRelayer(),
     dataProcessingStats(),
     CommonMessageBackends::fairMQBackendSpec(),
@@ -19,6 +19,13 @@
 #include "TGrid.h"
 #include "TObjString.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -89,8 +96,34 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
+  // the tables of an arrow input are memory-mapped when requested
+  // only the DF_ folders need to be listed
   auto filename = mfilenames[counter]->fileName;
+  if (isArrowFile(counter)) {
+    closeInputFile();
+    if (mfilenames[counter]->numberOfTimeFrames <= 0) {
+      std::regex TFRegex = std::regex("DF_[0-9]+");
+      std::error_code ec;
+      for (auto const& entry : std::filesystem::directory_iterator(filename, ec)) {
+        auto folderName = entry.path().filename().string();
+        if (entry.is_directory() && std::regex_match(folderName, TFRegex)) {
+          mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(std::stoul(folderName.substr(3)));
+        }
+      }
+      if (ec) {
+        throw std::runtime_error(fmt::format("Couldn't open folder \"{}\"!", filename));
+      }
+      std::sort(mfilenames[counter]->listOfTimeFrameNumbers.begin(), mfilenames[counter]->listOfTimeFrameNumbers.end());
+
+      for (auto folderNumber : mfilenames[counter]->listOfTimeFrameNumbers) {
+        mfilenames[counter]->listOfTimeFrameKeys.emplace_back("DF_" + std::to_string(folderNumber));
+      }
+      mfilenames[counter]->numberOfTimeFrames = mfilenames[counter]->listOfTimeFrameKeys.size();
+    }
+    return true;
+  }
+
+  // open file
   if (mcurrentFile) {
     if (mcurrentFile->GetName() != filename) {
       closeInputFile();
@@ -169,6 +202,33 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  if (counter >= getNumberInputfiles()) {
+    return false;
+  }
+  auto filename = std::filesystem::path(mfilenames[counter]->fileName);
+  if (!filename.has_filename()) {
+    filename = filename.parent_path();
+  }
+  return filename.extension() == ".arrow";
+}
+
+std::string DataInputDescriptor::getArrowFolder(int counter, int numTF)
+{
+  // open file
+  if (!setFile(counter)) {
+    return "";
+  }
+
+  // no TF left
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return "";
+  }
+
+  return (std::filesystem::path(mfilenames[counter]->fileName) / (mfilenames[counter]->listOfTimeFrameKeys)[numTF]).string();
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -582,6 +642,85 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  if (!didesc) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->isArrowFile(counter);
+}
+
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF, size_t* fileSize)
+{
+  std::string treename;
+
+  auto didesc = getDataInputDescriptor(dh);
+  if (didesc) {
+    // if match then use filename and treename from DataInputDescriptor
+    treename = didesc->treename;
+  } else {
+    // if NOT match then use
+    //  . filename from defaultDataInputDescriptor
+    //  . treename from DataHeader
+    didesc = mdefaultDataInputDescriptor;
+    treename = aod::datamodel::getTreeName(dh);
+  }
+
+  auto folder = didesc->getArrowFolder(counter, numTF);
+  if (folder.empty()) {
+    return nullptr;
+  }
+
+  // the record batches of a memory-mapped uncompressed file refer to the
+  // mapped memory directly, nothing is copied or converted. Time frames
+  // which reached the folder after it was closed by the writer are in the
+  // additional parts <treename>.<part>.arrow
+  std::shared_ptr<arrow::Schema> schema;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int part = 0;; ++part) {
+    auto filename = (std::filesystem::path(folder) / (treename + (part > 0 ? "." + std::to_string(part) : "") + ".arrow")).string();
+    if (part > 0 && !std::filesystem::exists(filename)) {
+      break;
+    }
+    auto file = arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+    if (!file.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't open Arrow IPC file "{}")", filename));
+    }
+    if (fileSize) {
+      auto size = file.ValueOrDie()->GetSize();
+      *fileSize += size.ok() ? size.ValueOrDie() : 0;
+    }
+    auto reader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+    if (!reader.ok()) {
+      throw std::runtime_error(fmt::format(R"(Couldn't read Arrow IPC file "{}")", filename));
+    }
+
+    auto batchReader = reader.ValueOrDie();
+    if (!schema) {
+      schema = batchReader->schema();
+    } else if (!schema->Equals(*batchReader->schema())) {
+      throw std::runtime_error(fmt::format(R"(Schema of Arrow IPC file "{}" differs from the one of the first part)", filename));
+    }
+    for (int i = 0; i < batchReader->num_record_batches(); ++i) {
+      auto batch = batchReader->ReadRecordBatch(i);
+      if (!batch.ok()) {
+        throw std::runtime_error(fmt::format(R"(Couldn't read record batch {} of Arrow IPC file "{}")", i, filename));
+      }
+      batches.emplace_back(batch.ValueOrDie());
+    }
+  }
+
+  auto table = arrow::Table::FromRecordBatches(schema, batches);
+  if (!table.ok()) {
+    throw std::runtime_error(fmt::format(R"(Couldn't create table from Arrow IPC files in "{}")", folder));
+  }
+
+  return table.ValueOrDie();
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
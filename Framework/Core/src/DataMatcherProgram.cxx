@@ -0,0 +1,319 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DataMatcherProgram.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/VariantHelpers.h"
+#include "Framework/RuntimeError.h"
+#include "Headers/Stack.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace o2::framework::data_matcher
+{
+
+namespace
+{
+constexpr size_t MAX_XOR_DEPTH = 16;
+constexpr size_t MAX_MASK_DEPTH = 64;
+
+/// Expected words and mask for a string compared with strncmp(header, s, N):
+/// the bytes up to the first null character of s (included) must be equal.
+template <size_t N>
+void fillExpected(std::string const& s, uint64_t (&value)[2], uint64_t (&mask)[2])
+{
+  static_assert(N <= 16);
+  char valueBytes[16] = {0};
+  char maskBytes[16] = {0};
+  auto n = std::min(s.size(), N);
+  std::memcpy(valueBytes, s.data(), n);
+  std::memset(maskBytes, 0xff, n < N ? n + 1 : N);
+  std::memcpy(value, valueBytes, 16);
+  std::memcpy(mask, maskBytes, 16);
+}
+
+template <size_t N>
+bool matchWords(char const* str, uint64_t const (&value)[2], uint64_t const (&mask)[2])
+{
+  uint64_t words[2] = {0, 0};
+  std::memcpy(words, str, N);
+  return ((words[0] & mask[0]) == value[0]) && ((words[1] & mask[1]) == value[1]);
+}
+} // namespace
+
+DataMatcherProgram::DataMatcherProgram(DataDescriptorMatcher const& matcher)
+{
+  compile(matcher);
+  if (mMaxXorDepth > MAX_XOR_DEPTH) {
+    throw runtime_error_f("Too many nested XOR in matcher (%zu > %zu)", mMaxXorDepth, MAX_XOR_DEPTH);
+  }
+  // mayMatch() is not able to discard anything for such a matcher
+  if (mMaxMaskDepth > MAX_MASK_DEPTH) {
+    mMaskCode.clear();
+  }
+}
+
+void DataMatcherProgram::emit(Instruction const& instruction, bool maskOnly)
+{
+  if (maskOnly == false) {
+    mCode.push_back(instruction);
+  }
+  mMaskCode.push_back(instruction);
+  switch (instruction.code) {
+    case OpCode::And:
+    case OpCode::Or:
+    case OpCode::Xor:
+      mMaskDepth--;
+      break;
+    default:
+      mMaskDepth++;
+      mMaxMaskDepth = std::max(mMaxMaskDepth, mMaskDepth);
+  }
+}
+
+void DataMatcherProgram::compileLeaf(Node const& node)
+{
+  auto delegate = [this](Delegated&& delegated) {
+    mDelegated.emplace_back(std::move(delegated));
+    emit({OpCode::MatchDelegated, static_cast<uint32_t>(mDelegated.size() - 1)});
+  };
+
+  std::visit(overloaded{
+               [this, &delegate](OriginValueMatcher const& matcher) {
+                 matcher.visit(overloaded{
+                   [this](std::string const& s) {
+                     Instruction instruction{OpCode::MatchOrigin};
+                     fillExpected<4>(s, instruction.value, instruction.mask);
+                     emit(instruction);
+                   },
+                   [&delegate, &matcher](ContextRef const&) { delegate(matcher); }});
+               },
+               [this, &delegate](DescriptionValueMatcher const& matcher) {
+                 matcher.visit(overloaded{
+                   [this](std::string const& s) {
+                     Instruction instruction{OpCode::MatchDescription};
+                     fillExpected<16>(s, instruction.value, instruction.mask);
+                     emit(instruction);
+                   },
+                   [&delegate, &matcher](ContextRef const&) { delegate(matcher); }});
+               },
+               [this, &delegate](SubSpecificationTypeValueMatcher const& matcher) {
+                 matcher.visit(overloaded{
+                   [this](header::DataHeader::SubSpecificationType v) {
+                     emit({OpCode::MatchSubSpec, v});
+                   },
+                   [&delegate, &matcher](ContextRef const&) { delegate(matcher); }});
+               },
+               [&delegate](StartTimeValueMatcher const& matcher) {
+                 delegate(matcher);
+               },
+               [this](ConstantValueMatcher const& matcher) {
+                 emit({OpCode::MatchConstant, matcher.match()});
+               },
+               [this](std::unique_ptr<DataDescriptorMatcher> const& matcher) {
+                 compile(*matcher);
+               }},
+             node);
+}
+
+void DataMatcherProgram::compile(DataDescriptorMatcher const& matcher)
+{
+  compileLeaf(matcher.getLeft());
+
+  switch (matcher.getOp()) {
+    case DataDescriptorMatcher::Op::Just:
+      return;
+    case DataDescriptorMatcher::Op::And:
+    case DataDescriptorMatcher::Op::Or: {
+      bool isAnd = matcher.getOp() == DataDescriptorMatcher::Op::And;
+      auto jump = mCode.size();
+      mCode.push_back({isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue});
+      compileLeaf(matcher.getRight());
+      mCode[jump].arg = mCode.size();
+      emit({isAnd ? OpCode::And : OpCode::Or}, true);
+      return;
+    }
+    case DataDescriptorMatcher::Op::Xor:
+      mCode.push_back({OpCode::Push});
+      mMaxXorDepth = std::max(mMaxXorDepth, ++mXorDepth);
+      compileLeaf(matcher.getRight());
+      mXorDepth--;
+      mCode.push_back({OpCode::Xor});
+      emit({OpCode::Xor}, true);
+      return;
+  }
+  throw runtime_error("Bad parsing tree");
+}
+
+bool DataMatcherProgram::match(header::DataHeader const& header, VariableContext& context) const
+{
+  return this->match(reinterpret_cast<char const*>(&header), context);
+}
+
+bool DataMatcherProgram::match(char const* d, VariableContext& context) const
+{
+  header::DataHeader const* dh = nullptr;
+  auto getHeader = [&dh, d]() -> header::DataHeader const& {
+    if (dh == nullptr) {
+      dh = o2::header::get<header::DataHeader*>(d);
+      if (dh == nullptr) {
+        throw runtime_error("Cannot find DataHeader");
+      }
+    }
+    return *dh;
+  };
+
+  bool accumulator = false;
+  std::array<bool, MAX_XOR_DEPTH> saved;
+  size_t depth = 0;
+
+  for (size_t pc = 0, pe = mCode.size(); pc < pe; ++pc) {
+    auto& instruction = mCode[pc];
+    switch (instruction.code) {
+      case OpCode::MatchOrigin:
+        accumulator = matchWords<4>(getHeader().dataOrigin.str, instruction.value, instruction.mask);
+        break;
+      case OpCode::MatchDescription:
+        accumulator = matchWords<16>(getHeader().dataDescription.str, instruction.value, instruction.mask);
+        break;
+      case OpCode::MatchSubSpec:
+        accumulator = getHeader().subSpecification == instruction.arg;
+        break;
+      case OpCode::MatchConstant:
+        accumulator = instruction.arg != 0;
+        break;
+      case OpCode::MatchDelegated:
+        accumulator = std::visit(overloaded{
+                                   [&getHeader, &context, d](StartTimeValueMatcher const& matcher) {
+                                     auto& dh = getHeader();
+                                     auto dph = o2::header::get<DataProcessingHeader*>(d);
+                                     if (dph == nullptr) {
+                                       throw runtime_error("Cannot find DataProcessingHeader");
+                                     }
+                                     return matcher.match(dh, *dph, context);
+                                   },
+                                   [&getHeader, &context](auto const& matcher) {
+                                     return matcher.match(getHeader(), context);
+                                   }},
+                                 mDelegated[instruction.arg]);
+        break;
+      case OpCode::JumpIfFalse:
+        if (accumulator == false) {
+          pc = instruction.arg - 1;
+        }
+        break;
+      case OpCode::JumpIfTrue:
+        if (accumulator == true) {
+          pc = instruction.arg - 1;
+        }
+        break;
+      case OpCode::Push:
+        saved[depth++] = accumulator;
+        break;
+      case OpCode::Xor:
+        accumulator = saved[--depth] ^ accumulator;
+        break;
+      default:
+        throw runtime_error("Bad matcher program");
+    }
+  }
+  return accumulator;
+}
+
+bool DataMatcherProgram::mayMatch(header::DataHeader const& header) const
+{
+  header::DataHeader const* headers[1] = {&header};
+  return mayMatch(headers, 1) != 0;
+}
+
+uint64_t DataMatcherProgram::mayMatch(header::DataHeader const* const* headers, size_t n) const
+{
+  if (n > MAX_BATCH_SIZE) {
+    throw runtime_error_f("Too many headers in batch (%zu > %zu)", n, MAX_BATCH_SIZE);
+  }
+  uint64_t all = n == MAX_BATCH_SIZE ? ~uint64_t{0} : ((uint64_t{1} << n) - 1);
+  if (mMaskCode.empty()) {
+    return all;
+  }
+
+  // For each header we keep whether the subexpression can be true and
+  // whether it can be false: unknown leaves can be both.
+  struct Outcome {
+    uint64_t canBeTrue;
+    uint64_t canBeFalse;
+  };
+  std::array<Outcome, MAX_MASK_DEPTH> stack;
+  size_t sp = 0;
+
+  auto pushMatches = [&stack, &sp, &all](uint64_t matches) {
+    stack[sp++] = {matches & all, ~matches & all};
+  };
+
+  for (auto& instruction : mMaskCode) {
+    switch (instruction.code) {
+      case OpCode::MatchOrigin: {
+        uint64_t matches = 0;
+        for (size_t i = 0; i < n; ++i) {
+          matches |= uint64_t{matchWords<4>(headers[i]->dataOrigin.str, instruction.value, instruction.mask)} << i;
+        }
+        pushMatches(matches);
+        break;
+      }
+      case OpCode::MatchDescription: {
+        uint64_t matches = 0;
+        for (size_t i = 0; i < n; ++i) {
+          matches |= uint64_t{matchWords<16>(headers[i]->dataDescription.str, instruction.value, instruction.mask)} << i;
+        }
+        pushMatches(matches);
+        break;
+      }
+      case OpCode::MatchSubSpec: {
+        uint64_t matches = 0;
+        for (size_t i = 0; i < n; ++i) {
+          matches |= uint64_t{headers[i]->subSpecification == instruction.arg} << i;
+        }
+        pushMatches(matches);
+        break;
+      }
+      case OpCode::MatchConstant:
+        pushMatches(instruction.arg != 0 ? all : 0);
+        break;
+      case OpCode::MatchDelegated:
+        stack[sp++] = {all, all};
+        break;
+      case OpCode::And: {
+        auto right = stack[--sp];
+        auto& left = stack[sp - 1];
+        left = {left.canBeTrue & right.canBeTrue, left.canBeFalse | right.canBeFalse};
+        break;
+      }
+      case OpCode::Or: {
+        auto right = stack[--sp];
+        auto& left = stack[sp - 1];
+        left = {left.canBeTrue | right.canBeTrue, left.canBeFalse & right.canBeFalse};
+        break;
+      }
+      case OpCode::Xor: {
+        auto right = stack[--sp];
+        auto& left = stack[sp - 1];
+        left = {(left.canBeTrue & right.canBeFalse) | (left.canBeFalse & right.canBeTrue),
+                (left.canBeTrue & right.canBeTrue) | (left.canBeFalse & right.canBeFalse)};
+        break;
+      }
+      default:
+        throw runtime_error("Bad matcher program");
+    }
+  }
+  return stack[0].canBeTrue;
+}
+
+} // namespace o2::framework::data_matcher
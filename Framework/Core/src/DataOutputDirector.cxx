@@ -9,11 +9,21 @@
 // or submit itself to any jurisdiction.
 #include "Framework/DataOutputDirector.h"
 #include "Framework/Logger.h"
+#include "Framework/RuntimeError.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
 
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+#include <arrow/util/config.h>
+
+#include <filesystem>
+#include <unistd.h>
+
 namespace o2
 {
 namespace framework
@@ -313,6 +323,26 @@ std::tuple<std::string, std::string, int> DataOutputDirector::readJsonDocument(D
     }
   }
 
+  itemName = "resfileformat";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileFormat(dodirItem[itemName].GetString());
+    } else {
+      LOGP(ERROR, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
+  itemName = "resfilecompression";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileCompression(dodirItem[itemName].GetString());
+    } else {
+      LOGP(ERROR, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
   itemName = "ntfmerge";
   if (dodirItem.HasMember(itemName)) {
     if (dodirItem[itemName].IsNumber()) {
@@ -455,6 +485,136 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+void DataOutputDirector::writeArrowTable(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::shared_ptr<arrow::Table> const& table)
+{
+  // select the requested columns, the column data is not copied
+  auto toWrite = table;
+  if (dodesc->colnames.size() > 0) {
+    std::vector<int> indices;
+    for (auto cn : dodesc->colnames) {
+      auto idx = table->schema()->GetFieldIndex(cn);
+      if (idx != -1) {
+        indices.emplace_back(idx);
+      }
+    }
+    auto selected = table->SelectColumns(indices);
+    if (!selected.ok()) {
+      throw runtime_error_f("Unable to select the columns of table \"%s\"", dodesc->tablename.c_str());
+    }
+    toWrite = selected.ValueOrDie();
+  }
+
+  // time frames which are merged into the same DF_ folder are appended as
+  // further record batches to the open file. The folder number only grows
+  // with the time frame number, so the files of the older folders are closed
+  // as soon as a newer folder shows up. This writes their IPC footers and
+  // keeps the number of open files bounded. A late time frame of an already
+  // closed folder goes to an additional part <treename>.<part>.arrow, as an
+  // Arrow IPC file can not be reopened for appending
+  if (folderNumber > mArrowLastFolder) {
+    for (auto it = mArrowWriters.begin(); it != mArrowWriters.end();) {
+      if (it->second.folderNumber < folderNumber) {
+        closeArrowWriter(it->second);
+        it = mArrowWriters.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    mArrowLastFolder = folderNumber;
+  }
+
+  auto folderName = "DF_" + std::to_string(folderNumber);
+  auto key = dodesc->getFilenameBase() + "/" + folderName + "/" + dodesc->treename;
+  auto& aw = mArrowWriters[key];
+
+  if (!aw.writer) {
+    // the paths are joined as strings, the file name base can be an URL
+    auto part = mArrowParts[key]++;
+    auto folder = dodesc->getFilenameBase() + ".arrow/" + folderName;
+    auto fn = folder + "/" + dodesc->treename + (part > 0 ? "." + std::to_string(part) : "") + ".arrow";
+
+    // remote files are written to a local file first, which is copied to
+    // its destination when it is closed
+    auto isRemote = fn.find("://") != std::string::npos && fn.rfind("file://", 0) != 0;
+    std::string localfn;
+    if (isRemote) {
+      localfn = (std::filesystem::temp_directory_path() / fmt::format("{}_{}_{}", getpid(), mArrowStaged++, std::filesystem::path(fn).filename().string())).string();
+    } else {
+      localfn = fn.rfind("file://", 0) == 0 ? fn.substr(7) : fn;
+      std::error_code ec;
+      std::filesystem::create_directories(std::filesystem::path(localfn).parent_path(), ec);
+      if (ec) {
+        throw runtime_error_f("Unable to create folder \"%s\"", folder.c_str());
+      }
+      if ((mfileMode == "NEW" || mfileMode == "CREATE") && std::filesystem::exists(localfn)) {
+        throw runtime_error_f("File \"%s\" already exists", fn.c_str());
+      }
+      // parts left over from an earlier output with the same name
+      if (part == 0) {
+        auto dir = std::filesystem::path(localfn).parent_path();
+        int stale = 1;
+        while (std::filesystem::remove(dir / fmt::format("{}.{}.arrow", dodesc->treename, stale), ec)) {
+          ++stale;
+        }
+      }
+    }
+
+    auto stream = arrow::io::FileOutputStream::Open(localfn);
+    if (!stream.ok()) {
+      throw runtime_error_f("Unable to open file \"%s\"", localfn.c_str());
+    }
+
+    auto options = arrow::ipc::IpcWriteOptions::Defaults();
+    if (mfileCompression != "none") {
+      auto type = mfileCompression == "lz4" ? arrow::Compression::LZ4_FRAME : arrow::Compression::ZSTD;
+#if ARROW_VERSION_MAJOR < 2
+      options.compression = type;
+#else
+      auto codec = arrow::util::Codec::Create(type);
+      if (!codec.ok()) {
+        throw runtime_error_f("Compression \"%s\" is not available", mfileCompression.c_str());
+      }
+      options.codec = std::move(codec).ValueOrDie();
+#endif
+    }
+
+#if ARROW_VERSION_MAJOR < 3
+    auto writer = arrow::ipc::NewFileWriter(stream.ValueOrDie().get(), toWrite->schema(), options);
+#else
+    auto writer = arrow::ipc::MakeFileWriter(stream.ValueOrDie().get(), toWrite->schema(), options);
+#endif
+    if (!writer.ok()) {
+      throw runtime_error_f("Unable to create batch writer for file \"%s\"", fn.c_str());
+    }
+    aw.folderNumber = folderNumber;
+    aw.fileName = fn;
+    aw.localFileName = isRemote ? localfn : "";
+    aw.stream = stream.ValueOrDie();
+    aw.writer = writer.ValueOrDie();
+  }
+
+  if (!aw.writer->WriteTable(*toWrite).ok()) {
+    throw runtime_error_f("Unable to write table \"%s\"", dodesc->tablename.c_str());
+  }
+}
+
+void DataOutputDirector::closeArrowWriter(ArrowFileWriter& aw)
+{
+  if (aw.writer) {
+    if (!aw.writer->Close().ok() || !aw.stream->Close().ok()) {
+      LOGP(ERROR, "Unable to close the Arrow IPC file {}", aw.fileName);
+    }
+    if (!aw.localFileName.empty()) {
+      if (!TFile::Cp(aw.localFileName.c_str(), aw.fileName.c_str(), false)) {
+        LOGP(ERROR, "Unable to copy the Arrow IPC file {} to {}", aw.localFileName, aw.fileName);
+      }
+      std::error_code ec;
+      std::filesystem::remove(aw.localFileName, ec);
+    }
+  }
+  aw = ArrowFileWriter{};
+}
+
 void DataOutputDirector::closeDataFiles()
 {
   for (auto filePtr : mfilePtrs) {
@@ -462,6 +622,28 @@ void DataOutputDirector::closeDataFiles()
       filePtr->Close();
     }
   }
+  for (auto& [key, aw] : mArrowWriters) {
+    closeArrowWriter(aw);
+  }
+  mArrowWriters.clear();
+  mArrowParts.clear();
+  mArrowLastFolder = 0;
+}
+
+void DataOutputDirector::setFileFormat(std::string fileformat)
+{
+  if (fileformat != "root" && fileformat != "arrow") {
+    LOGP(FATAL, "Unknown file format \"{}\"! Use \"root\" or \"arrow\".", fileformat);
+  }
+  mfileFormat = fileformat;
+}
+
+void DataOutputDirector::setFileCompression(std::string compression)
+{
+  if (compression != "none" && compression != "lz4" && compression != "zstd") {
+    LOGP(FATAL, "Unknown compression \"{}\"! Use \"none\", \"lz4\", or \"zstd\".", compression);
+  }
+  mfileCompression = compression;
 }
 
 void DataOutputDirector::printOut()
@@ -469,6 +651,10 @@ void DataOutputDirector::printOut()
   LOGP(INFO, "DataOutputDirector");
   LOGP(INFO, "  Default file name    : {}", mfilenameBase);
   LOGP(INFO, "  Number of files      : {}", mfilenameBases.size());
+  LOGP(INFO, "  File format          : {}", mfileFormat);
+  if (isArrowFormat()) {
+    LOGP(INFO, "  File compression     : {}", mfileCompression);
+  }
 
   LOGP(INFO, "  DataOutputDescriptors: {}", mDataOutputDescriptors.size());
   for (auto const& ds : mDataOutputDescriptors) {
@@ -14,6 +14,7 @@
 #include "Framework/DataProcessingDevice.h"
 #include "Framework/ChannelMatching.h"
 #include "Framework/ControlService.h"
+#include "Framework/CommonServices.h"
 #include "Framework/ComputingQuotaEvaluator.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataProcessor.h"
@@ -155,6 +156,25 @@ void run_completion(uv_work_t* handle, int status)
   ZoneScopedN("run_completion");
 }
 
+// Callback to execute the user processing of a timeslice on one of
+// the processing streams. Everything else stays on the main thread.
+void run_stream_callback(uv_work_t* handle)
+{
+  ZoneScopedN("run_stream_callback");
+  TaskStreamInfo* stream = (TaskStreamInfo*)handle->data;
+  DataProcessingDevice::doProcess(*stream->context, stream->task);
+}
+
+// Executed on the main thread once the processing of a stream is done.
+// This only wakes up the loop, the outputs are sent by flushStreams
+// so that errors are not propagated through libuv.
+void run_stream_completion(uv_work_t* handle, int status)
+{
+  ZoneScopedN("run_stream_completion");
+  TaskStreamInfo* stream = (TaskStreamInfo*)handle->data;
+  stream->done = true;
+}
+
 // Context for polling
 struct PollerContext {
   char const* name = nullptr;
@@ -454,6 +474,99 @@ void DataProcessingDevice::InitTask()
   // do so on a per thread basis, with fine grained locks.
   mDataProcessorContexes.resize(1);
   this->fillContext(mDataProcessorContexes.at(0), mDeviceContext);
+
+  // Devices which require the threadpool service with more than one worker
+  // process independent timeslices concurrently, one per stream.
+  if (mState.loop && mServiceRegistry.active<ThreadPool>()) {
+    auto numStreams = mServiceRegistry.get<ThreadPool>().poolSize;
+    if (numStreams > 1) {
+      this->initStreams(numStreams);
+    }
+  }
+}
+
+/// Create the streams processing the timeslices concurrently. Each of them
+/// gets its own view of the ServiceRegistry, where the contexts collecting
+/// the outputs are private, so that the user code can create messages
+/// without any locking. Such messages are moved to the contexts of the
+/// device and sent on the main thread, in the order the timeslices
+/// were scheduled.
+void DataProcessingDevice::initStreams(int numStreams)
+{
+  LOGP(info, "Processing up to {} timeslices concurrently", numStreams);
+  mStreams.resize(numStreams);
+  mHandles.resize(numStreams);
+  mStreamResources.resize(numStreams);
+  mDataProcessorContexes.resize(numStreams + 1);
+
+  for (int si = 0; si < numStreams; ++si) {
+    auto& resources = mStreamResources[si];
+    resources.messageContext = std::make_unique<MessageContext>(FairMQDeviceProxy{this});
+    resources.stringContext = std::make_unique<StringContext>(FairMQDeviceProxy{this});
+    resources.arrowContext = std::make_unique<ArrowContext>(FairMQDeviceProxy{this});
+    resources.rawBufferContext = std::make_unique<RawBufferContext>(FairMQDeviceProxy{this});
+    resources.registry = std::make_unique<ServiceRegistry>(mServiceRegistry);
+    resources.registry->overrideService(resources.messageContext.get());
+    resources.registry->overrideService(resources.stringContext.get());
+    resources.registry->overrideService(resources.arrowContext.get());
+    resources.registry->overrideService(resources.rawBufferContext.get());
+    resources.allocator = std::make_unique<DataAllocator>(&resources.timingInfo, resources.registry.get(), mSpec.outputs);
+
+    auto& context = mDataProcessorContexes.at(si + 1);
+    context = mDataProcessorContexes.at(0);
+    context.registry = resources.registry.get();
+    context.timingInfo = &resources.timingInfo;
+    context.allocator = resources.allocator.get();
+
+    mStreams[si].id = TaskStreamRef{si};
+    mStreams[si].context = &context;
+  }
+}
+
+void DataProcessingDevice::scheduleTask(StreamTask&& task)
+{
+  mPendingTasks.emplace_back(std::move(task));
+  this->dispatchPendingTasks();
+}
+
+void DataProcessingDevice::dispatchPendingTasks()
+{
+  while (mPendingTasks.empty() == false) {
+    auto freeStream = std::find_if(mStreams.begin(), mStreams.end(), [](TaskStreamInfo const& stream) { return stream.running == false; });
+    if (freeStream == mStreams.end()) {
+      return;
+    }
+    auto si = freeStream->id.index;
+    if (mQuotaEvaluator.selectOffer(si, mSpec.resourcePolicy.request) == false) {
+      return;
+    }
+    auto& stream = mStreams[si];
+    auto& resources = mStreamResources[si];
+    stream.task = std::move(mPendingTasks.front());
+    mPendingTasks.pop_front();
+    stream.running = true;
+    stream.done = false;
+    resources.timingInfo = stream.task.timingInfo;
+    resources.messageContext->clear();
+    resources.stringContext->clear();
+    resources.arrowContext->clear();
+    resources.rawBufferContext->clear();
+    mStreamsInFlight.push_back(si);
+    mHandles[si].data = &stream;
+    uv_queue_work(mState.loop, &mHandles[si], run_stream_callback, run_stream_completion);
+  }
+}
+
+void DataProcessingDevice::drainStreams()
+{
+  if (this->hasStreams() == false) {
+    return;
+  }
+  this->flushStreams();
+  while (mStreamsInFlight.empty() == false) {
+    uv_run(mState.loop, UV_RUN_ONCE);
+    this->flushStreams();
+  }
 }
 
 void DataProcessingDevice::fillContext(DataProcessorContext& context, DeviceContext& deviceContext)
@@ -488,6 +601,7 @@ void DataProcessingDevice::PreRun()
 
 void DataProcessingDevice::PostRun()
 {
+  this->drainStreams();
   mServiceRegistry.get<CallbackService>()(CallbackService::Id::Stop);
   mServiceRegistry.preExitCallbacks();
 }
@@ -557,6 +671,24 @@ bool DataProcessingDevice::ConditionalRun()
     }
   }
 
+  // When processing on multiple streams, the user code is run by
+  // the libuv workers while receiving and sending stay on the main thread.
+  if (this->hasStreams()) {
+    this->flushStreams();
+    // Do not accept new data until some of the pending work is done, so that
+    // the upstream devices are throttled by the transport.
+    if (mPendingTasks.size() >= mStreams.size()) {
+      mWasActive = false;
+      FrameMark;
+      return true;
+    }
+    auto& context = mDataProcessorContexes.at(0);
+    doPrepare(context);
+    doRun(context);
+    FrameMark;
+    return true;
+  }
+
   assert(mStreams.size() == mHandles.size());
   /// Decide which task to use
   TaskStreamRef streamRef{-1};
@@ -721,6 +853,7 @@ void DataProcessingDevice::doRun(DataProcessorContext& context)
     while (DataProcessingDevice::tryDispatchComputation(context, *context.completed)) {
       context.relayer->processDanglingInputs(*context.expirationHandlers, *context.registry, false);
     }
+    context.deviceContext->device->drainStreams();
     EndOfStreamContext eosContext{*context.registry, *context.allocator};
 
     context.registry->preEOSCallbacks(eosContext);
@@ -898,6 +1031,134 @@ void update_maximum(std::atomic<T>& maximum_value, T const& value) noexcept
          !maximum_value.compare_exchange_weak(prev_value, value)) {
   }
 }
+
+/// Create an InputSpan for a set of inputs which were moved out of the relayer.
+InputSpan makeInputSpan(std::vector<MessageSet>& currentSetOfInputs)
+{
+  auto getter = [&currentSetOfInputs](size_t i, size_t partindex) -> DataRef {
+    if (currentSetOfInputs[i].size() > partindex) {
+      return DataRef{nullptr,
+                     static_cast<char const*>(currentSetOfInputs[i].at(partindex).header->GetData()),
+                     static_cast<char const*>(currentSetOfInputs[i].at(partindex).payload->GetData())};
+    }
+    return DataRef{nullptr, nullptr, nullptr};
+  };
+  auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
+    return currentSetOfInputs[i].size();
+  };
+  return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+}
+
+// This is how we do the forwarding, i.e. we push
+// the inputs which are shared between this device and others
+// to the next one in the daisy chain.
+// FIXME: do it in a smarter way than O(N^2)
+void forwardInputs(DataProcessorContext& context, std::vector<MessageSet>& currentSetOfInputs, InputRecord& record)
+{
+  ZoneScopedN("forward inputs");
+  auto reportError = [&registry = *context.registry](const char* message) {
+    registry.get<DataProcessingStats>().errorCount++;
+  };
+  auto& spec = context.deviceContext->spec;
+  auto& device = context.deviceContext->device;
+  assert(record.size() == currentSetOfInputs.size());
+  // we collect all messages per forward in a map and send them together
+  std::unordered_map<std::string, FairMQParts> forwardedParts;
+  for (size_t ii = 0, ie = record.size(); ii < ie; ++ii) {
+    DataRef input = record.getByPos(ii);
+
+    // If is now possible that the record is not complete when
+    // we forward it, because of a custom completion policy.
+    // this means that we need to skip the empty entries in the
+    // record for being forwarded.
+    if (input.header == nullptr) {
+      continue;
+    }
+    auto sih = o2::header::get<SourceInfoHeader*>(input.header);
+    if (sih) {
+      continue;
+    }
+
+    auto dh = o2::header::get<DataHeader*>(input.header);
+    if (!dh) {
+      reportError("Header is not a DataHeader?");
+      continue;
+    }
+    auto dph = o2::header::get<DataProcessingHeader*>(input.header);
+    if (!dph) {
+      reportError("Header stack does not contain DataProcessingHeader");
+      continue;
+    }
+
+    for (auto& part : currentSetOfInputs[ii]) {
+      for (auto const& forward : spec->forwards) {
+        if (DataSpecUtils::match(forward.matcher, dh->dataOrigin, dh->dataDescription, dh->subSpecification) == false || (dph->startTime % forward.maxTimeslices) != forward.timeslice) {
+          continue;
+        }
+        auto& header = part.header;
+        auto& payload = part.payload;
+
+        if (header.get() == nullptr) {
+          // FIXME: this should not happen, however it's actually harmless and
+          //        we can simply discard it for the moment.
+          // LOG(ERROR) << "Missing header! " << dh->dataDescription;
+          continue;
+        }
+        auto fdph = o2::header::get<DataProcessingHeader*>(header.get()->GetData());
+        if (fdph == nullptr) {
+          LOG(ERROR) << "Forwarded data does not have a DataProcessingHeader";
+          continue;
+        }
+        auto fdh = o2::header::get<DataHeader*>(header.get()->GetData());
+        if (fdh == nullptr) {
+          LOG(ERROR) << "Forwarded data does not have a DataHeader";
+          continue;
+        }
+   
+        forwardedParts[forward.channel].AddPart(std::move(header));
+        forwardedParts[forward.channel].AddPart(std::move(payload));
+      }
+    }
+  }
+  for (auto& [channelName, channelParts] : forwardedParts) {
+    if (channelParts.Size() == 0) {
+      continue;
+    }
+    assert(channelParts.Size() % 2 == 0);
+    assert(o2::header::get<DataProcessingHeader*>(channelParts.At(0)->GetData()));
+    // in DPL we are using subchannel 0 only
+    device->Send(channelParts, channelName, 0);
+  }
+}
+
+void preUpdateStats(DataProcessingStats& stats, DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart)
+{
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t ai = 0; ai != record.size(); ai++) {
+    auto cacheId = action.slot.index * record.size() + ai;
+    auto state = record.isValid(ai) ? 2 : 0;
+    update_maximum(stats.statesSize, cacheId + 1);
+    assert(cacheId < DataProcessingStats::MAX_RELAYER_STATES);
+    stats.relayerState[cacheId].store(state);
+  }
+}
+
+void postUpdateStats(DataProcessingStats& stats, DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart)
+{
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t ai = 0; ai != record.size(); ai++) {
+    auto cacheId = action.slot.index * record.size() + ai;
+    auto state = record.isValid(ai) ? 3 : 0;
+    update_maximum(stats.statesSize, cacheId + 1);
+    assert(cacheId < DataProcessingStats::MAX_RELAYER_STATES);
+    stats.relayerState[cacheId].store(state);
+  }
+  uint64_t tEnd = uv_hrtime();
+  stats.lastElapsedTimeMs = tEnd - tStart;
+  stats.lastProcessedSize = calculateTotalInputRecordSize(record);
+  stats.totalProcessedSize += stats.lastProcessedSize;
+  stats.lastLatency = calculateInputRecordLatency(record, tStart);
+}
 } // namespace
 
 bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed)
@@ -909,10 +1170,6 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   // should work just fine.
   std::vector<MessageSet> currentSetOfInputs;
 
-  auto reportError = [&registry = *context.registry, &context](const char* message) {
-    registry.get<DataProcessingStats>().errorCount++;
-  };
-
   // For the moment we have a simple "immediately dispatch" policy for stuff
   // in the cache. This could be controlled from the outside e.g. by waiting
   // for a few sets of inputs to arrive before we actually dispatch the
@@ -939,18 +1196,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   auto getInputSpan = [&relayer = context.relayer,
                        &currentSetOfInputs](TimesliceSlot slot) {
     currentSetOfInputs = std::move(relayer->getInputsForTimeslice(slot));
-    auto getter = [&currentSetOfInputs](size_t i, size_t partindex) -> DataRef {
-      if (currentSetOfInputs[i].size() > partindex) {
-        return DataRef{nullptr,
-                       static_cast<char const*>(currentSetOfInputs[i].at(partindex).header->GetData()),
-                       static_cast<char const*>(currentSetOfInputs[i].at(partindex).payload->GetData())};
-      }
-      return DataRef{nullptr, nullptr, nullptr};
-    };
-    auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
-      return currentSetOfInputs[i].size();
-    };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    return makeInputSpan(currentSetOfInputs);
   };
 
   auto markInputsAsDone = [&relayer = context.relayer](TimesliceSlot slot) -> void {
@@ -1011,84 +1257,6 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
   };
 
-  // This is how we do the forwarding, i.e. we push
-  // the inputs which are shared between this device and others
-  // to the next one in the daisy chain.
-  // FIXME: do it in a smarter way than O(N^2)
-  auto forwardInputs = [&reportError,
-                        &spec = context.deviceContext->spec,
-                        &device = context.deviceContext->device, &currentSetOfInputs](TimesliceSlot slot, InputRecord& record) {
-    ZoneScopedN("forward inputs");
-    assert(record.size() == currentSetOfInputs.size());
-    // we collect all messages per forward in a map and send them together
-    std::unordered_map<std::string, FairMQParts> forwardedParts;
-    for (size_t ii = 0, ie = record.size(); ii < ie; ++ii) {
-      DataRef input = record.getByPos(ii);
-
-      // If is now possible that the record is not complete when
-      // we forward it, because of a custom completion policy.
-      // this means that we need to skip the empty entries in the
-      // record for being forwarded.
-      if (input.header == nullptr) {
-        continue;
-      }
-      auto sih = o2::header::get<SourceInfoHeader*>(input.header);
-      if (sih) {
-        continue;
-      }
-
-      auto dh = o2::header::get<DataHeader*>(input.header);
-      if (!dh) {
-        reportError("Header is not a DataHeader?");
-        continue;
-      }
-      auto dph = o2::header::get<DataProcessingHeader*>(input.header);
-      if (!dph) {
-        reportError("Header stack does not contain DataProcessingHeader");
-        continue;
-      }
-
-      for (auto& part : currentSetOfInputs[ii]) {
-        for (auto const& forward : spec->forwards) {
-          if (DataSpecUtils::match(forward.matcher, dh->dataOrigin, dh->dataDescription, dh->subSpecification) == false || (dph->startTime % forward.maxTimeslices) != forward.timeslice) {
-            continue;
-          }
-          auto& header = part.header;
-          auto& payload = part.payload;
-
-          if (header.get() == nullptr) {
-            // FIXME: this should not happen, however it's actually harmless and
-            //        we can simply discard it for the moment.
-            // LOG(ERROR) << "Missing header! " << dh->dataDescription;
-            continue;
-          }
-          auto fdph = o2::header::get<DataProcessingHeader*>(header.get()->GetData());
-          if (fdph == nullptr) {
-            LOG(ERROR) << "Forwarded data does not have a DataProcessingHeader";
-            continue;
-          }
-          auto fdh = o2::header::get<DataHeader*>(header.get()->GetData());
-          if (fdh == nullptr) {
-            LOG(ERROR) << "Forwarded data does not have a DataHeader";
-            continue;
-          }
-     
-          forwardedParts[forward.channel].AddPart(std::move(header));
-          forwardedParts[forward.channel].AddPart(std::move(payload));
-        }
-      }
-    }
-    for (auto& [channelName, channelParts] : forwardedParts) {
-      if (channelParts.Size() == 0) {
-        continue;
-      }
-      assert(channelParts.Size() % 2 == 0);
-      assert(o2::header::get<DataProcessingHeader*>(channelParts.At(0)->GetData()));
-      // in DPL we are using subchannel 0 only
-      device->Send(channelParts, channelName, 0);
-    }
-  };
-
   auto switchState = [&control = context.registry->get<ControlService>(),
                       &state = context.deviceContext->state](StreamingState newState) {
     state->streaming = newState;
@@ -1099,32 +1267,13 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     return false;
   }
 
-  auto postUpdateStats = [& stats = context.registry->get<DataProcessingStats>()](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
-    std::atomic_thread_fence(std::memory_order_release);
-    for (size_t ai = 0; ai != record.size(); ai++) {
-      auto cacheId = action.slot.index * record.size() + ai;
-      auto state = record.isValid(ai) ? 3 : 0;
-      update_maximum(stats.statesSize, cacheId + 1);
-      assert(cacheId < DataProcessingStats::MAX_RELAYER_STATES);
-      stats.relayerState[cacheId].store(state);
-    }
-    uint64_t tEnd = uv_hrtime();
-    stats.lastElapsedTimeMs = tEnd - tStart;
-    stats.lastProcessedSize = calculateTotalInputRecordSize(record);
-    stats.totalProcessedSize += stats.lastProcessedSize;
-    stats.lastLatency = calculateInputRecordLatency(record, tStart);
-  };
-
-  auto preUpdateStats = [& stats = context.registry->get<DataProcessingStats>()](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
-    std::atomic_thread_fence(std::memory_order_release);
-    for (size_t ai = 0; ai != record.size(); ai++) {
-      auto cacheId = action.slot.index * record.size() + ai;
-      auto state = record.isValid(ai) ? 2 : 0;
-      update_maximum(stats.statesSize, cacheId + 1);
-      assert(cacheId < DataProcessingStats::MAX_RELAYER_STATES);
-      stats.relayerState[cacheId].store(state);
-    }
-  };
+  // With multiple streams the outputs are sent in the order the timeslices
+  // are dispatched, so we make sure they are dispatched in timeslice order.
+  if (context.deviceContext->device->hasStreams()) {
+    std::sort(completed.begin(), completed.end(), [&relayer = context.relayer](auto const& a, auto const& b) {
+      return relayer->getTimesliceForSlot(a.slot).value < relayer->getTimesliceForSlot(b.slot).value;
+    });
+  }
 
   for (auto action : getReadyActions()) {
     if (action.op == CompletionPolicy::CompletionOp::Wait) {
@@ -1142,14 +1291,21 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
-        forwardInputs(action.slot, record);
+        forwardInputs(context, currentSetOfInputs, record);
         continue;
       }
     }
     markInputsAsDone(action.slot);
 
     uint64_t tStart = uv_hrtime();
-    preUpdateStats(action, record, tStart);
+    preUpdateStats(context.registry->get<DataProcessingStats>(), action, record, tStart);
+    // When running multiple streams, the inputs are handed over to the first
+    // available one. The outputs are sent and the inputs forwarded only once
+    // all the timeslices scheduled before are done.
+    if (action.op == CompletionPolicy::CompletionOp::Consume && context.deviceContext->device->hasStreams()) {
+      context.deviceContext->device->scheduleTask(StreamTask{action, *context.timingInfo, std::move(currentSetOfInputs), tStart});
+      continue;
+    }
     try {
       if (context.deviceContext->state->quitRequested == false) {
 
@@ -1179,13 +1335,13 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       (*context.errorHandling)(e, record);
     }
 
-    postUpdateStats(action, record, tStart);
+    postUpdateStats(context.registry->get<DataProcessingStats>(), action, record, tStart);
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
-        forwardInputs(action.slot, record);
+        forwardInputs(context, currentSetOfInputs, record);
       }
 #ifdef TRACY_ENABLE
         cleanupRecord(record);
@@ -1196,6 +1352,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   }
   // We now broadcast the end of stream if it was requested
   if (context.deviceContext->state->streaming == StreamingState::EndOfStreaming) {
+    context.deviceContext->device->drainStreams();
     for (auto& channel : context.deviceContext->spec->outputChannels) {
       DataProcessingHelpers::sendEndOfStream(*context.deviceContext->device, channel);
     }
@@ -1211,4 +1368,89 @@ void DataProcessingDevice::error(const char* msg)
   mServiceRegistry.get<DataProcessingStats>().errorCount++;
 }
 
+/// Run the user processing for a timeslice handed over to a stream. This is
+/// executed by a worker thread and only touches the stream's own services.
+/// Any error is reported back to the main thread.
+void DataProcessingDevice::doProcess(DataProcessorContext& context, StreamTask& task)
+{
+  ZoneScopedN("DataProcessingDevice::doProcess");
+  InputSpan span = makeInputSpan(task.inputs);
+  InputRecord record{context.deviceContext->spec->inputs, span};
+  ProcessingContext processContext{record, *context.registry, *context.allocator};
+  try {
+    if (context.deviceContext->state->quitRequested == false) {
+      if (*context.statefulProcess) {
+        ZoneScopedN("statefull process");
+        (*context.statefulProcess)(processContext);
+      }
+      if (*context.statelessProcess) {
+        ZoneScopedN("stateless process");
+        (*context.statelessProcess)(processContext);
+      }
+    }
+  } catch (std::exception& ex) {
+    task.error = runtime_error(ex.what());
+    task.failed = true;
+  } catch (o2::framework::RuntimeErrorRef e) {
+    task.error = e;
+    task.failed = true;
+  }
+}
+
+void DataProcessingDevice::flushStreams()
+{
+  ZoneScopedN("DataProcessingDevice::flushStreams");
+  auto& context = mDataProcessorContexes.at(0);
+  while (mStreamsInFlight.empty() == false && mStreams[mStreamsInFlight.front()].done) {
+    auto si = mStreamsInFlight.front();
+    mStreamsInFlight.pop_front();
+    auto& stream = mStreams[si];
+    auto& resources = mStreamResources[si];
+    auto& task = stream.task;
+
+    // The outputs of the stream are moved to the device contexts, so that
+    // the usual post processing callbacks send them.
+    mServiceRegistry.get<MessageContext>().merge(*resources.messageContext);
+    mServiceRegistry.get<StringContext>().merge(*resources.stringContext);
+    mServiceRegistry.get<ArrowContext>().merge(*resources.arrowContext);
+    mServiceRegistry.get<RawBufferContext>().merge(*resources.rawBufferContext);
+    mTimingInfo = task.timingInfo;
+
+    InputSpan span = makeInputSpan(task.inputs);
+    InputRecord record{mSpec.inputs, span};
+    ProcessingContext processContext{record, mServiceRegistry, mAllocator};
+    try {
+      if (task.failed) {
+        throw task.error;
+      }
+      if (mState.quitRequested == false) {
+        ZoneScopedN("service post processing");
+        mServiceRegistry.postProcessingCallbacks(processContext);
+      }
+    } catch (std::exception& ex) {
+      ZoneScopedN("error handling");
+      auto e = runtime_error(ex.what());
+      mErrorHandling(e, record);
+    } catch (o2::framework::RuntimeErrorRef e) {
+      ZoneScopedN("error handling");
+      mErrorHandling(e, record);
+    }
+    postUpdateStats(mServiceRegistry.get<DataProcessingStats>(), task.action, record, task.tStart);
+    mServiceRegistry.postDispatchingCallbacks(processContext);
+    if (mSpec.forwards.empty() == false) {
+      forwardInputs(context, task.inputs, record);
+    }
+
+    for (auto& consumer : mState.offerConsumers) {
+      mQuotaEvaluator.consume(si, consumer);
+    }
+    mState.offerConsumers.clear();
+    mQuotaEvaluator.dispose(si);
+    task = StreamTask{};
+    stream.done = false;
+    stream.running = false;
+  }
+  this->dispatchPendingTasks();
+}
+
 } // namespace o2::framework
@@ -55,10 +55,16 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mMetrics{metrics},
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
-    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)}
+    mConcreteRoutes{DataRelayerHelpers::createConcreteRouteIndex(routes, mDistinctRoutesIndex)},
+    mWildcardRoutes{DataRelayerHelpers::createWildcardRouteIndex(routes, mDistinctRoutesIndex)}
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
+  for (auto& matcher : DataRelayerHelpers::createInputMatchers(routes)) {
+    mInputPrograms.emplace_back(matcher);
+  }
+  mWildcardCandidates.reserve(mWildcardRoutes.size());
+
   setPipelineLength(DEFAULT_PIPELINE_LENGTH);
 
   // The queries are all the same, so we only have width 1
@@ -155,19 +161,57 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// Only the routes which can accept the (origin, description, subSpec) of
+/// the message are evaluated, in the same order as the full list, so that
+/// the first matching route is selected as if all of them were checked.
+/// @a wildcardRoutes only needs to contain the wildcard routes for which
+/// DataMatcherProgram::mayMatch() succeeds.
 size_t matchToContext(void* data,
-                      std::vector<DataDescriptorMatcher> const& matchers,
+                      std::vector<DataMatcherProgram> const& matchers,
                       std::vector<size_t> const& index,
+                      std::unordered_map<ConcreteDataMatcher, std::vector<size_t>> const& concreteRoutes,
+                      std::vector<size_t> const& wildcardRoutes,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+  auto tryRoute = [&data, &matchers, &index, &context](size_t ri) -> bool {
     auto& matcher = matchers[index[ri]];
 
     if (matcher.match(reinterpret_cast<char const*>(data), context)) {
       context.commit();
-      return ri;
+      return true;
     }
     context.discard();
+    return false;
+  };
+
+  auto dh = o2::header::get<DataHeader*>(data);
+  if (dh == nullptr) {
+    // Let the matchers complain about the missing header.
+    for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+      if (tryRoute(ri)) {
+        return ri;
+      }
+    }
+    return INVALID_INPUT;
+  }
+
+  static std::vector<size_t> const noRoutes;
+  auto concreteIt = concreteRoutes.find(ConcreteDataMatcher{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
+  auto const& concrete = concreteIt != concreteRoutes.end() ? concreteIt->second : noRoutes;
+
+  // Both lists are sorted, we merge them to keep the original precedence.
+  auto ci = concrete.begin();
+  auto wi = wildcardRoutes.begin();
+  while (ci != concrete.end() || wi != wildcardRoutes.end()) {
+    size_t ri;
+    if (wi == wildcardRoutes.end() || (ci != concrete.end() && *ci < *wi)) {
+      ri = *ci++;
+    } else {
+      ri = *wi++;
+    }
+    if (tryRoute(ri)) {
+      return ri;
+    }
   }
   return INVALID_INPUT;
 }
@@ -214,14 +258,16 @@ DataRelayer::RelayChoice
   // This returns the identifier for the given input. We use a separate
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
-  auto getInputTimeslice = [& matchers = mInputMatchers,
+  auto getInputTimeslice = [& matchers = mInputPrograms,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &concreteRoutes = mConcreteRoutes,
+                            &wildcardRoutes = mWildcardCandidates,
                             &header,
                             &index](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(header->GetData(), matchers, distinctRoutes, context);
+    auto input = matchToContext(header->GetData(), matchers, distinctRoutes, concreteRoutes, wildcardRoutes, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -307,6 +353,16 @@ DataRelayer::RelayChoice
   auto timeslice = TimesliceId{TimesliceId::INVALID};
   auto slot = TimesliceSlot{TimesliceSlot::INVALID};
 
+  // Discard once the wildcard routes which cannot accept this message,
+  // rather than evaluating them again for every slot.
+  mWildcardCandidates.clear();
+  auto relayedHeader = o2::header::get<DataHeader*>(header->GetData());
+  for (auto ri : mWildcardRoutes) {
+    if (relayedHeader == nullptr || mInputPrograms[mDistinctRoutesIndex[ri]].mayMatch(*relayedHeader)) {
+      mWildcardCandidates.push_back(ri);
+    }
+  }
+
   bool needsCleaning = false;
   // First look for matching slots which already have some
   // partial match.
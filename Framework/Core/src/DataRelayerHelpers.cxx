@@ -10,6 +10,8 @@
 
 #include "DataRelayerHelpers.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataSpecUtils.h"
+#include <optional>
 #include <stdexcept>
 
 using namespace o2::framework::data_matcher;
@@ -34,6 +36,25 @@ DataDescriptorMatcher fromConcreteMatcher(ConcreteDataMatcher const& matcher)
           DataDescriptorMatcher::Op::Just,
           SubSpecificationTypeValueMatcher{matcher.subSpec})))};
 }
+
+/// The only (origin, description, subSpec) a route can match, if any.
+/// Queries with an OR are never considered unique.
+std::optional<ConcreteDataMatcher> uniqueMatcherFor(InputRoute const& route)
+{
+  if (auto pval = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
+    return *pval;
+  }
+  try {
+    auto origin = DataSpecUtils::getOptionalOrigin(route.matcher);
+    auto description = DataSpecUtils::getOptionalDescription(route.matcher);
+    auto subSpec = DataSpecUtils::getOptionalSubSpec(route.matcher);
+    if (origin && description && subSpec) {
+      return ConcreteDataMatcher{*origin, *description, *subSpec};
+    }
+  } catch (...) {
+  }
+  return {};
+}
 } // namespace
 
 std::vector<size_t>
@@ -68,4 +89,30 @@ std::vector<DataDescriptorMatcher>
   return result;
 }
 
+std::unordered_map<ConcreteDataMatcher, std::vector<size_t>>
+  DataRelayerHelpers::createConcreteRouteIndex(std::vector<InputRoute> const& routes,
+                                               std::vector<size_t> const& distinctRoutes)
+{
+  std::unordered_map<ConcreteDataMatcher, std::vector<size_t>> result;
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    if (auto concrete = uniqueMatcherFor(routes[distinctRoutes[ri]])) {
+      result[*concrete].push_back(ri);
+    }
+  }
+  return result;
+}
+
+std::vector<size_t>
+  DataRelayerHelpers::createWildcardRouteIndex(std::vector<InputRoute> const& routes,
+                                               std::vector<size_t> const& distinctRoutes)
+{
+  std::vector<size_t> result;
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    if (uniqueMatcherFor(routes[distinctRoutes[ri]]).has_value() == false) {
+      result.push_back(ri);
+    }
+  }
+  return result;
+}
+
 } // namespace o2::framework
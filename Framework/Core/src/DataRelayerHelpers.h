@@ -11,6 +11,7 @@
 #define O2_FRAMEWORK_DATARELAYERHELPERS_H_
 
 #include "Framework/InputRoute.h"
+#include <unordered_map>
 #include <vector>
 
 namespace o2::framework
@@ -22,6 +23,14 @@ struct DataRelayerHelpers {
   static std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const&);
   /// This converts from InputRoute to the associated DataDescriptorMatcher.
   static std::vector<data_matcher::DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const&);
+  /// Map the (origin, description, subSpec) accepted by the distinct routes which
+  /// can only match that, to their (sorted) positions in @a distinctRoutes.
+  static std::unordered_map<ConcreteDataMatcher, std::vector<size_t>> createConcreteRouteIndex(std::vector<InputRoute> const& routes,
+                                                                                              std::vector<size_t> const& distinctRoutes);
+  /// Positions in @a distinctRoutes of the routes which can match more than one
+  /// (origin, description, subSpec).
+  static std::vector<size_t> createWildcardRouteIndex(std::vector<InputRoute> const& routes,
+                                                      std::vector<size_t> const& distinctRoutes);
 };
 
 } // namespace o2::framework
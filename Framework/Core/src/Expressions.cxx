@@ -395,6 +395,53 @@ Selection createSelection(std::shared_ptr<arrow::Table> table,
   return createSelection(table, createFilter(table->schema(), createOperations(std::move(expression))));
 }
 
+CompactSelection::CompactSelection(Selection const& selection, int64_t nrows)
+  : mSize{selection->GetNumSlots()}
+{
+  if (mSize > nrows / 64) {
+    mBitmap.assign((nrows + 63) / 64, 0);
+    for (int64_t i = 0; i < mSize; ++i) {
+      auto row = selection->GetIndex(i);
+      mBitmap[row / 64] |= uint64_t{1} << (row % 64);
+    }
+  } else {
+    mIndices.reserve(mSize);
+    for (int64_t i = 0; i < mSize; ++i) {
+      mIndices.push_back(selection->GetIndex(i));
+    }
+  }
+}
+
+namespace
+{
+/// the tables of a dataframe are identified by the address of their data
+void const* firstBuffer(arrow::Table const& table)
+{
+  for (auto const& column : table.columns()) {
+    for (auto const& chunk : column->chunks()) {
+      for (auto const& buffer : chunk->data()->buffers) {
+        if (buffer != nullptr) {
+          return buffer->data();
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
+CompactSelection const& SelectionCache::select(std::set<size_t> const& hashes, gandiva::NodePtr const& tree, std::shared_ptr<arrow::Table> const& table)
+{
+  auto key = std::make_tuple(hashes, std::hash<std::string>{}(tree->ToString()), firstBuffer(*table), table->num_rows());
+  auto cached = mSelections.find(key);
+  if (cached == mSelections.end()) {
+    auto selection = createSelection(table, createFilter(table->schema(), makeCondition(tree)));
+    ++mEvaluations;
+    cached = mSelections.emplace(std::move(key), CompactSelection{selection, table->num_rows()}).first;
+  }
+  return cached->second;
+}
+
 auto createProjection(std::shared_ptr<arrow::Table> table, std::shared_ptr<gandiva::Projector> gprojector)
 {
   arrow::TableBatchReader reader(*table);
@@ -10,6 +10,7 @@
 
 #include "Framework/HistogramRegistry.h"
 #include <regex>
+#include <memory>
 #include <TList.h>
 
 namespace o2::framework
@@ -261,9 +262,73 @@ void HistogramRegistry::print(bool showAxisDetails)
   LOGF(INFO, "");
 }
 
+void HistogramRegistry::setBufferedFill(bool buffered)
+{
+  if (buffered && !mFillShards) {
+    mFillShards = std::make_shared<FillShards>();
+  } else if (!buffered && mFillShards) {
+    flush();
+    mFillShards.reset();
+  }
+}
+
+HistFillBuffer& HistogramRegistry::getFillBuffer(uint32_t idx)
+{
+  // a registry creates a new shard the first time a thread fills it
+  auto& threadShards = threadFillShards();
+  for (size_t i = 0; i < threadShards.size();) {
+    auto& [owner, shard] = threadShards[i];
+    if (!owner.owner_before(mFillShards) && !mFillShards.owner_before(owner)) {
+      return shard->buffers[idx];
+    }
+    if (owner.expired()) { // the registry was destroyed or stopped buffering
+      threadShards[i] = std::move(threadShards.back());
+      threadShards.pop_back();
+      continue;
+    }
+    ++i;
+  }
+  std::lock_guard<std::mutex> lock(mFillShards->mutex);
+  auto* shard = mFillShards->shards.emplace_back(std::make_unique<FillShard>()).get();
+  threadShards.emplace_back(mFillShards, shard);
+  return shard->buffers[idx];
+}
+
+// each thread remembers the shard it got from every registry it filled. The weak pointer tells the registries
+// apart even if one is destroyed and another one reuses its memory, and lets the entries of destroyed ones be pruned
+std::vector<std::pair<std::weak_ptr<HistogramRegistry::FillShards>, HistogramRegistry::FillShard*>>& HistogramRegistry::threadFillShards()
+{
+  thread_local std::vector<std::pair<std::weak_ptr<FillShards>, FillShard*>> threadShards;
+  return threadShards;
+}
+
+size_t HistogramRegistry::getNThreadFillShards()
+{
+  return threadFillShards().size();
+}
+
+// merge the per-thread fill buffers into the histograms
+void HistogramRegistry::flush()
+{
+  if (!mFillShards) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mFillShards->mutex);
+  for (auto& shard : mFillShards->shards) {
+    if (!shard) {
+      continue;
+    }
+    for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+      std::visit([&](auto&& hist) { if (hist) { HistFiller::flushBuffer(hist, shard->buffers[i]); } }, mRegistryValue[i]);
+    }
+  }
+}
+
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::operator*()
 {
+  flush();
+
   TList* list = new TList();
   list->SetName(mName.data());
 
@@ -63,6 +63,25 @@ void ServiceRegistry::registerService(hash_type typeHash, void* service, Service
                            ". Make sure you use const / non-const correctly.");
 }
 
+/// Replace all the instances of the service identified by @a typeHash,
+/// regardless of the thread they were registered for, with @a service.
+/// This method is not thread safe.
+void ServiceRegistry::overrideService(hash_type typeHash, void* service)
+{
+  bool found = false;
+  for (size_t i = 0; i < MAX_SERVICES + MAX_DISTANCE; ++i) {
+    if (mServicesKey[i].load() != typeHash) {
+      continue;
+    }
+    mServicesValue[i] = service;
+    found = true;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  if (found == false) {
+    throw std::runtime_error(std::string("Unable to override service ") + std::to_string(typeHash) + ". Service was never registered.");
+  }
+}
+
 void ServiceRegistry::declareService(ServiceSpec const& spec, DeviceState& state, fair::mq::ProgOptions& options)
 {
   mSpecs.push_back(spec);
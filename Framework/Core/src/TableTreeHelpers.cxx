@@ -8,11 +8,21 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/TableTreeHelpers.h"
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 #include "Framework/Logger.h"
 
+#include "arrow/array.h"
+#include "arrow/buffer.h"
 #include "arrow/type_traits.h"
 
+#include <RConfig.h>
+#include <TBufferFile.h>
+#include <TChain.h>
+#include <TROOT.h>
+
 namespace o2::framework
 {
 
@@ -103,6 +113,69 @@ class ColumnIterator
   // with this mArray is prepared to be used in arrow::Table::Make
   void finish();
 };
+
+// .............................................................................
+// BulkColumnReader is used by TreeToTable for the flat numeric columns
+//  instead of the ColumnIterator. The branch is read basket by basket with the
+//  TBranch bulk I/O and the serialized values are byte-swapped directly into a
+//  preallocated arrow::Buffer, bypassing the TTreeReader and the arrow::TBuilder
+//
+// .............................................................................
+class BulkColumnReader
+{
+
+ private:
+  TBranch* mBranch = nullptr;
+  EDataType mElementType;
+  const char* mColumnName;
+
+  std::shared_ptr<arrow::Field> mField;
+  std::shared_ptr<arrow::Array> mArray;
+
+  template <typename T>
+  bool readAs(int64_t numEntries, TBufferFile& buffer);
+
+ public:
+  BulkColumnReader(TBranch* branch, EDataType elementType, const char* colname);
+
+  // can the branch @a br be read with the bulk I/O
+  static bool accepts(TTree* tree, TBranch* br, EDataType& elementType);
+
+  // read the first numEntries entries of the branch into mArray
+  // buffer is the scratch buffer the baskets are read into
+  bool read(int64_t numEntries, TBufferFile& buffer);
+
+  std::shared_ptr<arrow::Array> getArray() { return mArray; }
+  std::shared_ptr<arrow::Field> getSchema() { return mField; }
+};
+
+// copy n values serialized by ROOT (big-endian) to dest
+// the fixed width loop over unsigned integers is vectorized by the compiler
+template <typename T>
+void copySerialized(T* dest, const char* src, int64_t n)
+{
+#ifdef R__BYTESWAP
+  if constexpr (sizeof(T) == 1) {
+    std::memcpy(dest, src, n);
+  } else {
+    using U = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+    auto out = reinterpret_cast<U*>(dest);
+    for (int64_t i = 0; i < n; ++i) {
+      U value;
+      std::memcpy(&value, src + i * sizeof(U), sizeof(U));
+      if constexpr (sizeof(U) == 2) {
+        out[i] = __builtin_bswap16(value);
+      } else if constexpr (sizeof(U) == 4) {
+        out[i] = __builtin_bswap32(value);
+      } else {
+        out[i] = __builtin_bswap64(value);
+      }
+    }
+  }
+#else
+  std::memcpy(dest, src, n * sizeof(T));
+#endif
+}
 } // namespace
 
 // is used in TableToTree
@@ -836,6 +909,107 @@ void ColumnIterator::finish()
   }
 }
 
+BulkColumnReader::BulkColumnReader(TBranch* branch, EDataType elementType, const char* colname)
+  : mBranch{branch},
+    mElementType{elementType},
+    mColumnName{colname}
+{
+}
+
+bool BulkColumnReader::accepts(TTree* tree, TBranch* br, EDataType& elementType)
+{
+  // the baskets of a TChain are spread over several trees
+  if (!br || tree->InheritsFrom(TChain::Class())) {
+    return false;
+  }
+
+  // only single-value branches of the form e.g. alpha/D
+  if (br->GetListOfLeaves()->GetEntries() != 1 || std::string(br->GetTitle()).find("[") != std::string::npos) {
+    return false;
+  }
+
+  TClass* cl;
+  br->GetExpectedType(cl, elementType);
+  switch (elementType) {
+    case EDataType::kUChar_t:
+    case EDataType::kUShort_t:
+    case EDataType::kUInt_t:
+    case EDataType::kULong64_t:
+    case EDataType::kChar_t:
+    case EDataType::kShort_t:
+    case EDataType::kInt_t:
+    case EDataType::kLong64_t:
+    case EDataType::kFloat_t:
+    case EDataType::kDouble_t:
+      break;
+    default:
+      // bool needs to be bit-packed for arrow
+      return false;
+  }
+  return br->SupportsBulkRead();
+}
+
+template <typename T>
+bool BulkColumnReader::readAs(int64_t numEntries, TBufferFile& buffer)
+{
+  auto type = arrow::TypeTraits<typename arrow::CTypeTraits<T>::ArrowType>::type_singleton();
+  mField = std::make_shared<arrow::Field>(mColumnName, type);
+
+  auto allocated = arrow::AllocateBuffer(numEntries * sizeof(T));
+  if (!allocated.ok()) {
+    LOGP(ERROR, "Can not allocate {} entries for column {}: {}", numEntries, mColumnName, allocated.status().ToString());
+    return false;
+  }
+  std::shared_ptr<arrow::Buffer> values = std::move(allocated).ValueOrDie();
+  auto data = reinterpret_cast<T*>(values->mutable_data());
+
+  // every call returns the entries of one basket, starting at its first entry
+  auto& bulk = mBranch->GetBulkRead();
+  int64_t readEntries = 0;
+  while (readEntries < numEntries) {
+    auto n = bulk.GetEntriesSerialized(readEntries, buffer);
+    if (n <= 0) {
+      LOGP(ERROR, "Bulk read of column {} failed at entry {}", mColumnName, readEntries);
+      return false;
+    }
+    n = std::min<int64_t>(n, numEntries - readEntries);
+    copySerialized(data + readEntries, buffer.GetCurrent(), n);
+    readEntries += n;
+  }
+
+  mArray = arrow::MakeArray(arrow::ArrayData::Make(type, numEntries, {nullptr, values}));
+  return true;
+}
+
+bool BulkColumnReader::read(int64_t numEntries, TBufferFile& buffer)
+{
+  switch (mElementType) {
+    case EDataType::kUChar_t:
+      return readAs<uint8_t>(numEntries, buffer);
+    case EDataType::kUShort_t:
+      return readAs<uint16_t>(numEntries, buffer);
+    case EDataType::kUInt_t:
+      return readAs<uint32_t>(numEntries, buffer);
+    case EDataType::kULong64_t:
+      return readAs<uint64_t>(numEntries, buffer);
+    case EDataType::kChar_t:
+      return readAs<int8_t>(numEntries, buffer);
+    case EDataType::kShort_t:
+      return readAs<int16_t>(numEntries, buffer);
+    case EDataType::kInt_t:
+      return readAs<int32_t>(numEntries, buffer);
+    case EDataType::kLong64_t:
+      return readAs<int64_t>(numEntries, buffer);
+    case EDataType::kFloat_t:
+      return readAs<float>(numEntries, buffer);
+    case EDataType::kDouble_t:
+      return readAs<double>(numEntries, buffer);
+    default:
+      LOGP(FATAL, "Type {} not handled!", mElementType);
+      return false;
+  }
+}
+
 void TreeToTable::addColumn(const char* colname)
 {
   mColumnNames.push_back(colname);
@@ -861,22 +1035,48 @@ bool TreeToTable::addAllColumns(TTree* tree)
 void TreeToTable::fill(TTree* tree)
 {
   std::vector<std::unique_ptr<ColumnIterator>> columnIterators;
+  std::vector<std::unique_ptr<BulkColumnReader>> bulkColumns;
+  // position of each column in the table, separately for the two kinds of columns
+  std::vector<size_t> iteratorPositions;
+  std::vector<size_t> bulkPositions;
   TTreeReader treeReader{tree};
 
   tree->SetCacheSize(50000000);
   tree->SetClusterPrefetch(true);
-  for (auto&& columnName : mColumnNames) {
+  // let the cache decompress the baskets of the different branches concurrently
+  if (ROOT::IsImplicitMTEnabled()) {
+    tree->SetParallelUnzip(true);
+  }
+  for (size_t ci = 0; ci < mColumnNames.size(); ++ci) {
+    auto& columnName = mColumnNames[ci];
     tree->AddBranchToCache(columnName.c_str(), true);
+    EDataType elementType;
+    auto br = tree->GetBranch(columnName.c_str());
+    if (BulkColumnReader::accepts(tree, br, elementType)) {
+      bulkColumns.push_back(std::make_unique<BulkColumnReader>(br, elementType, columnName.c_str()));
+      bulkPositions.push_back(ci);
+      continue;
+    }
     auto colit = std::make_unique<ColumnIterator>(treeReader, columnName.c_str());
     auto stat = colit->getStatus();
     if (!stat) {
       throw std::runtime_error("Unable to convert column " + columnName);
     }
     columnIterators.push_back(std::move(colit));
+    iteratorPositions.push_back(ci);
   }
   tree->StopCacheLearningPhase();
   auto numEntries = treeReader.GetEntries(true);
-  if (numEntries > 0) {
+
+  // read the flat numeric columns basket by basket
+  TBufferFile buffer{TBuffer::kWrite, 32 * 1024};
+  for (size_t bi = 0; bi < bulkColumns.size(); ++bi) {
+    if (!bulkColumns[bi]->read(numEntries, buffer)) {
+      throw std::runtime_error("Unable to convert column " + mColumnNames[bulkPositions[bi]]);
+    }
+  }
+
+  if (numEntries > 0 && !columnIterators.empty()) {
     for (auto&& column : columnIterators) {
       column->reserve(numEntries);
     }
@@ -890,12 +1090,17 @@ void TreeToTable::fill(TTree* tree)
   }
 
   // prepare the elements needed to create the final table
-  std::vector<std::shared_ptr<arrow::Array>> array_vector;
-  std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-  for (auto&& colit : columnIterators) {
+  std::vector<std::shared_ptr<arrow::Array>> array_vector(mColumnNames.size());
+  std::vector<std::shared_ptr<arrow::Field>> schema_vector(mColumnNames.size());
+  for (size_t ii = 0; ii < columnIterators.size(); ++ii) {
+    auto& colit = columnIterators[ii];
     colit->finish();
-    array_vector.push_back(colit->getArray());
-    schema_vector.push_back(colit->getSchema());
+    array_vector[iteratorPositions[ii]] = colit->getArray();
+    schema_vector[iteratorPositions[ii]] = colit->getSchema();
+  }
+  for (size_t bi = 0; bi < bulkColumns.size(); ++bi) {
+    array_vector[bulkPositions[bi]] = bulkColumns[bi]->getArray();
+    schema_vector[bulkPositions[bi]] = bulkColumns[bi]->getSchema();
   }
   auto fields = std::make_shared<arrow::Schema>(schema_vector);
 
@@ -45,6 +45,8 @@ std::vector<ConfigParamSpec> WorkflowCustomizationHelpers::requiredWorkflowOptio
                                        ConfigParamSpec{"aod-writer-resfile", VariantType::String, "", {"Default name of the output file"}},
                                        ConfigParamSpec{"aod-writer-resmode", VariantType::String, "RECREATE", {"Creation mode of the result files: NEW, CREATE, RECREATE, UPDATE"}},
                                        ConfigParamSpec{"aod-writer-ntfmerge", VariantType::Int, -1, {"Number of time frames to merge into one file"}},
+                                       ConfigParamSpec{"aod-writer-format", VariantType::String, "", {"Format of the result files: root (TTrees), arrow (Arrow IPC files)"}},
+                                       ConfigParamSpec{"aod-writer-compression", VariantType::String, "", {"Compression of the Arrow IPC result files: none, lz4, zstd"}},
                                        ConfigParamSpec{"aod-writer-keep", VariantType::String, "", {"Comma separated list of ORIGIN/DESCRIPTION/SUBSPECIFICATION:treename:col1/col2/..:filename"}},
 
                                        ConfigParamSpec{"fairmq-rate-logging", VariantType::Int, 0, {"Rate logging for FairMQ channels"}},
@@ -264,6 +264,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file"}},
      ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
      ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
+     ConfigParamSpec{"aod-read-ahead", VariantType::Int, 0, {"Number of dataframes to read ahead in the background (0: read on demand)"}},
      ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
      ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
      ConfigParamSpec{"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -896,6 +897,18 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-format")) {
+    auto format = options.get<std::string>("aod-writer-format");
+    if (!format.empty()) {
+      dod->setFileFormat(format);
+    }
+  }
+  if (options.isSet("aod-writer-compression")) {
+    auto compression = options.get<std::string>("aod-writer-compression");
+    if (!compression.empty()) {
+      dod->setFileCompression(compression);
+    }
+  }
   // parse the keepString
   if (options.isSet("aod-writer-keep")) {
     auto keepString = options.get<std::string>("aod-writer-keep");
@@ -1556,6 +1556,8 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           const auto uniformOptions = {
             "--aod-file",
             "--aod-memory-rate-limit",
+            "--aod-writer-compression",
+            "--aod-writer-format",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
             "--aod-writer-resfile",
@@ -12,6 +12,7 @@
 #include "Framework/TableBuilder.h"
 #include "Framework/AnalysisDataModel.h"
 #include <benchmark/benchmark.h>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -602,6 +603,45 @@ static void BM_ASoAHelpersCombGenCollisionsPairsSameCategories(benchmark::State&
 
 BENCHMARK(BM_ASoAHelpersCombGenCollisionsPairsSameCategories)->Range(8, 8 << maxPairsRange);
 
+static void BM_ASoAHelpersCombGenCollisionsPairsSameCategoriesParallel(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 10);
+
+  TableBuilder builder;
+  auto rowWriter = builder.cursor<o2::aod::Collisions>();
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist(e1),
+              uniform_dist_int(e1), uniform_dist(e1),
+              uniform_dist_int(e1),
+              uniform_dist(e1), uniform_dist(e1), uniform_dist_int(e1));
+  }
+  auto table = builder.finalize();
+
+  o2::aod::Collisions collisions{table};
+
+  const int nThreads = 4;
+  int64_t count = 0;
+
+  for (auto _ : state) {
+    std::vector<int64_t> counts(nThreads, 0);
+    parallelCombinations(CombinationsBlockUpperSameIndexPolicy("fNumContrib", 2, -1, collisions, collisions), nThreads, [&counts](size_t part, auto& comb) {
+      counts[part]++;
+    });
+    count = std::accumulate(counts.begin(), counts.end(), int64_t{0});
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenCollisionsPairsSameCategoriesParallel)->Range(8, 8 << maxPairsRange);
+
 static void BM_ASoAHelpersCombGenCollisionsFivesSameCategories(benchmark::State& state)
 {
   // Seed with a real random value, if available
@@ -10,6 +10,9 @@
 #include <benchmark/benchmark.h>
 #include "Headers/DataHeader.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataMatcherProgram.h"
+
+#include <vector>
 
 using namespace o2::header;
 using namespace o2::framework::data_matcher;
@@ -178,4 +181,127 @@ static void BM_OneVariableMatchUnmatch(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_OneVariableMatchUnmatch);
 
+static void BM_ProgramMatchedFullQuery(benchmark::State& state)
+{
+  DataHeader header;
+  header.dataOrigin = "TRD";
+  header.dataDescription = "TRACKLET";
+  header.subSpecification = 0;
+
+  DataDescriptorMatcher matcher{
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{"TRD"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"TRACKLET"},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        SubSpecificationTypeValueMatcher{0},
+        ConstantValueMatcher{true}))};
+  DataMatcherProgram program{matcher};
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    program.match(header, context);
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_ProgramMatchedFullQuery);
+
+static void BM_ProgramOneVariableMatchUnmatch(benchmark::State& state)
+{
+  DataHeader header0;
+  header0.dataOrigin = "TRD";
+  header0.dataDescription = "TRACKLET";
+  header0.subSpecification = 0;
+
+  DataHeader header1;
+  header1.dataOrigin = "TPC";
+  header1.dataDescription = "CLUSTERS";
+  header1.subSpecification = 0;
+
+  DataDescriptorMatcher matcher{
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{ContextRef{0}},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"TRACKLET"},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        SubSpecificationTypeValueMatcher{1},
+        ConstantValueMatcher{true}))};
+  DataMatcherProgram program{matcher};
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    program.match(header0, context);
+    program.match(header1, context);
+    context.discard();
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_ProgramOneVariableMatchUnmatch);
+
+// Check which of a batch of headers may match a wildcard query, one by one
+// with the original matcher and at once with mayMatch().
+static void BM_MatcherBatch(benchmark::State& state)
+{
+  std::vector<DataHeader> headers(DataMatcherProgram::MAX_BATCH_SIZE);
+  for (size_t i = 0; i < headers.size(); ++i) {
+    headers[i].dataOrigin = i % 2 ? "TPC" : "TRD";
+    headers[i].dataDescription = i % 3 ? "CLUSTERS" : "TRACKLET";
+    headers[i].subSpecification = i;
+  }
+
+  DataDescriptorMatcher matcher{
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{"TPC"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"CLUSTERS"},
+      SubSpecificationTypeValueMatcher{ContextRef{1}})};
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < headers.size(); ++i) {
+      result |= uint64_t{matcher.match(headers[i], context)} << i;
+      context.discard();
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_MatcherBatch);
+
+static void BM_ProgramBatchMayMatch(benchmark::State& state)
+{
+  std::vector<DataHeader> headers(DataMatcherProgram::MAX_BATCH_SIZE);
+  std::vector<DataHeader const*> pointers;
+  for (size_t i = 0; i < headers.size(); ++i) {
+    headers[i].dataOrigin = i % 2 ? "TPC" : "TRD";
+    headers[i].dataDescription = i % 3 ? "CLUSTERS" : "TRACKLET";
+    headers[i].subSpecification = i;
+    pointers.push_back(&headers[i]);
+  }
+
+  DataDescriptorMatcher matcher{
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{"TPC"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"CLUSTERS"},
+      SubSpecificationTypeValueMatcher{ContextRef{1}})};
+  DataMatcherProgram program{matcher};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(program.mayMatch(pointers.data(), pointers.size()));
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_ProgramBatchMayMatch);
+
 BENCHMARK_MAIN();
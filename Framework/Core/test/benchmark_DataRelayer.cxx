@@ -18,6 +18,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
 #include <cstring>
+#include <string>
 
 using Monitoring = o2::monitoring::Monitoring;
 using namespace o2::framework;
@@ -244,4 +245,56 @@ static void BM_RelayMultipleRoutes(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultipleRoutes);
 
+/// Many routes, one per link, as in the raw data proxies. Messages for all
+/// the links are relayed in turn and consumed as soon as they arrive.
+static void BM_RelayManyRoutes(benchmark::State& state)
+{
+  Monitoring metrics;
+  size_t nRoutes = state.range(0);
+
+  std::vector<InputRoute> inputs;
+  std::vector<InputSpec> specs;
+  specs.reserve(nRoutes);
+  for (size_t i = 0; i < nRoutes; ++i) {
+    specs.emplace_back("link" + std::to_string(i), "TPC", "RAWDATA", i);
+  }
+  for (size_t i = 0; i < nRoutes; ++i) {
+    inputs.emplace_back(InputRoute{specs[i], i, "Fake" + std::to_string(i), 0});
+  }
+
+  TimesliceIndex index;
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAny();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  DataHeader dh;
+  dh.dataDescription = "RAWDATA";
+  dh.dataOrigin = "TPC";
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = 0;
+
+  for (auto _ : state) {
+    dh.subSpecification = timeslice % nRoutes;
+    DataProcessingHeader dph{timeslice++, 1};
+    Stack stack{dh, dph};
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    FairMQMessagePtr payload = transport->CreateMessage(1000);
+
+    memcpy(header->GetData(), stack.data(), stack.size());
+
+    relayer.relay(std::move(header), std::move(payload));
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    assert(ready.size() == 1);
+    assert(ready[0].op == CompletionPolicy::CompletionOp::Consume);
+    auto result = relayer.getInputsForTimeslice(ready[0].slot);
+    assert(result.size() == nRoutes);
+    assert(result.at(dh.subSpecification).size() == 1);
+  }
+}
+
+BENCHMARK(BM_RelayManyRoutes)->Arg(1)->Arg(16)->Arg(128)->Arg(512);
+
 BENCHMARK_MAIN();
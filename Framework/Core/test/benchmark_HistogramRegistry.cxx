@@ -61,6 +61,20 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a 2D histogram either directly or via the per-thread bin buffers of the registry
+static void BM_RegistryFill(benchmark::State& state)
+{
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}}}};
+  registry.setBufferedFill(state.range(0));
+  for (auto _ : state) {
+    for (auto i = 0; i < nLookups; ++i) {
+      registry.fill(HIST("xy"), (i % 997) / 997., (i % 991) / 991.);
+    }
+  }
+  registry.flush();
+}
+
+BENCHMARK(BM_RegistryFill)->Arg(0)->Arg(1);
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 
@@ -358,6 +358,14 @@ BOOST_AUTO_TEST_CASE(TestConcatTables)
   FilteredTest filtered{{testA.asArrowTable()}, selection_f};
   BOOST_CHECK_EQUAL(2, filtered.size());
 
+  // identical filters on the same table share the cached selection
+  expressions::SelectionCache cache;
+  FilteredTest cached1{{testA.asArrowTable()}, node_or, cache};
+  FilteredTest cached2{{testA.asArrowTable()}, node_or, cache};
+  BOOST_CHECK(cached1.getSelectedRows() == filtered.getSelectedRows());
+  BOOST_CHECK(cached2.getSelectedRows() == filtered.getSelectedRows());
+  BOOST_CHECK_EQUAL(cache.evaluations(), 1);
+
   auto i = 0;
   BOOST_CHECK(filtered.begin() != filtered.end());
   for (auto& f : filtered) {
@@ -420,6 +428,105 @@ BOOST_AUTO_TEST_CASE(TestConcatTables)
   BOOST_CHECK_EQUAL(i, 3);
 }
 
+BOOST_AUTO_TEST_CASE(TestSelectionCache)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  for (auto i = 0; i < 1000; ++i) {
+    rowWriter(0, i, i % 10);
+  }
+  auto table = builder.finalize();
+
+  auto selectedRows = [&table](expressions::Filter const& filter) {
+    auto selection = expressions::createSelection(table, filter);
+    std::vector<int64_t> rows;
+    for (auto i = 0; i < selection->GetNumSlots(); ++i) {
+      rows.push_back(selection->GetIndex(i));
+    }
+    return rows;
+  };
+  auto makeTree = [&table](expressions::Filter const& filter) {
+    return expressions::createExpressionTree(expressions::createOperations(filter), table->schema());
+  };
+  auto indices = [](expressions::CompactSelection const& selection) {
+    std::vector<int64_t> rows;
+    selection.forEach([&rows](int64_t row) { rows.push_back(row); });
+    return rows;
+  };
+
+  // 500 rows are stored as a bitmap, 10 rows as indices
+  expressions::Filter dense = test::y < 5;
+  expressions::Filter sparse = test::x < 10;
+  expressions::Filter none = test::x < 0;
+  expressions::Filter all = test::x >= 0;
+  auto expectedDense = selectedRows(dense);
+  auto expectedSparse = selectedRows(sparse);
+  BOOST_REQUIRE_EQUAL(expectedDense.size(), 500);
+  BOOST_REQUIRE_EQUAL(expectedSparse.size(), 10);
+
+  expressions::CompactSelection denseSelection{expressions::createSelection(table, dense), table->num_rows()};
+  BOOST_CHECK(denseSelection.isBitmap());
+  BOOST_CHECK_EQUAL(denseSelection.size(), 500);
+  BOOST_CHECK(indices(denseSelection) == expectedDense);
+  expressions::CompactSelection sparseSelection{expressions::createSelection(table, sparse), table->num_rows()};
+  BOOST_CHECK(!sparseSelection.isBitmap());
+  BOOST_CHECK_EQUAL(sparseSelection.size(), 10);
+  BOOST_CHECK(indices(sparseSelection) == expectedSparse);
+  expressions::CompactSelection noneSelection{expressions::createSelection(table, none), table->num_rows()};
+  BOOST_CHECK_EQUAL(noneSelection.size(), 0);
+  BOOST_CHECK(indices(noneSelection).empty());
+  // the last bitmap word is only partially used
+  expressions::CompactSelection allSelection{expressions::createSelection(table, all), table->num_rows()};
+  BOOST_CHECK(allSelection.isBitmap());
+  BOOST_CHECK(indices(allSelection) == selectedRows(all));
+
+  // each filter is evaluated once per table, also when its tree is built again
+  expressions::SelectionCache cache;
+  auto denseTree = makeTree(dense);
+  auto sparseTree = makeTree(sparse);
+  BOOST_CHECK(indices(cache.select(Points::hashes(), denseTree, table)) == expectedDense);
+  BOOST_CHECK_EQUAL(cache.evaluations(), 1);
+  BOOST_CHECK(indices(cache.select(Points::hashes(), makeTree(test::y < 5), table)) == expectedDense);
+  BOOST_CHECK_EQUAL(cache.evaluations(), 1);
+  BOOST_CHECK(indices(cache.select(Points::hashes(), sparseTree, table)) == expectedSparse);
+  BOOST_CHECK(indices(cache.select(Points::hashes(), sparseTree, table)) == expectedSparse);
+  BOOST_CHECK_EQUAL(cache.evaluations(), 2);
+  BOOST_CHECK(indices(cache.select(std::set<size_t>{0}, denseTree, table)) == expectedDense);
+  BOOST_CHECK_EQUAL(cache.evaluations(), 3);
+
+  // the cached selection is shared by the tables built on the same data, e.g. by different tasks
+  Filtered<Points> filteredDense{{table}, denseTree, cache};
+  Filtered<Points> filteredSparse{{table}, sparseTree, cache};
+  Points points{table};
+  Filtered<Points> filteredPoints{{points.asArrowTable()}, denseTree, cache};
+  BOOST_CHECK_EQUAL(cache.evaluations(), 3);
+  BOOST_CHECK_EQUAL(filteredDense.size(), 500);
+  BOOST_CHECK(filteredPoints.getSelectedRows() == expectedDense);
+  BOOST_REQUIRE_EQUAL(filteredSparse.size(), 10);
+  auto i = 0;
+  for (auto& p : filteredSparse) {
+    BOOST_CHECK_EQUAL(p.x(), i);
+    BOOST_CHECK_EQUAL(p.index(), i);
+    i++;
+  }
+
+  // the same filter on another dataframe is evaluated again
+  TableBuilder otherBuilder;
+  auto otherWriter = otherBuilder.persist<int32_t, int32_t>({"x", "y"});
+  for (auto j = 0; j < 1000; ++j) {
+    otherWriter(0, j, 9 - j % 10);
+  }
+  auto other = otherBuilder.finalize();
+  Filtered<Points> filteredOther{{other}, denseTree, cache};
+  BOOST_CHECK_EQUAL(cache.evaluations(), 4);
+  BOOST_REQUIRE_EQUAL(filteredOther.size(), 500);
+  BOOST_CHECK_EQUAL(filteredOther.begin().index(), 5);
+
+  cache.clear();
+  cache.select(Points::hashes(), denseTree, table);
+  BOOST_CHECK_EQUAL(cache.evaluations(), 5);
+}
+
 BOOST_AUTO_TEST_CASE(TestDereference)
 {
   TableBuilder builderA;
@@ -1227,6 +1227,53 @@ BOOST_AUTO_TEST_CASE(BlockCombinations)
     count++;
   }
   BOOST_CHECK_EQUAL(count, 0);
+
+  // Reusing the grouping of the category column for several policies
+  auto groupedAux = groupTable(testAux, "y", 1, -1);
+  count = 0;
+  for (auto& [c0, c1] : combinations(CombinationsBlockStrictlyUpperSameIndexPolicy(groupedAux, 2, testAux, testAux))) {
+    BOOST_CHECK_EQUAL(c0.x(), std::get<0>(expectedStrictlyUpperPairs[count]));
+    BOOST_CHECK_EQUAL(c1.x(), std::get<1>(expectedStrictlyUpperPairs[count]));
+    count++;
+  }
+  BOOST_CHECK_EQUAL(count, expectedStrictlyUpperPairs.size());
+
+  count = 0;
+  for (auto& [c0, c1, c2] : combinations(CombinationsBlockFullSameIndexPolicy(groupedAux, 2, testAux, testAux, testAux))) {
+    BOOST_CHECK_EQUAL(c0.x(), std::get<0>(expectedFullTriples[count]));
+    BOOST_CHECK_EQUAL(c1.x(), std::get<1>(expectedFullTriples[count]));
+    BOOST_CHECK_EQUAL(c2.x(), std::get<2>(expectedFullTriples[count]));
+    count++;
+  }
+  BOOST_CHECK_EQUAL(count, expectedFullTriples.size());
+
+  // Partitions of the categories yield the same combinations in the same order
+  auto fullParts = partitionCombinations(CombinationsBlockFullSameIndexPolicy("y", 2, -1, testAux, testAux), 3);
+  BOOST_CHECK_EQUAL(fullParts.size(), 3);
+  count = 0;
+  for (auto& part : fullParts) {
+    for (auto& [c0, c1] : part) {
+      BOOST_CHECK_EQUAL(c0.x(), std::get<0>(expectedFullPairs[count]));
+      BOOST_CHECK_EQUAL(c1.x(), std::get<1>(expectedFullPairs[count]));
+      count++;
+    }
+  }
+  BOOST_CHECK_EQUAL(count, expectedFullPairs.size());
+
+  BOOST_CHECK_EQUAL(partitionCombinations(CombinationsBlockStrictlyUpperSameIndexPolicy("y", 2, -1, testAux, testAux, testAux), 16).size(), 2);
+
+  // Processing the parts on several threads, with one output per part
+  int nThreads = 4;
+  std::vector<std::vector<std::tuple<int32_t, int32_t>>> upperPairsPerPart(nThreads);
+  parallelCombinations(CombinationsBlockUpperSameIndexPolicy("y", 2, -1, testAux, testAux), nThreads, [&](size_t part, auto& comb) {
+    auto& [c0, c1] = comb;
+    upperPairsPerPart[part].emplace_back(c0.x(), c1.x());
+  });
+  std::vector<std::tuple<int32_t, int32_t>> upperPairs;
+  for (auto& pairs : upperPairsPerPart) {
+    upperPairs.insert(upperPairs.end(), pairs.begin(), pairs.end());
+  }
+  BOOST_CHECK(upperPairs == expectedUpperPairs);
 }
 
 BOOST_AUTO_TEST_CASE(CombinationsHelpers)
@@ -13,6 +13,7 @@
 #define BOOST_TEST_DYN_LINK
 
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataMatcherProgram.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/InputSpec.h"
 
@@ -432,6 +433,109 @@ BOOST_AUTO_TEST_CASE(TestAtomicUpdatesOfContext)
   BOOST_CHECK(vPtr1 != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(TestMatcherProgram)
+{
+  DataHeader header0;
+  header0.dataOrigin = "TPC";
+  header0.dataDescription = "CLUSTERS";
+  header0.subSpecification = 1;
+
+  DataHeader header1;
+  header1.dataOrigin = "ITS";
+  header1.dataDescription = "TRACKLET";
+  header1.subSpecification = 2;
+
+  DataHeader header2;
+  header2.dataOrigin = "TPC";
+  header2.dataDescription = "CLUSTERSNATIVE";
+  header2.subSpecification = 1;
+
+  DataHeader header3;
+  header3.dataOrigin = "TP";
+  header3.dataDescription = "CLUSTERS";
+  header3.subSpecification = 3;
+
+  std::vector<DataHeader const*> headers{&header0, &header1, &header2, &header3};
+
+  std::vector<DataDescriptorMatcher> matchers;
+  matchers.emplace_back(
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{"TPC"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::And,
+      DescriptionValueMatcher{"CLUSTERS"},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::Just,
+        SubSpecificationTypeValueMatcher{1})));
+  matchers.emplace_back(
+    DataDescriptorMatcher::Op::Or,
+    OriginValueMatcher{"ITS"},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::Xor,
+      DescriptionValueMatcher{"CLUSTERS"},
+      SubSpecificationTypeValueMatcher{3}));
+  matchers.emplace_back(
+    DataDescriptorMatcher::Op::And,
+    OriginValueMatcher{ContextRef{1}},
+    std::make_unique<DataDescriptorMatcher>(
+      DataDescriptorMatcher::Op::Just,
+      SubSpecificationTypeValueMatcher{1}));
+  matchers.emplace_back(
+    DataDescriptorMatcher::Op::Xor,
+    ConstantValueMatcher{true},
+    DescriptionValueMatcher{"CLUSTERSNATIVE"});
+
+  // Results of match() and bits of mayMatch() for each matcher
+  std::vector<std::vector<bool>> expected{
+    {true, false, false, false},
+    {true, true, false, false},
+    {true, false, true, false},
+    {true, true, false, true}};
+  std::vector<uint64_t> expectedMasks{0b0001, 0b0011, 0b0101, 0b1011};
+
+  for (size_t mi = 0; mi < matchers.size(); ++mi) {
+    DataMatcherProgram program{matchers[mi]};
+    for (size_t hi = 0; hi < headers.size(); ++hi) {
+      VariableContext context;
+      VariableContext programContext;
+      BOOST_CHECK_EQUAL(matchers[mi].match(*headers[hi], context), expected[mi][hi]);
+      BOOST_CHECK_EQUAL(program.match(*headers[hi], programContext), expected[mi][hi]);
+      BOOST_CHECK_EQUAL(program.mayMatch(*headers[hi]), expected[mi][hi]);
+    }
+    BOOST_CHECK_EQUAL(program.mayMatch(headers.data(), headers.size()), expectedMasks[mi]);
+  }
+
+  // The variables are bound as with the original matcher, and the
+  // mayMatch() does not depend on them.
+  DataMatcherProgram program{matchers[2]};
+  VariableContext context;
+  BOOST_REQUIRE(program.match(header0, context));
+  context.commit();
+  auto vPtr = std::get_if<std::string>(&context.get(1));
+  BOOST_REQUIRE(vPtr != nullptr);
+  BOOST_CHECK_EQUAL(*vPtr, "TPC");
+  BOOST_CHECK(program.match(header3, context) == false);
+  context.discard();
+  BOOST_CHECK(program.mayMatch(header3) == false);
+  header3.subSpecification = 1;
+  BOOST_CHECK(program.mayMatch(header3) == true);
+
+  // The start time is taken from the DataProcessingHeader.
+  DataDescriptorMatcher startTimeMatcher{
+    DataDescriptorMatcher::Op::And,
+    StartTimeValueMatcher{ContextRef{0}},
+    OriginValueMatcher{"TPC"}};
+  DataMatcherProgram startTimeProgram{startTimeMatcher};
+  Stack s{header0, DataProcessingHeader{123, 1}};
+  VariableContext startTimeContext;
+  BOOST_REQUIRE(startTimeProgram.match(reinterpret_cast<char const*>(s.data()), startTimeContext));
+  startTimeContext.commit();
+  auto tPtr = std::get_if<uint64_t>(&startTimeContext.get(0));
+  BOOST_REQUIRE(tPtr != nullptr);
+  BOOST_CHECK_EQUAL(*tPtr, 123);
+  BOOST_CHECK_EQUAL(startTimeProgram.mayMatch(headers.data(), headers.size()), 0b0101);
+}
+
 BOOST_AUTO_TEST_CASE(TestVariableContext)
 {
   VariableContext context;
@@ -14,6 +14,10 @@
 #include <boost/test/unit_test.hpp>
 #include "Headers/DataHeader.h"
 #include "Framework/DataOutputDirector.h"
+#include "Framework/DataInputDirector.h"
+#include <arrow/builder.h>
+#include <arrow/table.h>
+#include <filesystem>
 #include <fstream>
 
 BOOST_AUTO_TEST_CASE(TestDataOutputDirector)
@@ -124,3 +128,148 @@ BOOST_AUTO_TEST_CASE(TestDataOutputDirector)
   BOOST_CHECK_EQUAL(ds[1]->treename, std::string("due"));
   BOOST_CHECK_EQUAL(ds[1]->colnames.size(), 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestDataOutputDirectorArrowFormat)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  auto dh = DataHeader(DataDescription{"UNO"},
+                       DataOrigin{"AOD"},
+                       DataHeader::SubSpecificationType{0});
+
+  // a table with three columns
+  arrow::Int32Builder b1;
+  arrow::FloatBuilder b2;
+  arrow::FloatBuilder b3;
+  for (int i = 0; i < 10; ++i) {
+    BOOST_REQUIRE(b1.Append(i).ok());
+    BOOST_REQUIRE(b2.Append(0.5f * i).ok());
+    BOOST_REQUIRE(b3.Append(-1.f * i).ok());
+  }
+  std::shared_ptr<arrow::Array> a1, a2, a3;
+  BOOST_REQUIRE(b1.Finish(&a1).ok());
+  BOOST_REQUIRE(b2.Finish(&a2).ok());
+  BOOST_REQUIRE(b3.Finish(&a3).ok());
+  auto schema = arrow::schema({arrow::field("c1", arrow::int32()), arrow::field("c2", arrow::float32()), arrow::field("c3", arrow::float32())});
+  auto table = arrow::Table::Make(schema, {a1, a2, a3});
+
+  std::filesystem::remove_all("arrowresults.arrow");
+  DataOutputDirector dod;
+  dod.readString("AOD/UNO/0::c1/c3");
+  dod.setFilenameBase("arrowresults");
+  dod.setFileFormat("arrow");
+  BOOST_CHECK(dod.isArrowFormat());
+
+  // two time frames merged into DF_0 and one in DF_2
+  auto ds = dod.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  dod.writeArrowTable(ds[0], 0, table);
+  dod.writeArrowTable(ds[0], 0, table);
+  dod.writeArrowTable(ds[0], 2, table);
+  dod.closeDataFiles();
+
+  BOOST_CHECK(std::filesystem::exists("arrowresults.arrow/DF_0/O2uno.arrow"));
+  BOOST_CHECK(std::filesystem::exists("arrowresults.arrow/DF_2/O2uno.arrow"));
+
+  // read the tables back
+  DataInputDirector didir("arrowresults.arrow");
+  BOOST_CHECK(didir.isArrowFile(dh, 0));
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 1), 2);
+
+  auto table0 = didir.getArrowTable(dh, 0, 0);
+  BOOST_REQUIRE(table0 != nullptr);
+  BOOST_CHECK(table0->Validate().ok());
+  BOOST_CHECK_EQUAL(table0->num_rows(), 20);
+  BOOST_REQUIRE_EQUAL(table0->num_columns(), 2);
+  BOOST_CHECK_EQUAL(table0->schema()->field(0)->name(), "c1");
+  BOOST_CHECK_EQUAL(table0->schema()->field(1)->name(), "c3");
+  auto c3 = std::static_pointer_cast<arrow::FloatArray>(table0->column(1)->chunk(1));
+  BOOST_CHECK_EQUAL(c3->Value(4), -4.f);
+
+  auto table1 = didir.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table1 != nullptr);
+  BOOST_CHECK_EQUAL(table1->num_rows(), 10);
+
+  // no time frame left
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 2) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestDataOutputDirectorArrowFormatOutOfOrder)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  auto dh = DataHeader(DataDescription{"UNO"},
+                       DataOrigin{"AOD"},
+                       DataHeader::SubSpecificationType{0});
+
+  // a table with one column holding the time frame number
+  auto makeTable = [](int tf) {
+    arrow::Int32Builder builder;
+    for (int i = 0; i < 5; ++i) {
+      BOOST_REQUIRE(builder.Append(100 * tf + i).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    BOOST_REQUIRE(builder.Finish(&array).ok());
+    return arrow::Table::Make(arrow::schema({arrow::field("c1", arrow::int32())}), {array});
+  };
+
+  std::filesystem::remove_all("arrowunordered.arrow");
+  DataOutputDirector dod;
+  dod.readString("AOD/UNO/0");
+  dod.setFilenameBase("arrowunordered");
+  dod.setFileFormat("arrow");
+
+  // time frames 0 and 1 go to DF_0, 4 to DF_2, and come back to DF_0
+  auto ds = dod.getDataOutputDescriptors(dh);
+  BOOST_REQUIRE_EQUAL(ds.size(), 1);
+  dod.writeArrowTable(ds[0], 0, makeTable(0));
+  dod.writeArrowTable(ds[0], 2, makeTable(4));
+
+  // DF_0 is closed by the first table of DF_2 and can already be read
+  {
+    DataInputDirector didir("arrowunordered.arrow");
+    BOOST_REQUIRE(didir.isArrowFile(dh, 0));
+    auto table = didir.getArrowTable(dh, 0, 0);
+    BOOST_REQUIRE(table != nullptr);
+    BOOST_CHECK_EQUAL(table->num_rows(), 5);
+  }
+
+  // the late time frame of DF_0 goes to a second part
+  dod.writeArrowTable(ds[0], 0, makeTable(1));
+  dod.writeArrowTable(ds[0], 2, makeTable(5));
+  dod.closeDataFiles();
+  BOOST_CHECK(std::filesystem::exists("arrowunordered.arrow/DF_0/O2uno.1.arrow"));
+  BOOST_CHECK(!std::filesystem::exists("arrowunordered.arrow/DF_2/O2uno.1.arrow"));
+
+  DataInputDirector didir("arrowunordered.arrow");
+  BOOST_REQUIRE(didir.isArrowFile(dh, 0));
+
+  auto checkTable = [](std::shared_ptr<arrow::Table> const& table, std::vector<int> const& tfs) {
+    BOOST_REQUIRE(table != nullptr);
+    BOOST_CHECK(table->Validate().ok());
+    BOOST_REQUIRE_EQUAL(table->num_rows(), 5 * tfs.size());
+    BOOST_REQUIRE_EQUAL(table->column(0)->num_chunks(), tfs.size());
+    for (size_t iChunk = 0; iChunk < tfs.size(); ++iChunk) {
+      auto values = std::static_pointer_cast<arrow::Int32Array>(table->column(0)->chunk(iChunk));
+      for (int i = 0; i < 5; ++i) {
+        BOOST_CHECK_EQUAL(values->Value(i), 100 * tfs[iChunk] + i);
+      }
+    }
+  };
+  size_t fileSize = 0;
+  checkTable(didir.getArrowTable(dh, 0, 0, &fileSize), {0, 1});
+  BOOST_CHECK_EQUAL(fileSize, std::filesystem::file_size("arrowunordered.arrow/DF_0/O2uno.arrow") +
+                                std::filesystem::file_size("arrowunordered.arrow/DF_0/O2uno.1.arrow"));
+  checkTable(didir.getArrowTable(dh, 0, 1), {4, 5});
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 2) == nullptr);
+
+  // a new output with the same name does not pick up the parts of the old one
+  dod.setFilenameBase("arrowunordered");
+  dod.writeArrowTable(ds[0], 0, makeTable(7));
+  dod.closeDataFiles();
+  BOOST_CHECK(!std::filesystem::exists("arrowunordered.arrow/DF_0/O2uno.1.arrow"));
+  DataInputDirector rewritten("arrowunordered.arrow");
+  checkTable(rewritten.getArrowTable(dh, 0, 0), {7});
+}
@@ -447,3 +447,60 @@ BOOST_AUTO_TEST_CASE(TestClear)
   relayer.getReadyToProcess(ready);
   BOOST_REQUIRE_EQUAL(ready.size(), 0);
 }
+
+/// Test that the routes are still selected in order when some of them
+/// are looked up by (origin, description, subSpec) and some are wildcards.
+BOOST_AUTO_TEST_CASE(TestRoutePrecedence)
+{
+  Monitoring metrics;
+  InputSpec spec0{"tpc", "TPC", "CLUSTERS", 1};
+  auto specs = o2::framework::select("all:TPC/CLUSTERS");
+  InputSpec spec2{"clusters", "TPC", "CLUSTERS", 0};
+
+  std::vector<InputRoute> inputs = {
+    InputRoute{spec0, 0, "Fake0", 0},
+    InputRoute{specs[0], 1, "Fake1", 0},
+    InputRoute{spec2, 2, "Fake2", 0},
+  };
+
+  auto distinct = DataRelayerHelpers::createDistinctRouteIndex(inputs);
+  auto concrete = DataRelayerHelpers::createConcreteRouteIndex(inputs, distinct);
+  auto wildcards = DataRelayerHelpers::createWildcardRouteIndex(inputs, distinct);
+  BOOST_CHECK_EQUAL(concrete.size(), 2);
+  BOOST_REQUIRE_EQUAL(wildcards.size(), 1);
+  BOOST_CHECK_EQUAL(wildcards[0], 1);
+
+  TimesliceIndex index;
+  auto policy = CompletionPolicyHelpers::consumeWhenAny();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto relayAndGetInput = [&transport, &relayer](uint32_t subSpec, size_t timeslice) -> int {
+    DataHeader dh;
+    dh.dataDescription = "CLUSTERS";
+    dh.dataOrigin = "TPC";
+    dh.subSpecification = subSpec;
+    Stack stack{dh, DataProcessingHeader{timeslice, 1}};
+    FairMQMessagePtr header = transport->CreateMessage(stack.size());
+    FairMQMessagePtr payload = transport->CreateMessage(1000);
+    memcpy(header->GetData(), stack.data(), stack.size());
+    relayer.relay(std::move(header), std::move(payload));
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1);
+    auto result = relayer.getInputsForTimeslice(ready[0].slot);
+    for (size_t ii = 0; ii < result.size(); ++ii) {
+      if (result[ii].size()) {
+        return ii;
+      }
+    }
+    return -1;
+  };
+  // The concrete route comes before the wildcard one
+  BOOST_CHECK_EQUAL(relayAndGetInput(1, 0), 0);
+  // The wildcard route comes before the concrete one
+  BOOST_CHECK_EQUAL(relayAndGetInput(0, 1), 1);
+  // Only the wildcard route matches
+  BOOST_CHECK_EQUAL(relayAndGetInput(2, 2), 1);
+}
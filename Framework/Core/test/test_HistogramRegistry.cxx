@@ -14,6 +14,8 @@
 #include "Framework/HistogramRegistry.h"
 #include <boost/test/unit_test.hpp>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -128,3 +130,142 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 
   registry.print();
 }
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBufferedFill)
+{
+  HistogramRegistry direct{"direct"};
+  HistogramRegistry buffered{"buffered"};
+  for (auto registry : {&direct, &buffered}) {
+    registry->add("x", "x", kTH1F, {{20, 0.0f, 10.0f}});
+    registry->add("xy", "xy", kTH2D, {{20, 0.0f, 10.0f}, {20, -10.0f, 0.0f}});
+    registry->add("xyz", "xyz", kTHnD, {{20, 0.0f, 10.0f}, {20, -10.0f, 0.0f}, {5, 0.0f, 5.0f}});
+  }
+  buffered.setBufferedFill(true);
+  BOOST_CHECK(buffered.isBufferedFill());
+
+  for (auto registry : {&direct, &buffered}) {
+    for (int i = 0; i < 100; ++i) {
+      float x = 0.13f * i - 1.0f;
+      float y = -0.07f * i;
+      registry->fill(HIST("x"), x);
+      registry->fill(HIST("xy"), x, y, 0.5 + i % 3);
+      registry->fill(HIST("xyz"), x, y, i % 7);
+    }
+  }
+  // nothing is merged into the histograms before the flush
+  BOOST_CHECK_EQUAL(buffered.get<TH1>(HIST("x"))->GetEntries(), 0);
+  buffered.flush();
+
+  auto& x1 = direct.get<TH1>(HIST("x"));
+  auto& x2 = buffered.get<TH1>(HIST("x"));
+  BOOST_CHECK_EQUAL(x1->GetEntries(), x2->GetEntries());
+  for (int bin = 0; bin < x1->GetNcells(); ++bin) {
+    BOOST_CHECK_EQUAL(x1->GetBinContent(bin), x2->GetBinContent(bin));
+  }
+  auto& xy1 = direct.get<TH2>(HIST("xy"));
+  auto& xy2 = buffered.get<TH2>(HIST("xy"));
+  BOOST_CHECK_EQUAL(xy1->GetEntries(), xy2->GetEntries());
+  BOOST_REQUIRE_EQUAL(xy1->GetSumw2N(), xy2->GetSumw2N());
+  for (int bin = 0; bin < xy1->GetNcells(); ++bin) {
+    BOOST_CHECK_CLOSE(xy1->GetBinContent(bin), xy2->GetBinContent(bin), 1e-9);
+    BOOST_CHECK_CLOSE(xy1->GetBinError(bin), xy2->GetBinError(bin), 1e-9);
+  }
+  auto& xyz1 = direct.get<THn>(HIST("xyz"));
+  auto& xyz2 = buffered.get<THn>(HIST("xyz"));
+  BOOST_CHECK_EQUAL(xyz1->GetEntries(), xyz2->GetEntries());
+  for (Long64_t bin = 0; bin < xyz1->GetNbins(); ++bin) {
+    BOOST_CHECK_EQUAL(xyz1->GetBinContent(bin), xyz2->GetBinContent(bin));
+  }
+
+  // a second flush must not add the same fills again
+  buffered.flush();
+  BOOST_CHECK_EQUAL(x1->GetEntries(), x2->GetEntries());
+}
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBufferedFillThreads)
+{
+  // more threads than filled any registry at once, each of them filling two buffered registries
+  constexpr int nThreads = 100;
+  constexpr int nFills = 50;
+  HistogramRegistry direct{"direct"};
+  HistogramRegistry bufferedA{"bufferedA"};
+  HistogramRegistry bufferedB{"bufferedB"};
+  for (auto registry : {&direct, &bufferedA, &bufferedB}) {
+    registry->add("x", "x", kTH1F, {{20, 0.0f, 10.0f}});
+    registry->add("xy", "xy", kTH2D, {{20, 0.0f, 10.0f}, {20, -10.0f, 0.0f}});
+  }
+  bufferedA.setBufferedFill(true);
+  bufferedB.setBufferedFill(true);
+
+  auto fillRegistry = [](HistogramRegistry& registry, int iThread) {
+    for (int i = 0; i < nFills; ++i) {
+      float x = 0.011f * (iThread * nFills + i) - 1.0f;
+      float y = -0.003f * (iThread * nFills + i);
+      registry.fill(HIST("x"), x);
+      registry.fill(HIST("xy"), x, y, 0.5 + i % 3);
+    }
+  };
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    fillRegistry(direct, iThread);
+  }
+  std::vector<std::thread> threads;
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    threads.emplace_back([&, iThread]() {
+      fillRegistry(bufferedA, iThread);
+      fillRegistry(bufferedB, iThread);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto buffered : {&bufferedA, &bufferedB}) {
+    buffered->flush();
+    auto& x1 = direct.get<TH1>(HIST("x"));
+    auto& x2 = buffered->get<TH1>(HIST("x"));
+    BOOST_CHECK_EQUAL(x1->GetEntries(), x2->GetEntries());
+    for (int bin = 0; bin < x1->GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(x1->GetBinContent(bin), x2->GetBinContent(bin));
+    }
+    auto& xy1 = direct.get<TH2>(HIST("xy"));
+    auto& xy2 = buffered->get<TH2>(HIST("xy"));
+    BOOST_CHECK_EQUAL(xy1->GetEntries(), xy2->GetEntries());
+    for (int bin = 0; bin < xy1->GetNcells(); ++bin) {
+      BOOST_CHECK_CLOSE(xy1->GetBinContent(bin), xy2->GetBinContent(bin), 1e-9);
+      BOOST_CHECK_CLOSE(xy1->GetBinError(bin), xy2->GetBinError(bin), 1e-9);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HistogramRegistryBufferedFillShortLived)
+{
+  // a thread filling many short-lived registries keeps only the shards of the live ones
+  HistogramRegistry longLived{"longLived"};
+  longLived.add("x", "x", kTH1F, {{20, 0.0f, 10.0f}});
+  longLived.setBufferedFill(true);
+  longLived.fill(HIST("x"), 1.0f);
+  const auto nShards = HistogramRegistry::getNThreadFillShards();
+
+  for (int iRegistry = 0; iRegistry < 1000; ++iRegistry) {
+    HistogramRegistry shortLived{"shortLived"};
+    shortLived.add("x", "x", kTH1F, {{20, 0.0f, 10.0f}});
+    shortLived.setBufferedFill(true);
+    for (int i = 0; i <= iRegistry % 5; ++i) {
+      shortLived.fill(HIST("x"), 2.0f);
+    }
+    shortLived.flush();
+    // the new registry must not get the shard of a destroyed one, even if it reuses its memory
+    BOOST_CHECK_EQUAL(shortLived.get<TH1>(HIST("x"))->GetEntries(), iRegistry % 5 + 1);
+    BOOST_CHECK_LE(HistogramRegistry::getNThreadFillShards(), nShards + 2);
+  }
+  longLived.fill(HIST("x"), 1.0f);
+  BOOST_CHECK_LE(HistogramRegistry::getNThreadFillShards(), nShards + 1);
+  longLived.flush();
+  BOOST_CHECK_EQUAL(longLived.get<TH1>(HIST("x"))->GetEntries(), 2);
+
+  // a registry which stops buffering releases its shards as well
+  longLived.setBufferedFill(false);
+  longLived.setBufferedFill(true);
+  longLived.fill(HIST("x"), 1.0f);
+  BOOST_CHECK_EQUAL(HistogramRegistry::getNThreadFillShards(), nShards);
+}
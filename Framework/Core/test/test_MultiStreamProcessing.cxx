@@ -0,0 +1,92 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/CommonServices.h"
+#include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
+#include "Framework/EndOfStreamContext.h"
+#include "Framework/runDataProcessing.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define ASSERT_ERROR(condition)                                   \
+  if ((condition) == false) {                                     \
+    LOG(FATAL) << R"(Test condition ")" #condition R"(" failed)"; \
+  }
+
+using namespace o2::framework;
+
+constexpr int nTimeslices = 100;
+constexpr int nStreams = 4;
+
+// The processor runs nStreams timeslices at the same time, the later
+// a timeslice is dispatched within a group the sooner it is done. The
+// consumer checks that the outputs, which are merged from the message
+// contexts of the streams, and the forwarded inputs arrive in order anyway.
+WorkflowSpec defineDataProcessing(ConfigContext const& specs)
+{
+  DataProcessorSpec processor{
+    "B",
+    {InputSpec{"a", "TST", "A"}},
+    {OutputSpec{{"b1"}, "TST", "B1"},
+     OutputSpec{{"b2"}, "TST", "B2"}},
+    AlgorithmSpec{
+      [](ProcessingContext& ctx) {
+        auto count = ctx.inputs().get<int>("a");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5 * (nStreams - 1 - count % nStreams)));
+        ctx.outputs().make<int>(OutputRef{"b1"}) = count;
+        auto& b2 = ctx.outputs().make<int>(OutputRef{"b2"}, 3);
+        for (int i = 0; i < 3; ++i) {
+          b2[i] = count + i;
+        }
+      }}};
+  processor.requiredServices = CommonServices::defaultServices(nStreams);
+
+  return WorkflowSpec{
+    {"A",
+     Inputs{},
+     {OutputSpec{{"a"}, "TST", "A"}},
+     AlgorithmSpec{
+       [](ProcessingContext& ctx) {
+         static int count = 0;
+         ctx.outputs().make<int>(OutputRef{"a"}) = count++;
+         if (count == nTimeslices) {
+           ctx.services().get<ControlService>().endOfStream();
+           ctx.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+         }
+       }}},
+    processor,
+    {"C",
+     Inputs{
+       InputSpec{"a", "TST", "A"},
+       InputSpec{"b1", "TST", "B1"},
+       InputSpec{"b2", "TST", "B2"}},
+     Outputs{},
+     AlgorithmSpec{
+       adaptStateful([](CallbackService& callbacks) {
+         static int expected = 0;
+         callbacks.set(CallbackService::Id::EndOfStream, [](EndOfStreamContext& context) {
+           ASSERT_ERROR(expected == nTimeslices);
+           context.services().get<ControlService>().readyToQuit(QuitRequest::All);
+         });
+         return adaptStateless([](InputRecord& inputs) {
+           ASSERT_ERROR(inputs.get<int>("a") == expected);
+           ASSERT_ERROR(inputs.get<int>("b1") == expected);
+           auto b2 = inputs.get<gsl::span<int>>("b2");
+           ASSERT_ERROR(b2.size() == 3);
+           for (int i = 0; i < 3; ++i) {
+             ASSERT_ERROR(b2[i] == expected + i);
+           }
+           expected++;
+         });
+       })}}};
+}
@@ -161,6 +161,36 @@ BOOST_AUTO_TEST_CASE(TestStreamServices)
   BOOST_CHECK_EQUAL(tt2->threadId, 2);
 }
 
+struct UnknownService {
+};
+
+BOOST_AUTO_TEST_CASE(TestOverrideServices)
+{
+  using namespace o2::framework;
+  ServiceRegistry registry;
+
+  DummyService t0{0};
+  DummyService t1{1};
+  registry.registerService(TypeIdHelpers::uniqueId<DummyService>(), &t0, ServiceKind::Serial, 0);
+  /// Thread 2 gets its own slot, pointing to the same instance
+  registry.get(TypeIdHelpers::uniqueId<DummyService>(), 2, ServiceKind::Serial);
+
+  /// Only the copy sees the new instance, on all the threads
+  ServiceRegistry copy{registry};
+  copy.overrideService(&t1);
+  auto tt0 = reinterpret_cast<DummyService*>(registry.get(TypeIdHelpers::uniqueId<DummyService>(), 0, ServiceKind::Serial));
+  auto ct0 = reinterpret_cast<DummyService*>(copy.get(TypeIdHelpers::uniqueId<DummyService>(), 0, ServiceKind::Serial));
+  auto ct2 = reinterpret_cast<DummyService*>(copy.get(TypeIdHelpers::uniqueId<DummyService>(), 2, ServiceKind::Serial));
+  auto ct3 = reinterpret_cast<DummyService*>(copy.get(TypeIdHelpers::uniqueId<DummyService>(), 3, ServiceKind::Serial));
+  BOOST_CHECK_EQUAL(tt0->threadId, 0);
+  BOOST_CHECK_EQUAL(ct0->threadId, 1);
+  BOOST_CHECK_EQUAL(ct2->threadId, 1);
+  BOOST_CHECK_EQUAL(ct3->threadId, 1);
+
+  UnknownService unknown;
+  BOOST_CHECK_THROW(copy.overrideService(&unknown), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(TestServiceRegistryCtor)
 {
   using namespace o2::framework;
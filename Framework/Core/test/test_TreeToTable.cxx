@@ -125,6 +125,13 @@ BOOST_AUTO_TEST_CASE(TreeToTableConversion)
   }
   BOOST_REQUIRE_EQUAL(ntruein[1], ntrueout);
 
+  // check the values of the flat numeric column ev
+  auto evs = std::dynamic_pointer_cast<arrow::Int32Array>(table->column(5)->chunk(0));
+  BOOST_REQUIRE_NE(evs.get(), nullptr);
+  for (int ii = 0; ii < table->num_rows(); ii++) {
+    BOOST_CHECK_EQUAL(evs->Value(ii), ii + 1);
+  }
+
   // save table as tree
   TFile* f2 = new TFile("table2tree.root", "RECREATE");
   TableToTree ta2tr(table, f2, "mytree");
@@ -139,3 +146,102 @@ BOOST_AUTO_TEST_CASE(TreeToTableConversion)
 
   f2->Close();
 }
+
+BOOST_AUTO_TEST_CASE(TreeToTableMultipleBaskets)
+{
+  using namespace o2::framework;
+  /// Create a TTree whose flat numeric branches are spread over many baskets
+  Int_t ndp = 100000;
+
+  TFile f1("tree2tablebaskets.root", "RECREATE");
+  TTree t1("t1", "a tree with small baskets");
+  UChar_t ub;
+  UShort_t us;
+  UInt_t ui;
+  ULong64_t ul;
+  Char_t b;
+  Short_t s;
+  Int_t ev;
+  Long64_t l;
+  Float_t f;
+  Double_t d;
+  Bool_t ok;
+  t1.Branch("ub", &ub, "ub/b");
+  t1.Branch("us", &us, "us/s");
+  t1.Branch("ui", &ui, "ui/i");
+  t1.Branch("ul", &ul, "ul/l");
+  t1.Branch("b", &b, "b/B");
+  t1.Branch("s", &s, "s/S");
+  t1.Branch("ev", &ev, "ev/I");
+  t1.Branch("l", &l, "l/L");
+  t1.Branch("f", &f, "f/F");
+  t1.Branch("d", &d, "d/D");
+  t1.Branch("ok", &ok, "ok/O");
+  t1.SetBasketSize("*", 1024);
+
+  for (int i = 0; i < ndp; i++) {
+    ub = i % 251;
+    us = i % 65521;
+    ui = 3 * i;
+    ul = 5000000000ULL + i;
+    b = i % 127 - 63;
+    s = i % 32749 - 16000;
+    ev = i + 1;
+    l = -5000000000LL - i;
+    f = 0.5f * i;
+    d = 0.25 * i;
+    ok = (i % 3) == 0;
+    t1.Fill();
+  }
+  t1.Write();
+  BOOST_REQUIRE_GT(t1.GetBranch("ev")->GetWriteBasket(), 100);
+  BOOST_REQUIRE_GT(t1.GetBranch("d")->GetWriteBasket(), 100);
+
+  TreeToTable tr2ta;
+  BOOST_REQUIRE(tr2ta.addAllColumns(&t1));
+  tr2ta.fill(&t1);
+  auto table = tr2ta.finalize();
+  f1.Close();
+
+  BOOST_REQUIRE_EQUAL(table->Validate().ok(), true);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), ndp);
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 11);
+
+  auto column = [&table](const char* name) {
+    auto chunks = table->GetColumnByName(name);
+    BOOST_REQUIRE_NE(chunks.get(), nullptr);
+    BOOST_REQUIRE_EQUAL(chunks->num_chunks(), 1);
+    return chunks->chunk(0);
+  };
+  auto ubs = std::dynamic_pointer_cast<arrow::UInt8Array>(column("ub"));
+  auto uss = std::dynamic_pointer_cast<arrow::UInt16Array>(column("us"));
+  auto uis = std::dynamic_pointer_cast<arrow::UInt32Array>(column("ui"));
+  auto uls = std::dynamic_pointer_cast<arrow::UInt64Array>(column("ul"));
+  auto bs = std::dynamic_pointer_cast<arrow::Int8Array>(column("b"));
+  auto ss = std::dynamic_pointer_cast<arrow::Int16Array>(column("s"));
+  auto evs = std::dynamic_pointer_cast<arrow::Int32Array>(column("ev"));
+  auto ls = std::dynamic_pointer_cast<arrow::Int64Array>(column("l"));
+  auto fs = std::dynamic_pointer_cast<arrow::FloatArray>(column("f"));
+  auto ds = std::dynamic_pointer_cast<arrow::DoubleArray>(column("d"));
+  auto oks = std::dynamic_pointer_cast<arrow::BooleanArray>(column("ok"));
+  for (auto array : std::vector<arrow::Array*>{ubs.get(), uss.get(), uis.get(), uls.get(), bs.get(), ss.get(), evs.get(), ls.get(), fs.get(), ds.get(), oks.get()}) {
+    BOOST_REQUIRE_NE(array, nullptr);
+  }
+
+  // check every value, counting the mismatches to keep the output readable
+  int nWrong = 0;
+  for (int i = 0; i < ndp; i++) {
+    nWrong += ubs->Value(i) != i % 251;
+    nWrong += uss->Value(i) != i % 65521;
+    nWrong += uis->Value(i) != 3u * i;
+    nWrong += uls->Value(i) != 5000000000ULL + i;
+    nWrong += bs->Value(i) != i % 127 - 63;
+    nWrong += ss->Value(i) != i % 32749 - 16000;
+    nWrong += evs->Value(i) != i + 1;
+    nWrong += ls->Value(i) != -5000000000LL - i;
+    nWrong += fs->Value(i) != 0.5f * i;
+    nWrong += ds->Value(i) != 0.25 * i;
+    nWrong += oks->Value(i) != ((i % 3) == 0);
+  }
+  BOOST_CHECK_EQUAL(nWrong, 0);
+}
@@ -144,6 +144,39 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
 
   int streamMap[NSLICES];
 
+  // On the CPU, the global tracking and the output of a slice only depend on the local tracking of the slice and of its two neighbours.
+  // Instead of waiting for all slices after the loop, they are run by the thread that completes the last of these slices.
+  // Only this barrier is removed: the merger, the compression and the clusterizer of the next fragment still run as separate steps after the slice tracking.
+  const bool runSliceOutputInLoop = !(doGPU || GetProcessingSettings().debugLevel >= 1);
+  std::array<std::atomic<bool>, NSLICES> sliceTrackingDone;
+  std::array<std::atomic_flag, NSLICES> sliceOutputClaimed;
+  for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+    sliceTrackingDone[iSlice] = false;
+    sliceOutputClaimed[iSlice].clear();
+  }
+  auto runSliceOutputIfReady = [&](unsigned int iSlice) {
+    sliceTrackingDone[iSlice] = true;
+    unsigned int candidates[3] = {iSlice, iSlice, iSlice};
+    if (param().rec.tpc.globalTracking) {
+      GPUTPCGlobalTracking::GlobalTrackingSliceLeftRight(iSlice, candidates[1], candidates[2]);
+    }
+    for (unsigned int tmpSlice : candidates) {
+      unsigned int sliceLeft = tmpSlice, sliceRight = tmpSlice;
+      if (param().rec.tpc.globalTracking) {
+        GPUTPCGlobalTracking::GlobalTrackingSliceLeftRight(tmpSlice, sliceLeft, sliceRight);
+      }
+      if (!sliceTrackingDone[tmpSlice] || !sliceTrackingDone[sliceLeft] || !sliceTrackingDone[sliceRight] || sliceOutputClaimed[tmpSlice].test_and_set()) {
+        continue;
+      }
+      if (param().rec.tpc.globalTracking) {
+        GlobalTracking(tmpSlice, 0);
+      }
+      if (GetRecoStepsOutputs() & GPUDataTypes::InOutType::TPCSectorTracks) {
+        WriteOutput(tmpSlice, 0);
+      }
+    }
+  };
+
   bool error = false;
   GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
   for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
@@ -177,6 +210,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
     }
     if (!doGPU && trk.CheckEmptySlice() && GetProcessingSettings().debugLevel == 0) {
+      runSliceOutputIfReady(iSlice);
       continue;
     }
 
@@ -254,6 +288,9 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
       DoDebugAndDump(RecoStep::TPCSliceTracking, 512, trk, &GPUTPCTracker::DumpTrackHits, *mDebugFile);
     }
+    if (runSliceOutputInLoop) {
+      runSliceOutputIfReady(iSlice);
+    }
   }
   mRec->SetNestedLoopOmpFactor(1);
   if (error) {
@@ -418,17 +455,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
     }
   } else {
-    mSliceSelectorReady = NSLICES;
-    GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
-    for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
-      if (param().rec.tpc.globalTracking) {
-        GlobalTracking(iSlice, 0);
-      }
-      if (GetRecoStepsOutputs() & GPUDataTypes::InOutType::TPCSectorTracks) {
-        WriteOutput(iSlice, 0);
-      }
-    }
-    mRec->SetNestedLoopOmpFactor(1);
+    mSliceSelectorReady = NSLICES; // Global tracking and output already done in the slice loop
   }
 
   if (param().rec.tpc.globalTracking && GetProcessingSettings().debugLevel >= 3) {
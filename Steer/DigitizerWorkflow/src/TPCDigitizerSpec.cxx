@@ -168,6 +168,8 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       }
     }
     mDigitizer.setContinuousReadout(!triggeredMode);
+    mDigitizer.setNThreads(ic.options().get<int>("nthreads"));
+    LOG(INFO) << "TPC: Digitizing with " << mDigitizer.getNThreads() << " thread(s)";
 
     // we send the GRP data once if the corresponding output channel is available
     // and set the flag to false after
@@ -479,7 +481,8 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
     Options{{"distortionType", VariantType::Int, 0, {"Distortion type to be used. 0 = no distortions (default), 1 = realistic distortions (not implemented yet), 2 = constant distortions"}},
             {"initialSpaceChargeDensity", VariantType::String, "", {"Path to root file containing TH3 with initial space-charge density and name of the TH3 (comma separated)"}},
             {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
-            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}}}};
+            {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}},
+            {"nthreads", VariantType::Int, 1, {"Number of threads processing the hits of a sector"}}}};
 }
 
 o2::framework::WorkflowSpec getTPCDigitizerSpec(int nLanes, std::vector<int> const& sectors, bool mctruth, bool internalwriter)
@@ -18,15 +18,31 @@
 
 #include "Mergers/MergeInterface.h"
 
+#include <vector>
+
 class TObject;
 
 namespace o2::mergers::algorithm
 {
 
+/// \brief Status bit of the objects created by compactDelta().
+constexpr UInt_t kCompactDelta = BIT(22);
+
 /// \brief A function which merges TObjects
 void merge(TObject* const target, TObject* const other);
+/// \brief Merges all the other objects into the target. If the target is a TCollection, its entries are merged in parallel by nThreads threads.
+void merge(TObject* const target, const std::vector<TObject*>& others, size_t nThreads);
 void deleteTCollections(TObject* obj);
 
+/// \brief Converts an object containing differences into a compact form, which is then merged by merge().
+///
+/// TH1, TH2, TH3 and THn are converted into a THnSparseD with the same binning, which keeps only the bins
+/// which have changed. TCollections are converted recursively, any other objects are cloned. Since compact deltas
+/// cannot be used as the first merged object, a producer should send the full object in the first publication.
+TObject* compactDelta(const TObject* difference);
+/// \brief Checks if the object or any entry of a TCollection is a compact delta.
+bool containsCompactDelta(const TObject* obj);
+
 } // namespace o2::mergers::algorithm
 
 #endif //ALICEO2_MERGERS_H
@@ -36,6 +36,14 @@ enum class MergedObjectTimespan {
   LastDifference
 };
 
+enum class InputObjectsFormat {
+  FullObjects,  // Mergers expect complete objects.
+  // After the first, full object, each input may send compact deltas (see algorithm::compactDelta()).
+  // They are added to the merged object, thus they require InputObjectsTimespan::LastDifference
+  // and MergedObjectTimespan::FullHistory.
+  CompactDeltas
+};
+
 enum class PublicationDecision {
   EachNSeconds,       // Merged object is published each N seconds.
 };
@@ -45,6 +53,11 @@ enum class TopologySize {
   ReductionFactor // User specifies how many sources should be handled by one merger (by maximum).
 };
 
+enum class ParallelMerging {
+  Disabled,       // Received objects are merged one after another.
+  NumberOfThreads // Entries of merged collections are merged in parallel by the specified number of threads.
+};
+
 template <typename V, typename P = double>
 struct ConfigEntry {
   V value;
@@ -55,8 +68,10 @@ struct ConfigEntry {
 struct MergerConfig {
   ConfigEntry<InputObjectsTimespan> inputObjectTimespan = {InputObjectsTimespan::FullHistory};
   ConfigEntry<MergedObjectTimespan> mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
+  ConfigEntry<InputObjectsFormat> inputObjectsFormat = {InputObjectsFormat::FullObjects};
   ConfigEntry<PublicationDecision> publicationDecision = {PublicationDecision::EachNSeconds, 10};
   ConfigEntry<TopologySize, int> topologySize = {TopologySize::NumberOfLayers, 1};
+  ConfigEntry<ParallelMerging, int> parallelMerging = {ParallelMerging::Disabled, 1};
 };
 
 } // namespace o2::mergers
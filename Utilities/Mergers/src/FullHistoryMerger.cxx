@@ -22,6 +22,7 @@
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 #include <Monitoring/MonitoringFactory.h>
+#include <TROOT.h>
 
 using namespace o2::header;
 using namespace o2::framework;
@@ -46,6 +47,9 @@ FullHistoryMerger::~FullHistoryMerger()
 
 void FullHistoryMerger::init(framework::InitContext& ictx)
 {
+  if (mConfig.parallelMerging.value == ParallelMerging::NumberOfThreads && mConfig.parallelMerging.param > 1) {
+    ROOT::EnableThreadSafety();
+  }
 }
 
 void FullHistoryMerger::run(framework::ProcessingContext& ctx)
@@ -100,18 +104,24 @@ void FullHistoryMerger::mergeCache()
 
   mMergedObject = object_store_helpers::extractObjectFrom(mFirstObjectSerialized.second);
   assert(!std::holds_alternative<std::monostate>(mMergedObject));
+  if (std::holds_alternative<TObjectPtr>(mMergedObject) && algorithm::containsCompactDelta(std::get<TObjectPtr>(mMergedObject).get())) {
+    mMergedObject = std::monostate{};
+    throw std::runtime_error("The first object to be merged contains compact deltas, while a full object is expected.");
+  }
   mObjectsMerged++;
 
   // We expect that all the objects use the same kind of interface
   if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
 
     auto target = std::get<TObjectPtr>(mMergedObject);
+    std::vector<TObject*> others;
     for (auto& [name, entry] : mCache) {
       (void)name;
-      auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
-      mObjectsMerged++;
+      others.push_back(std::get<TObjectPtr>(entry).get());
     }
+    size_t threads = mConfig.parallelMerging.value == ParallelMerging::NumberOfThreads ? mConfig.parallelMerging.param : 1;
+    algorithm::merge(target.get(), others, threads);
+    mObjectsMerged += others.size();
 
   } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
     auto target = std::get<MergeInterfacePtr>(mMergedObject);
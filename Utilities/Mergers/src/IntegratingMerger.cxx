@@ -19,6 +19,7 @@
 #include "Mergers/MergerBuilder.h"
 
 #include <Monitoring/MonitoringFactory.h>
+#include <TROOT.h>
 
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
@@ -41,6 +42,9 @@ IntegratingMerger::IntegratingMerger(const MergerConfig& config, const header::D
 
 void IntegratingMerger::init(framework::InitContext& ictx)
 {
+  if (mConfig.parallelMerging.value == ParallelMerging::NumberOfThreads && mConfig.parallelMerging.param > 1) {
+    ROOT::EnableThreadSafety();
+  }
 }
 
 void IntegratingMerger::run(framework::ProcessingContext& ctx)
@@ -48,16 +52,20 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
+  // TObjects received in one go are merged together, so the entries of collections can be merged in parallel.
+  std::vector<TObjectPtr> others;
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
       if (std::holds_alternative<std::monostate>(mMergedObject)) {
         mMergedObject = object_store_helpers::extractObjectFrom(ref);
+        if (std::holds_alternative<TObjectPtr>(mMergedObject) && algorithm::containsCompactDelta(std::get<TObjectPtr>(mMergedObject).get())) {
+          mMergedObject = std::monostate{};
+          throw std::runtime_error("The first received object contains compact deltas, while a full object is expected.");
+        }
 
       } else if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
         // We expect that if the first object was TObject, then all should.
-        auto other = TObjectPtr(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
-        auto target = std::get<TObjectPtr>(mMergedObject);
-        algorithm::merge(target.get(), other.get());
+        others.emplace_back(framework::DataRefUtils::as<TObject>(ref).release(), algorithm::deleteTCollections);
 
       } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
         // We expect that if the first object inherited MergeInterface, then all should.
@@ -70,6 +78,15 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
     }
   }
 
+  if (!others.empty()) {
+    std::vector<TObject*> otherObjects;
+    for (auto& other : others) {
+      otherObjects.push_back(other.get());
+    }
+    size_t threads = mConfig.parallelMerging.value == ParallelMerging::NumberOfThreads ? mConfig.parallelMerging.param : 1;
+    algorithm::merge(std::get<TObjectPtr>(mMergedObject).get(), otherObjects, threads);
+  }
+
   if (ctx.inputs().isValid("timer-publish")) {
 
     publish(ctx.outputs());
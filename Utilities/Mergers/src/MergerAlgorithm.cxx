@@ -25,10 +25,116 @@
 #include <THnSparse.h>
 #include <TObjArray.h>
 #include <TGraph.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <unordered_map>
 
 namespace o2::mergers::algorithm
 {
 
+namespace
+{
+
+THnSparse* createCompactDelta(const char* name, const char* title, const std::vector<const TAxis*>& axes)
+{
+  std::vector<Int_t> nbins;
+  std::vector<Double_t> mins;
+  std::vector<Double_t> maxs;
+  for (auto axis : axes) {
+    nbins.push_back(axis->GetNbins());
+    mins.push_back(axis->GetXmin());
+    maxs.push_back(axis->GetXmax());
+  }
+  auto delta = new THnSparseD(name, title, axes.size(), nbins.data(), mins.data(), maxs.data());
+  for (size_t d = 0; d < axes.size(); d++) {
+    if (axes[d]->GetXbins()->GetSize()) {
+      delta->GetAxis(d)->Set(nbins[d], axes[d]->GetXbins()->GetArray());
+    }
+  }
+  delta->Sumw2();
+  delta->SetBit(kCompactDelta);
+  return delta;
+}
+
+std::vector<const TAxis*> getAxes(const TH1* histo)
+{
+  std::vector<const TAxis*> axes{histo->GetXaxis(), histo->GetYaxis(), histo->GetZaxis()};
+  axes.resize(histo->GetDimension());
+  return axes;
+}
+
+std::vector<const TAxis*> getAxes(const THnBase* histo)
+{
+  std::vector<const TAxis*> axes;
+  for (Int_t d = 0; d < histo->GetNdimensions(); d++) {
+    axes.push_back(histo->GetAxis(d));
+  }
+  return axes;
+}
+
+void checkCompactDeltaBinning(const TObject* target, const std::vector<const TAxis*>& axes, const THnSparse* delta)
+{
+  bool compatible = static_cast<Int_t>(axes.size()) == delta->GetNdimensions();
+  for (size_t d = 0; compatible && d < axes.size(); d++) {
+    compatible = axes[d]->GetNbins() == delta->GetAxis(d)->GetNbins();
+  }
+  if (!compatible) {
+    throw std::runtime_error("The compact delta '" + std::string(delta->GetName()) + "' does not match the binning of the target object '" + target->GetName() + "'.");
+  }
+}
+
+// adds the bins of a compact delta to an object of the type it was created from
+void mergeCompactDelta(TObject* const target, const THnSparse* delta)
+{
+  std::vector<Int_t> coords(3, 0);
+
+  if (auto histo = dynamic_cast<TH1*>(target)) {
+    checkCompactDeltaBinning(target, getAxes(histo), delta);
+    Double_t entries = histo->GetEntries();
+    for (Long64_t i = 0; i < delta->GetNbins(); i++) {
+      Double_t content = delta->GetBinContent(i, coords.data());
+      Double_t error2 = delta->GetBinError2(i);
+      // as in TH1::Fill, the first weighted entry switches on the storage of the squared weights
+      if (histo->GetSumw2N() == 0 && error2 != content && !histo->TestBit(TH1::kIsNotW)) {
+        histo->Sumw2();
+      }
+      Int_t bin = histo->GetBin(coords[0], coords[1], coords[2]);
+      histo->AddBinContent(bin, content);
+      if (histo->GetSumw2N()) {
+        histo->GetSumw2()->fArray[bin] += error2;
+      }
+    }
+    // the statistics of the delta are lost, so we recompute them from the bin contents
+    histo->ResetStats();
+    histo->SetEntries(entries + delta->GetEntries());
+
+  } else if (auto histo = dynamic_cast<THnBase*>(target); histo && !target->InheritsFrom(THnSparse::Class())) {
+    checkCompactDeltaBinning(target, getAxes(histo), delta);
+    coords.resize(delta->GetNdimensions());
+    Double_t entries = histo->GetEntries();
+    for (Long64_t i = 0; i < delta->GetNbins(); i++) {
+      Double_t content = delta->GetBinContent(i, coords.data());
+      Long64_t bin = histo->GetBin(coords.data());
+      histo->AddBinContent(bin, content);
+      if (histo->GetCalculateErrors()) {
+        histo->AddBinError2(bin, delta->GetBinError2(i));
+      }
+    }
+    histo->SetEntries(entries + delta->GetEntries());
+
+  } else {
+    throw std::runtime_error("The compact delta '" + std::string(delta->GetName()) + "' cannot be merged into an object with type '" + target->ClassName() + "'.");
+  }
+}
+
+} // namespace
+
 void merge(TObject* const target, TObject* const other)
 {
   if (target == nullptr) {
@@ -62,12 +168,18 @@ void merge(TObject* const target, TObject* const other)
       if (targetObject) {
         // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
         merge(targetObject, otherObject);
+      } else if (containsCompactDelta(otherObject)) {
+        throw std::runtime_error(std::string("The compact delta '") + otherObject->GetName() + "' has no full object to be merged into.");
       } else {
         // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
         targetCollection->Add(otherObject->Clone());
       }
     }
     delete otherIterator;
+  } else if (other->TestBit(kCompactDelta) && other->InheritsFrom(THnSparse::Class()) && !target->InheritsFrom(THnSparse::Class())) {
+
+    mergeCompactDelta(target, static_cast<THnSparse*>(other));
+
   } else {
     Long64_t errorCode = 0;
     TObjArray otherCollection;
@@ -93,6 +205,140 @@ void merge(TObject* const target, TObject* const other)
   }
 }
 
+void merge(TObject* const target, const std::vector<TObject*>& others, size_t nThreads)
+{
+  auto targetCollection = dynamic_cast<TCollection*>(target);
+  if (nThreads < 2 || targetCollection == nullptr || dynamic_cast<MergeInterface*>(target) != nullptr) {
+    for (auto other : others) {
+      merge(target, other);
+    }
+    return;
+  }
+
+  // The entries of a collection are independent, so we first match them by name (adding the missing ones)
+  // and then merge each of them in parallel. The collections inside are merged serially.
+  std::vector<std::pair<TObject*, std::vector<TObject*>>> entries;
+  std::unordered_map<TObject*, size_t> entryIndices;
+  for (auto other : others) {
+    if (other == nullptr) {
+      throw std::runtime_error("Object to be merged in is nullptr");
+    }
+    auto otherCollection = dynamic_cast<TCollection*>(other);
+    if (otherCollection == nullptr) {
+      throw std::runtime_error(std::string("The target object '") + target->GetName() +
+                               "' is a TCollection, while the other object '" + other->GetName() + "' is not.");
+    }
+    TIter otherIterator(otherCollection);
+    while (auto otherObject = otherIterator.Next()) {
+      TObject* targetObject = targetCollection->FindObject(otherObject->GetName());
+      if (targetObject) {
+        auto [it, inserted] = entryIndices.try_emplace(targetObject, entries.size());
+        if (inserted) {
+          entries.emplace_back(targetObject, std::vector<TObject*>{});
+        }
+        entries[it->second].second.push_back(otherObject);
+      } else if (containsCompactDelta(otherObject)) {
+        throw std::runtime_error(std::string("The compact delta '") + otherObject->GetName() + "' has no full object to be merged into.");
+      } else {
+        targetCollection->Add(otherObject->Clone());
+      }
+    }
+  }
+
+  std::atomic<size_t> nextEntry{0};
+  std::vector<std::exception_ptr> errors(nThreads);
+  auto mergeEntries = [&](size_t thread) {
+    try {
+      for (size_t e = nextEntry++; e < entries.size(); e = nextEntry++) {
+        for (auto otherObject : entries[e].second) {
+          merge(entries[e].first, otherObject);
+        }
+      }
+    } catch (...) {
+      errors[thread] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t thread = 1; thread < std::min(nThreads, entries.size()); thread++) {
+    workers.emplace_back(mergeEntries, thread);
+  }
+  mergeEntries(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+TObject* compactDelta(const TObject* difference)
+{
+  if (difference == nullptr) {
+    throw std::runtime_error("Object to be compacted is nullptr");
+  }
+
+  if (auto collection = dynamic_cast<const TCollection*>(difference)) {
+    auto compactCollection = static_cast<TCollection*>(collection->IsA()->New());
+    compactCollection->SetName(collection->GetName());
+    compactCollection->SetOwner(true);
+    TIter iterator(collection);
+    while (auto object = iterator.Next()) {
+      compactCollection->Add(compactDelta(object));
+    }
+    return compactCollection;
+
+  } else if (auto histo = dynamic_cast<const TH1*>(difference);
+             histo && !difference->InheritsFrom(TProfile::Class()) && !difference->InheritsFrom(TProfile2D::Class()) && !difference->InheritsFrom(TProfile3D::Class())) {
+    auto delta = createCompactDelta(histo->GetName(), histo->GetTitle(), getAxes(histo));
+    Int_t coords[3] = {0, 0, 0};
+    for (Int_t bin = 0; bin < histo->GetNcells(); bin++) {
+      Double_t content = histo->GetBinContent(bin);
+      Double_t error2 = histo->GetSumw2N() ? histo->GetSumw2()->At(bin) : content;
+      if (content != 0 || error2 != 0) {
+        histo->GetBinXYZ(bin, coords[0], coords[1], coords[2]);
+        Long64_t deltaBin = delta->GetBin(coords, kTRUE);
+        delta->SetBinContent(deltaBin, content);
+        delta->SetBinError2(deltaBin, error2);
+      }
+    }
+    delta->SetEntries(histo->GetEntries());
+    return delta;
+
+  } else if (auto histo = dynamic_cast<const THnBase*>(difference); histo && !difference->InheritsFrom(THnSparse::Class())) {
+    auto delta = createCompactDelta(histo->GetName(), histo->GetTitle(), getAxes(histo));
+    std::vector<Int_t> coords(histo->GetNdimensions(), 0);
+    for (Long64_t bin = 0; bin < histo->GetNbins(); bin++) {
+      Double_t content = histo->GetBinContent(bin, coords.data());
+      Double_t error2 = histo->GetCalculateErrors() ? histo->GetBinError2(bin) : content;
+      if (content != 0 || error2 != 0) {
+        Long64_t deltaBin = delta->GetBin(coords.data(), kTRUE);
+        delta->SetBinContent(deltaBin, content);
+        delta->SetBinError2(deltaBin, error2);
+      }
+    }
+    delta->SetEntries(histo->GetEntries());
+    return delta;
+  }
+
+  return difference->Clone();
+}
+
+bool containsCompactDelta(const TObject* obj)
+{
+  if (auto collection = dynamic_cast<const TCollection*>(obj)) {
+    TIter iterator(collection);
+    while (auto object = iterator.Next()) {
+      if (containsCompactDelta(object)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return obj != nullptr && obj->TestBit(kCompactDelta) && obj->InheritsFrom(THnSparse::Class());
+}
+
 void deleteTCollections(TObject* obj)
 {
   if (auto c = dynamic_cast<TCollection*>(obj)) {
@@ -72,6 +72,14 @@ std::string MergerInfrastructureBuilder::validateConfig()
   if (mConfig.inputObjectTimespan.value == InputObjectsTimespan::FullHistory && mConfig.mergedObjectTimespan.value == MergedObjectTimespan::LastDifference) {
     error += preamble + "MergedObjectTimespan::LastDifference does not apply to InputObjectsTimespan::FullHistory\n";
   }
+  if (mConfig.inputObjectsFormat.value == InputObjectsFormat::CompactDeltas) {
+    if (mConfig.inputObjectTimespan.value != InputObjectsTimespan::LastDifference) {
+      error += preamble + "InputObjectsFormat::CompactDeltas requires InputObjectsTimespan::LastDifference\n";
+    }
+    if (mConfig.mergedObjectTimespan.value != MergedObjectTimespan::FullHistory) {
+      error += preamble + "InputObjectsFormat::CompactDeltas requires MergedObjectTimespan::FullHistory\n";
+    }
+  }
 
   for (const auto& input : mInputs) {
     if (DataSpecUtils::match(input, mOutputSpec)) {
@@ -107,6 +115,7 @@ framework::WorkflowSpec MergerInfrastructureBuilder::generateInfrastructure()
     if (layer > 1 && mConfig.inputObjectTimespan.value == InputObjectsTimespan::LastDifference) {
       layerConfig.inputObjectTimespan = {InputObjectsTimespan::FullHistory};     // in LastDifference mode only the first layer should integrate
       layerConfig.mergedObjectTimespan = {MergedObjectTimespan::LastDifference}; // and objects that are merged should not be used again
+      layerConfig.inputObjectsFormat = {InputObjectsFormat::FullObjects};         // the first layer publishes full objects
     }
     mergerBuilder.setConfig(layerConfig);
 
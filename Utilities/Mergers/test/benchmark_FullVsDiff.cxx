@@ -9,6 +9,8 @@
 // or submit itself to any jurisdiction.
 #include <benchmark/benchmark.h>
 
+#include "Mergers/MergerAlgorithm.h"
+
 #include <TObjArray.h>
 #include <TH1.h>
 #include <TH2.h>
@@ -20,6 +22,7 @@
 #include <TF3.h>
 #include <TRandom.h>
 #include <TRandomGen.h>
+#include <TROOT.h>
 #include <chrono>
 #include <ctime>
 
@@ -68,6 +71,87 @@ static void BM_MergingTH1I(benchmark::State& state)
   delete uni;
 }
 
+// Diffs converted to compact deltas, which contain only the filled bins
+static void BM_MergingTH1ICompactDelta(benchmark::State& state)
+{
+  const size_t entries = entriesInDiff;
+  const size_t bins = 62500; // makes 250kB
+
+  std::vector<TObject*> deltas;
+  TF1* uni = new TF1("uni", "1", 0, 1000000);
+  for (size_t i = 0; i < collectionSize; i++) {
+    TH1I* h = new TH1I(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000);
+    h->FillRandom("uni", entries);
+    deltas.push_back(o2::mergers::algorithm::compactDelta(h));
+    delete h;
+  }
+
+  TH1I* m = new TH1I("merged", "merged", bins, 0, 1000000);
+  // avoid memory overcommitment by doing something with data.
+  for (size_t i = 0; i < bins; i++) {
+    m->SetBinContent(i, 1);
+  }
+
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto delta : deltas) {
+      o2::mergers::algorithm::merge(m, delta);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+
+  for (auto delta : deltas) {
+    delete delta;
+  }
+  delete m;
+  delete uni;
+}
+
+// Full TH1I objects in collections, whose entries are merged by state.range(0) threads
+static void BM_MergingCollectionsInParallel(benchmark::State& state)
+{
+  const size_t threads = state.range(0);
+  const size_t bins = 62500; // makes 250kB
+  const size_t producers = 8;
+
+  ROOT::EnableThreadSafety();
+  TF1* uni = new TF1("uni", "1", 0, 1000000);
+  auto createCollection = [&]() {
+    TObjArray* collection = new TObjArray();
+    collection->SetOwner(true);
+    for (size_t i = 0; i < collectionSize; i++) {
+      TH1I* h = new TH1I(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000);
+      h->FillRandom("uni", entriesInFull);
+      collection->Add(h);
+    }
+    return collection;
+  };
+
+  std::vector<TObject*> others;
+  for (size_t p = 0; p < producers; p++) {
+    others.push_back(createCollection());
+  }
+  TObjArray* m = createCollection();
+
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+    o2::mergers::algorithm::merge(m, others, threads);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+
+  for (auto other : others) {
+    delete other;
+  }
+  delete m;
+  delete uni;
+}
+
 static void BM_MergingTH2I(benchmark::State& state)
 {
   const size_t entries = state.range(0) == FULL_OBJECTS ? entriesInFull : entriesInDiff;
@@ -249,6 +333,8 @@ static void BM_MergingTTree(benchmark::State& state)
 
 BENCHMARK(BM_MergingTH1I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH1I)->Arg(FULL_OBJECTS)->UseManualTime();
+BENCHMARK(BM_MergingTH1ICompactDelta)->UseManualTime();
+BENCHMARK(BM_MergingCollectionsInParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseManualTime();
 BENCHMARK(BM_MergingTH2I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH2I)->Arg(FULL_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH3I)->Arg(DIFF_OBJECTS)->UseManualTime();
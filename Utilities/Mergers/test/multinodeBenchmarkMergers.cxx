@@ -38,6 +38,8 @@ void customize(std::vector<ConfigParamSpec>& options)
   options.push_back({"mergers-publication-interval", VariantType::Double, 10.0, {"Publication interval of merged object [s]. It takes effect with --mergers-publication-decision interval"}});
   options.push_back(
     {"mergers-ownership-mode", VariantType::String, "diffs", {"Should the topology use 'diffs' or 'full' objects"}});
+  options.push_back({"mergers-parallel-threads", VariantType::Int, 1, {"Number of threads merging the entries of collections in parallel"}});
+  options.push_back({"mergers-compact-deltas", VariantType::Bool, false, {"Producers send compact deltas after the first, full object"}});
   options.push_back({"input-channel-config", VariantType::String, "", {"Proxy input FMQ channel configuration"}});
 }
 
@@ -57,6 +59,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   double mergersPublicationInterval = config.options().get<double>("mergers-publication-interval");
   InputObjectsTimespan mergersOwnershipMode =
     config.options().get<std::string>("mergers-ownership-mode") == "full" ? InputObjectsTimespan::FullHistory : InputObjectsTimespan::LastDifference;
+  int mergersParallelThreads = config.options().get<int>("mergers-parallel-threads");
+  bool mergersCompactDeltas = config.options().get<bool>("mergers-compact-deltas");
   std::string inputChannelConfig = config.options().get<std::string>("input-channel-config");
 
   WorkflowSpec specs;
@@ -75,7 +79,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   mergerConfig.inputObjectTimespan = {mergersOwnershipMode};
   mergerConfig.publicationDecision = {mergersPublicationDecision, mergersPublicationDecision == PublicationDecision::EachNSeconds ? mergersPublicationInterval : 1.0};
   mergerConfig.mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
+  mergerConfig.inputObjectsFormat = {mergersCompactDeltas ? InputObjectsFormat::CompactDeltas : InputObjectsFormat::FullObjects};
   mergerConfig.topologySize = {TopologySize::NumberOfLayers, mergersLayers};
+  mergerConfig.parallelMerging = {mergersParallelThreads > 1 ? ParallelMerging::NumberOfThreads : ParallelMerging::Disabled, mergersParallelThreads};
   mergersBuilder.setConfig(mergerConfig);
 
   mergersBuilder.generateInfrastructure(specs);
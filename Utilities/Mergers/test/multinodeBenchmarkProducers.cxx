@@ -28,14 +28,17 @@ void customize(std::vector<ConfigParamSpec>& options)
   options.push_back({"obj-per-message", VariantType::Int, 1, {"Number objects per message (in one TCollection)"}});
   options.push_back({"output-channel-config", VariantType::String, "", {"Proxy output FMQ channel configuration"}});
   options.push_back({"first-subspec", VariantType::Int, 1, {"First subSpec of the parallel producers, the rest will be incremental"}});
+  options.push_back({"obj-compact-deltas", VariantType::Bool, false, {"Send compact deltas after the first, full object"}});
 }
 
 #include <Framework/runDataProcessing.h>
 #include <fairmq/FairMQLogger.h>
 #include "Framework/ExternalFairMQDeviceProxy.h"
+#include "Mergers/MergerAlgorithm.h"
 #include <TRandomGen.h>
 #include <TObjArray.h>
 #include <TH1F.h>
+#include <memory>
 
 using namespace std::chrono;
 using SubSpec = o2::header::DataHeader::SubSpecificationType;
@@ -48,6 +51,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   int objectsPerMessage = config.options().get<int>("obj-per-message");
   std::string outputChannelConfig = config.options().get<std::string>("output-channel-config");
   SubSpec subSpec = static_cast<SubSpec>(config.options().get<int>("first-subspec"));
+  bool compactDeltas = config.options().get<bool>("obj-compact-deltas");
   WorkflowSpec specs;
   // clang-format off
   // one 1D histo
@@ -72,6 +76,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
             collection->Add(h);
           }
 
+          // mergers need a full object to merge the compact deltas into
+          bool firstPublication = true;
+
           return (AlgorithmSpec::ProcessCallback)[=](ProcessingContext& pctx) mutable {
 
             static auto lastTime = steady_clock::now() - std::chrono::microseconds(periodus * p / objectsProducers);
@@ -88,9 +95,14 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
                   h->FillN(randoms, randomsArray, nullptr);
                 }
 
-                collection->SetOwner(false);
-                pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *collection);
-                collection->SetOwner(true);
+                if (compactDeltas && !firstPublication) {
+                  std::unique_ptr<TObject> delta(o2::mergers::algorithm::compactDelta(collection));
+                  pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *delta);
+                } else {
+                  collection->SetOwner(false);
+                  pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *collection);
+                  collection->SetOwner(true);
+                }
               } else {
                 gen.RndmArray(randoms, randomsArray);
 
@@ -98,8 +110,14 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
                 h->Reset();
                 h->FillN(randoms, randomsArray, nullptr);
 
-                pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *h);
+                if (compactDeltas && !firstPublication) {
+                  std::unique_ptr<TObject> delta(o2::mergers::algorithm::compactDelta(h));
+                  pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *delta);
+                } else {
+                  pctx.outputs().snapshot({"TST", "HISTO", subSpec}, *h);
+                }
               }
+              firstPublication = false;
             }
           };
         }
@@ -34,6 +34,7 @@
 #include <TF1.h>
 #include <TGraph.h>
 #include <TProfile.h>
+#include <TROOT.h>
 
 //using namespace o2::framework;
 using namespace o2::mergers;
@@ -299,6 +300,128 @@ BOOST_AUTO_TEST_CASE(MergerCollection)
   delete target;
 }
 
+BOOST_AUTO_TEST_CASE(MergerCompactDeltas)
+{
+  {
+    TH1I* target = new TH1I("histo 1d", "histo 1d", bins, min, max);
+    target->Fill(5);
+    TH1I* difference = new TH1I("histo 1d", "histo 1d", bins, min, max);
+    difference->Fill(2);
+    difference->Fill(2);
+    difference->Fill(-1);
+
+    TObject* delta = algorithm::compactDelta(difference);
+    BOOST_REQUIRE(delta->InheritsFrom(THnSparse::Class()));
+    BOOST_CHECK(algorithm::containsCompactDelta(delta));
+    BOOST_CHECK_EQUAL(dynamic_cast<THnSparse*>(delta)->GetNbins(), 2);
+
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, delta));
+    BOOST_CHECK_EQUAL(target->GetBinContent(target->FindBin(2)), 2);
+    BOOST_CHECK_EQUAL(target->GetBinContent(target->FindBin(5)), 1);
+    BOOST_CHECK_EQUAL(target->GetBinContent(0), 1);
+    BOOST_CHECK_EQUAL(target->GetEntries(), 4);
+
+    TH1I* otherBinning = new TH1I("histo 1d", "histo 1d", bins + 1, min, max);
+    BOOST_CHECK_THROW(algorithm::merge(otherBinning, delta), std::runtime_error);
+
+    delete otherBinning;
+    delete delta;
+    delete difference;
+    delete target;
+  }
+  {
+    const Int_t binsDims[] = {bins, bins, bins};
+    const Double_t mins[] = {min, min, min};
+    const Double_t maxs[] = {max, max, max};
+    THnD* target = new THnD("histo nd", "histo nd", 3, binsDims, mins, maxs);
+    THnD* difference = new THnD("histo nd", "histo nd", 3, binsDims, mins, maxs);
+    Double_t entry[] = {5, 5, 5};
+    difference->Fill(entry, 2.0);
+
+    TObject* delta = algorithm::compactDelta(difference);
+    BOOST_CHECK_NO_THROW(algorithm::merge(target, delta));
+    BOOST_CHECK_EQUAL(target->GetBinContent(target->GetBin(entry)), 2);
+    BOOST_CHECK_EQUAL(target->GetEntries(), 1);
+
+    delete delta;
+    delete difference;
+    delete target;
+  }
+  {
+    // a compact delta cannot be the first object of its kind in a collection
+    TObjArray* target = new TObjArray();
+    target->SetOwner(true);
+    TObjArray* difference = new TObjArray();
+    difference->SetOwner(true);
+    TH1I* histo = new TH1I("histo 1d", "histo 1d", bins, min, max);
+    histo->Fill(5);
+    difference->Add(histo);
+
+    TObject* delta = algorithm::compactDelta(difference);
+    BOOST_CHECK(delta->InheritsFrom(TObjArray::Class()));
+    BOOST_CHECK_THROW(algorithm::merge(target, delta), std::runtime_error);
+
+    // mergers refuse the first object if it contains any compact delta
+    BOOST_CHECK(!algorithm::containsCompactDelta(target));
+    BOOST_CHECK(!algorithm::containsCompactDelta(difference));
+    BOOST_CHECK(algorithm::containsCompactDelta(delta));
+    TObjArray* mixed = new TObjArray();
+    mixed->SetOwner(true);
+    mixed->Add(histo->Clone("full"));
+    mixed->Add(algorithm::compactDelta(histo));
+    BOOST_CHECK(algorithm::containsCompactDelta(mixed));
+    delete mixed;
+
+    delete delta;
+    delete difference;
+    delete target;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MergerCollectionsInParallel)
+{
+  ROOT::EnableThreadSafety();
+  const size_t entries = 20;
+  auto createCollection = [&](int fills) {
+    TObjArray* collection = new TObjArray();
+    collection->SetOwner(true);
+    for (size_t i = 0; i < entries; i++) {
+      TH1I* histo = new TH1I(("histo " + std::to_string(i)).c_str(), "histo", bins, min, max);
+      for (int f = 0; f < fills; f++) {
+        histo->Fill(i % max);
+      }
+      collection->Add(histo);
+    }
+    return collection;
+  };
+
+  TObjArray* target = createCollection(1);
+  std::vector<TObject*> others;
+  for (int o = 1; o <= 8; o++) {
+    TObjArray* difference = createCollection(o);
+    others.push_back(algorithm::compactDelta(difference));
+    delete difference;
+  }
+  others.push_back(createCollection(1));
+  TH1I* onlyInOther = new TH1I("only in other", "only in other", bins, min, max);
+  dynamic_cast<TObjArray*>(others.back())->Add(onlyInOther);
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, others, 4));
+
+  BOOST_REQUIRE_EQUAL(target->GetEntries(), entries + 1);
+  for (size_t i = 0; i < entries; i++) {
+    TH1I* result = dynamic_cast<TH1I*>(target->FindObject(("histo " + std::to_string(i)).c_str()));
+    BOOST_REQUIRE(result != nullptr);
+    BOOST_CHECK_EQUAL(result->GetBinContent(result->FindBin(i % max)), 1 + 36 + 1);
+  }
+  BOOST_CHECK(target->FindObject("only in other") != nullptr);
+
+  for (auto other : others) {
+    delete other;
+  }
+  delete target;
+}
+
 BOOST_AUTO_TEST_CASE(Deleting)
 {
   TObjArray* main = new TObjArray();
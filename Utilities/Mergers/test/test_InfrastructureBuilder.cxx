@@ -172,3 +172,41 @@ BOOST_AUTO_TEST_CASE(InfrastructureBuilderReductionFactor)
     BOOST_CHECK_EQUAL(concrete.subSpec, 0);
   }
 }
+
+BOOST_AUTO_TEST_CASE(InfrastructureBuilderCompactDeltas)
+{
+  MergerInfrastructureBuilder builder;
+  builder.setInfrastructureName("name");
+  builder.setInputSpecs({{"one", "TST", "test", 1},
+                         {"two", "TST", "test", 2},
+                         {"thr", "TST", "test", 3},
+                         {"fou", "TST", "test", 4}});
+  builder.setOutputSpec({{"main"}, "TST", "test", 0});
+  MergerConfig config;
+  config.inputObjectsFormat = {InputObjectsFormat::CompactDeltas};
+
+  {
+    // FullHistoryMerger keeps only the latest object of each input
+    config.inputObjectTimespan = {InputObjectsTimespan::FullHistory};
+    config.mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
+    builder.setConfig(config);
+    BOOST_CHECK_THROW(builder.generateInfrastructure(), std::runtime_error);
+  }
+
+  {
+    // the merged object is reset after each publication, thus the next compact delta would have no target
+    config.inputObjectTimespan = {InputObjectsTimespan::LastDifference};
+    config.mergedObjectTimespan = {MergedObjectTimespan::LastDifference};
+    builder.setConfig(config);
+    BOOST_CHECK_THROW(builder.generateInfrastructure(), std::runtime_error);
+  }
+
+  {
+    config.inputObjectTimespan = {InputObjectsTimespan::LastDifference};
+    config.mergedObjectTimespan = {MergedObjectTimespan::FullHistory};
+    config.topologySize = {TopologySize::NumberOfLayers, 2};
+    builder.setConfig(config);
+    auto mergersTopology = builder.generateInfrastructure();
+    BOOST_CHECK_EQUAL(mergersTopology.size(), 3);
+  }
+}
@@ -0,0 +1,284 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedLiteralDecoder.h
+/// @since  2021-03-01
+/// @brief  Decoder for the streams of InterleavedLiteralEncoder, with AVX2 kernel for 8 64 bit states
+
+#ifndef RANS_INTERLEAVEDLITERALDECODER_H
+#define RANS_INTERLEAVEDLITERALDECODER_H
+
+#include "LiteralDecoder.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <fairlogger/Logger.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define RANS_INTERLEAVED_AVX2
+#endif
+
+#include "internal/helper.h"
+
+namespace o2
+{
+namespace rans
+{
+
+/// Decodes the N-way interleaved streams produced by InterleavedLiteralEncoder. For 64 bit states with 32 bit
+/// streaming and 8 states the bulk of the message is decoded with an AVX2 kernel (selected at runtime),
+/// otherwise the states are advanced one after the other. The legacy 2-state format stays available
+/// via LiteralDecoder::process.
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams = 8>
+class InterleavedLiteralDecoder : public LiteralDecoder<coder_T, stream_T, source_T>
+{
+ public:
+  InterleavedLiteralDecoder(const FrequencyTable& stats, size_t probabilityBits);
+  InterleavedLiteralDecoder(const InterleavedLiteralDecoder& d) = default;
+  InterleavedLiteralDecoder(InterleavedLiteralDecoder&& d) = default;
+  InterleavedLiteralDecoder& operator=(const InterleavedLiteralDecoder& d) = default;
+  InterleavedLiteralDecoder& operator=(InterleavedLiteralDecoder&& d) = default;
+  ~InterleavedLiteralDecoder() = default;
+
+  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT> && internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  void process(const source_IT outputBegin, const stream_IT inputEnd, size_t messageLength, std::vector<source_T>& literals) const;
+
+  static constexpr size_t getNStreams() { return NStreams; }
+
+  /// AVX2 kernel can be used for this decoder instance on the current CPU
+  bool isVectorized() const { return mUseAVX2; }
+  /// force the scalar decoding, e.g. for validation of the vectorized kernel
+  void setForceScalar(bool v) { mUseAVX2 = !v && canVectorize(); }
+
+ private:
+  static bool canVectorize();
+
+  // decode nGroups x NStreams symbols with the AVX2 kernel, states and input pointer are updated
+  const uint32_t* decodeGroupsAVX2(const uint32_t* in, uint64_t* states, int32_t* symbols, size_t nGroups) const;
+
+  // per cumulative frequency: symbol index wrt min symbol; per symbol index: frequency | start << 32
+  std::vector<uint32_t> mSymbolIndexLUT;
+  std::vector<uint64_t> mSymbolInfo;
+  int64_t mEscapeIndex = -1; // index of the escape symbol, -1 if it cannot occur in the stream
+  int64_t mMinSymbol = 0;
+  bool mUseAVX2 = false;
+};
+
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+InterleavedLiteralDecoder<coder_T, stream_T, source_T, NStreams>::InterleavedLiteralDecoder(const FrequencyTable& stats, size_t probabilityBits) : LiteralDecoder<coder_T, stream_T, source_T>(stats, probabilityBits)
+{
+  using namespace internal;
+  RANSTimer t;
+  t.start();
+  // flatten the reverse lookup and symbol tables built by the base class, so that the symbol of a
+  // cumulative frequency and its start/frequency are accessible with 2 plain (gather) loads
+  mMinSymbol = this->mSymbolTable->getMinSymbol();
+  const size_t nCumul = bitsToRange(this->mProbabilityBits);
+  mSymbolIndexLUT.resize(nCumul);
+  for (size_t cumul = 0; cumul < nCumul; cumul++) {
+    const int64_t symbol = (*this->mReverseLUT)[cumul];
+    const uint32_t index = symbol - mMinSymbol;
+    mSymbolIndexLUT[cumul] = index;
+    if (index >= mSymbolInfo.size()) {
+      mSymbolInfo.resize(index + 1, 0);
+    }
+    const auto& decSymbol = (*this->mSymbolTable)[symbol];
+    mSymbolInfo[index] = uint64_t(decSymbol.freq) | (uint64_t(decSymbol.start) << 32);
+    if (this->mSymbolTable->isRareSymbol(symbol)) {
+      mEscapeIndex = index;
+    }
+  }
+  mUseAVX2 = canVectorize();
+  t.stop();
+  LOG(debug1) << "InterleavedDecoder lookup tables inclusive time (ms): " << t.getDurationMS() << ", AVX2 kernel: " << mUseAVX2;
+}
+
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+bool InterleavedLiteralDecoder<coder_T, stream_T, source_T, NStreams>::canVectorize()
+{
+#ifdef RANS_INTERLEAVED_AVX2
+  if constexpr (std::is_same_v<coder_T, uint64_t> && std::is_same_v<stream_T, uint32_t> && NStreams == 8) {
+    return __builtin_cpu_supports("avx2");
+  }
+#endif
+  return false;
+}
+
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT> && internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+void InterleavedLiteralDecoder<coder_T, stream_T, source_T, NStreams>::process(const source_IT outputBegin, const stream_IT inputEnd, size_t messageLength, std::vector<source_T>& literals) const
+{
+  using namespace internal;
+  LOG(trace) << "start decoding";
+  RANSTimer t;
+  t.start();
+  static_assert(std::is_same<typename std::iterator_traits<source_IT>::value_type, source_T>::value);
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+
+  if (messageLength == 0) {
+    LOG(warning) << "Empty message passed to decoder, skipping decode process";
+    return;
+  }
+
+  const coder_T mask = (coder_T(1) << this->mProbabilityBits) - 1;
+  constexpr coder_T LowerBound = needs64Bit<coder_T>() ? (1u << 31) : (1u << 23);
+  constexpr size_t StreamBits = sizeof(stream_T) * 8;
+
+  source_IT it = outputBegin;
+  auto toSymbol = [&, this](uint32_t index) -> source_T {
+    if (static_cast<int64_t>(index) == mEscapeIndex) {
+      const source_T symbol = literals.back();
+      literals.pop_back();
+      return symbol;
+    }
+    return static_cast<source_T>(mMinSymbol + index);
+  };
+
+  // initialize the states, the 1st one was flushed last
+  stream_IT inputIter = inputEnd;
+  --inputIter;
+  std::array<coder_T, NStreams> states;
+  for (auto& x : states) {
+    x = 0;
+    for (size_t w = 0; w < sizeof(coder_T) / sizeof(stream_T); w++) {
+      x |= static_cast<coder_T>(*inputIter) << (w * StreamBits);
+      --inputIter;
+    }
+  }
+
+  size_t nDecoded = 0;
+#ifdef RANS_INTERLEAVED_AVX2
+  if constexpr (std::is_same_v<coder_T, uint64_t> && std::is_same_v<stream_T, uint32_t> && NStreams == 8 && std::is_pointer_v<stream_IT>) {
+    if (mUseAVX2) {
+      constexpr size_t GroupsPerBatch = 64;
+      std::array<int32_t, GroupsPerBatch * NStreams> indices;
+      const size_t nGroups = messageLength / NStreams;
+      for (size_t group = 0; group < nGroups; group += GroupsPerBatch) {
+        const size_t nGroupsBatch = std::min(GroupsPerBatch, nGroups - group);
+        inputIter = decodeGroupsAVX2(inputIter, states.data(), indices.data(), nGroupsBatch);
+        for (size_t i = 0; i < nGroupsBatch * NStreams; i++) {
+          *it++ = toSymbol(indices[i]);
+        }
+      }
+      nDecoded = nGroups * NStreams;
+    }
+  }
+#endif
+
+  // scalar decoding of the remaining symbols: symbol i is decoded by the state i % NStreams
+  for (size_t i = nDecoded, stream = 0; i < messageLength; i++) {
+    coder_T& x = states[stream];
+    const uint32_t index = mSymbolIndexLUT[x & mask];
+    const uint64_t info = mSymbolInfo[index];
+    x = static_cast<uint32_t>(info) * (x >> this->mProbabilityBits) + (x & mask) - static_cast<uint32_t>(info >> 32);
+    while (x < LowerBound) {
+      x = (x << StreamBits) | *inputIter;
+      --inputIter;
+    }
+    *it++ = toSymbol(index);
+    stream = stream == NStreams - 1 ? 0 : stream + 1;
+  }
+
+  t.stop();
+  LOG(debug1) << "InterleavedDecoder::" << __func__ << " { DecodedSymbols: " << messageLength << ","
+              << "processedBytes: " << messageLength * sizeof(source_T) << ","
+              << " inclusiveTimeMS: " << t.getDurationMS() << ","
+              << " BandwidthMiBPS: " << std::fixed << std::setprecision(2) << (messageLength * sizeof(source_T) * 1.0) / (t.getDurationS() * 1.0 * (1 << 20)) << "}";
+
+  LOG(trace) << "done decoding";
+}
+
+#ifdef RANS_INTERLEAVED_AVX2
+namespace internal
+{
+/// shuffle masks to pick for each of 4 lanes with renormalization the next stream word: with 4 words
+/// in[-3..0] loaded to a register, the k-th renormalizing lane (in lane order) gets in[-k]
+struct RenormShuffleLUT {
+  alignas(16) uint8_t masks[16][16];
+  constexpr RenormShuffleLUT() : masks()
+  {
+    for (int renorm = 0; renorm < 16; renorm++) {
+      int rank = 0;
+      for (int lane = 0; lane < 4; lane++) {
+        const int word = (renorm & (1 << lane)) ? 3 - rank++ : 0;
+        for (int b = 0; b < 4; b++) {
+          masks[renorm][lane * 4 + b] = word * 4 + b;
+        }
+      }
+    }
+  }
+};
+inline constexpr RenormShuffleLUT gRenormShuffleLUT{};
+
+__attribute__((target("avx2"))) inline __m256i decodeStep4AVX2(__m256i x, const uint32_t*& in, const uint32_t* symbolIndexLUT,
+                                                                 const uint64_t* symbolInfo, __m256i mask, __m128i shift, __m256i lowerBound,
+                                                                 int32_t* indices)
+{
+  const __m256i cumul = _mm256_and_si256(x, mask);
+  // gather the symbol index for the cumulative frequency of every state, then its frequency and start
+  const __m128i index = _mm256_i64gather_epi32(reinterpret_cast<const int*>(symbolIndexLUT), cumul, 4);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), index);
+  const __m256i info = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(symbolInfo), index, 8);
+  // x = freq * (x >> bits) + cumul - start; x >> bits exceeds 32 bits, multiply both halves by freq
+  const __m256i xs = _mm256_srl_epi64(x, shift);
+  const __m256i lo = _mm256_mul_epu32(xs, info);
+  const __m256i hi = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(xs, 32), info), 32);
+  x = _mm256_sub_epi64(_mm256_add_epi64(_mm256_add_epi64(lo, hi), cumul), _mm256_srli_epi64(info, 32));
+  // renormalize: x < 2^31 for 64 bit states, a single 32 bit word is enough
+  const __m256i needRenorm = _mm256_cmpgt_epi64(lowerBound, x);
+  const int renormMask = _mm256_movemask_pd(_mm256_castsi256_pd(needRenorm));
+  if (renormMask) {
+    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in - 3));
+    const __m128i shuffled = _mm_shuffle_epi8(words, _mm_load_si128(reinterpret_cast<const __m128i*>(gRenormShuffleLUT.masks[renormMask])));
+    const __m256i renormed = _mm256_or_si256(_mm256_slli_epi64(x, 32), _mm256_cvtepu32_epi64(shuffled));
+    x = _mm256_blendv_epi8(x, renormed, needRenorm);
+    in -= __builtin_popcount(renormMask);
+  }
+  return x;
+}
+} // namespace internal
+
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+__attribute__((target("avx2"))) const uint32_t* InterleavedLiteralDecoder<coder_T, stream_T, source_T, NStreams>::decodeGroupsAVX2(const uint32_t* in, uint64_t* states, int32_t* indices, size_t nGroups) const
+{
+  const __m256i mask = _mm256_set1_epi64x((1ull << this->mProbabilityBits) - 1);
+  const __m128i shift = _mm_cvtsi32_si128(this->mProbabilityBits);
+  const __m256i lowerBound = _mm256_set1_epi64x(1ull << 31);
+  __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states));
+  __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + 4));
+  for (size_t group = 0; group < nGroups; group++) {
+    // the stream words are consumed in the order of the states, first half first
+    x0 = internal::decodeStep4AVX2(x0, in, mSymbolIndexLUT.data(), mSymbolInfo.data(), mask, shift, lowerBound, indices);
+    x1 = internal::decodeStep4AVX2(x1, in, mSymbolIndexLUT.data(), mSymbolInfo.data(), mask, shift, lowerBound, indices + 4);
+    indices += NStreams;
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(states), x0);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + 4), x1);
+  return in;
+}
+#else
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+const uint32_t* InterleavedLiteralDecoder<coder_T, stream_T, source_T, NStreams>::decodeGroupsAVX2(const uint32_t* in, uint64_t*, int32_t*, size_t) const
+{
+  return in;
+}
+#endif
+
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERLEAVEDLITERALDECODER_H */
@@ -0,0 +1,134 @@
+// Copyright CERN and copyright holders of ALICE O2. This software is
+// distributed under the terms of the GNU General Public License v3 (GPL
+// Version 3), copied verbatim in the file "COPYING".
+//
+// See http://alice-o2.web.cern.ch/license for full licensing information.
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedLiteralEncoder.h
+/// @since  2021-03-01
+/// @brief  Encoder with N interleaved rANS states and incompressible symbols passed as literals
+
+#ifndef RANS_INTERLEAVEDLITERALENCODER_H
+#define RANS_INTERLEAVEDLITERALENCODER_H
+
+#include "LiteralEncoder.h"
+
+#include <array>
+#include <iomanip>
+#include <stdexcept>
+
+#include <fairlogger/Logger.h>
+
+#include "internal/EncoderSymbol.h"
+#include "internal/helper.h"
+
+namespace o2
+{
+namespace rans
+{
+
+/// Stream format: symbol i of the message is coded by state i % NStreams. The output words up to
+/// outputBegin[NPaddingWords] are left unused, so that the vectorized decoder can load a full register
+/// below the last word it consumes. The legacy 2-state format stays available via LiteralEncoder::process.
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams = 8>
+class InterleavedLiteralEncoder : public LiteralEncoder<coder_T, stream_T, source_T>
+{
+  //inherit constructors;
+  using LiteralEncoder<coder_T, stream_T, source_T>::LiteralEncoder;
+
+ public:
+  static constexpr size_t NPaddingWords = 3;
+
+  template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT> && internal::isCompatibleIter_v<source_T, source_IT>, bool> = true>
+  const stream_IT process(const stream_IT outputBegin, const stream_IT outputEnd,
+                          const source_IT inputBegin, source_IT inputEnd, std::vector<source_T>& literals) const;
+
+  static constexpr size_t getNStreams() { return NStreams; }
+};
+
+template <typename coder_T, typename stream_T, typename source_T, size_t NStreams>
+template <typename stream_IT, typename source_IT, std::enable_if_t<internal::isCompatibleIter_v<stream_T, stream_IT> && internal::isCompatibleIter_v<source_T, source_IT>, bool>>
+const stream_IT InterleavedLiteralEncoder<coder_T, stream_T, source_T, NStreams>::process(const stream_IT outputBegin, const stream_IT outputEnd, const source_IT inputBegin, const source_IT inputEnd, std::vector<source_T>& literals) const
+{
+  using namespace internal;
+  using ransCoder = internal::Encoder<coder_T, stream_T>;
+  LOG(trace) << "start encoding";
+  RANSTimer t;
+  t.start();
+
+  static_assert(std::is_same<typename std::iterator_traits<source_IT>::value_type, source_T>::value);
+  static_assert(std::is_same<typename std::iterator_traits<stream_IT>::value_type, stream_T>::value);
+
+  if (inputBegin == inputEnd) {
+    LOG(warning) << "passed empty message to encoder, skip encoding";
+    return outputEnd;
+  }
+
+  if (std::distance(outputBegin, outputEnd) <= static_cast<std::ptrdiff_t>(NPaddingWords)) {
+    const std::string errorMessage("Unallocated encode buffer passed to encoder. Aborting");
+    LOG(error) << errorMessage;
+    throw std::runtime_error(errorMessage);
+  }
+
+  std::array<ransCoder, NStreams> coders;
+
+  stream_IT outputIter = outputBegin;
+  for (size_t i = 0; i < NPaddingWords; i++) {
+    *outputIter++ = 0;
+  }
+  *outputIter = 0; // the coder increments the iterator before writing, this word stays unused as in LiteralEncoder
+  source_IT inputIT = inputEnd;
+
+  const auto inputBufferSize = std::distance(inputBegin, inputEnd);
+
+  // symbol i is coded by the state i % NStreams, we go in reverse starting from the last symbol
+  size_t stream = (inputBufferSize - 1) % NStreams;
+  while (inputIT != inputBegin) { // NB: working in reverse!
+    const source_T symbol = *(--inputIT);
+    const auto& encoderSymbol = (*this->mSymbolTable)[symbol];
+    if (this->mSymbolTable->isRareSymbol(symbol)) {
+      literals.push_back(symbol);
+    }
+    outputIter = coders[stream].putSymbol(outputIter, encoderSymbol, this->mProbabilityBits);
+    stream = stream ? stream - 1 : NStreams - 1;
+    assert(outputIter < outputEnd);
+  }
+  // flush in reverse order, so that the decoder initializes the states starting from the 1st one
+  for (size_t i = NStreams; i--;) {
+    outputIter = coders[i].flush(outputIter);
+  }
+  // first iterator past the range so that sizes, distances and iterators work correctly.
+  ++outputIter;
+
+  assert(!(outputIter > outputEnd));
+
+  // deal with overflow
+  if (outputIter > outputEnd) {
+    const std::string exceptionText = [&]() {
+      std::stringstream ss;
+      ss << __func__ << " detected overflow in encode buffer: allocated:" << std::distance(outputBegin, outputEnd) << ", used:" << std::distance(outputBegin, outputIter);
+      return ss.str();
+    }();
+
+    LOG(error) << exceptionText;
+    throw std::runtime_error(exceptionText);
+  }
+
+  t.stop();
+  LOG(debug1) << "InterleavedEncoder::" << __func__ << " {ProcessedBytes: " << inputBufferSize * sizeof(source_T) << ","
+              << " inclusiveTimeMS: " << t.getDurationMS() << ","
+              << " BandwidthMiBPS: " << std::fixed << std::setprecision(2) << (inputBufferSize * sizeof(source_T) * 1.0) / (t.getDurationS() * 1.0 * (1 << 20)) << "}";
+
+  LOG(trace) << "done encoding";
+
+  return outputIter;
+};
+
+} // namespace rans
+} // namespace o2
+
+#endif /* RANS_INTERLEAVEDLITERALENCODER_H */
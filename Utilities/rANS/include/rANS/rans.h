@@ -23,6 +23,8 @@
 #include "DedupDecoder.h"
 #include "LiteralEncoder.h"
 #include "LiteralDecoder.h"
+#include "InterleavedLiteralEncoder.h"
+#include "InterleavedLiteralDecoder.h"
 #include "internal/helper.h"
 
 namespace o2
@@ -49,6 +51,11 @@ using LiteralDecoder32 = LiteralDecoder<uint32_t, uint8_t, source_T>;
 template <typename source_T>
 using LiteralDecoder64 = LiteralDecoder<uint64_t, uint32_t, source_T>;
 
+template <typename source_T>
+using InterleavedLiteralEncoder64 = InterleavedLiteralEncoder<uint64_t, uint32_t, source_T>;
+template <typename source_T>
+using InterleavedLiteralDecoder64 = InterleavedLiteralDecoder<uint64_t, uint32_t, source_T>;
+
 template <typename source_T>
 using DedupEncoder32 = DedupEncoder<uint32_t, uint8_t, source_T>;
 template <typename source_T>
@@ -39,6 +39,8 @@ struct Fixture {
   using decoder_t = o2::rans::Decoder<coder_t, stream_t, source_t>;
   using literalEncoder_t = o2::rans::LiteralEncoder<coder_t, stream_t, source_t>;
   using literalDecoder_t = o2::rans::LiteralDecoder<coder_t, stream_t, source_t>;
+  using interleavedLiteralEncoder_t = o2::rans::InterleavedLiteralEncoder<coder_t, stream_t, source_t>;
+  using interleavedLiteralDecoder_t = o2::rans::InterleavedLiteralDecoder<coder_t, stream_t, source_t>;
   using dedupEncoder_t = o2::rans::DedupEncoder<coder_t, stream_t, source_t>;
   using dedupDecoder_t = o2::rans::DedupDecoder<coder_t, stream_t, source_t>;
 
@@ -145,6 +147,37 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_EncodeDecode_literals, T, LiteralFixtures,
                             decoderBuffer.size() * sizeof(typename T::source_t)) == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_EncodeDecode_interleavedLiterals, T, LiteralFixtures, T)
+{
+  fair::Logger::SetConsoleSeverity("trace");
+
+  o2::rans::FrequencyTable frequencies;
+  frequencies.addSamples(std::begin(T::source), std::end(T::source));
+
+  // add incompressible symbols at both ends and make the message length not a multiple of the number of states
+  std::string adaptedSource = "\\";
+  adaptedSource.append(T::source);
+  adaptedSource.append("&%=/*!");
+  const size_t messageLength = adaptedSource.size();
+
+  std::vector<typename T::stream_t> encoderBuffer(1 << 20, 0);
+  const typename T::interleavedLiteralEncoder_t encoder{frequencies, T::probabilityBits};
+  std::vector<typename T::source_t> literals;
+  // use raw pointers for the stream, so that the vectorized decoding kernel can be used
+  const typename T::stream_t* encodedMessageEnd = encoder.process(encoderBuffer.data(), encoderBuffer.data() + encoderBuffer.size(), std::begin(adaptedSource), std::end(adaptedSource), literals);
+
+  typename T::interleavedLiteralDecoder_t decoder{frequencies, T::probabilityBits};
+  // decode with the kernel selected for this CPU and with the scalar one, the results must be identical
+  for (bool forceScalar : {false, true}) {
+    decoder.setForceScalar(forceScalar);
+    auto literalsCopy = literals;
+    std::vector<typename T::source_t> decoderBuffer(messageLength, 0);
+    decoder.process(decoderBuffer.begin(), encodedMessageEnd, messageLength, literalsCopy);
+    BOOST_REQUIRE(literalsCopy.empty());
+    BOOST_REQUIRE(std::memcmp(&(*adaptedSource.begin()), decoderBuffer.data(), decoderBuffer.size() * sizeof(typename T::source_t)) == 0);
+  }
+}
+
 typedef boost::mpl::vector<FixtureFull<uint32_t, uint8_t, 14>, FixtureFull<uint64_t, uint32_t, 14>> DedupFixtures;
 
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(test_EncodeDecode_dedup, T, DedupFixtures, T)